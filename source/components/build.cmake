@@ -24,4 +24,5 @@
 set(SGL_SOURCE
     ${SGL_SOURCE}
     ${CMAKE_CURRENT_LIST_DIR}/timer/sgl_timer.c
+    ${CMAKE_CURRENT_LIST_DIR}/headless/sgl_headless.c
 )
@@ -0,0 +1,305 @@
+/* source/components/headless/sgl_headless.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "sgl_headless.h"
+#include "sgl_math.h"
+#include "sgl_log.h"
+#include <stdio.h>
+#include <string.h>
+
+#if (CONFIG_SGL_HEADLESS)
+
+
+/**
+ * @brief headless device context
+ * @framebuffer: full screen host framebuffer
+ * @width: host framebuffer width, that is the panel width after rotation
+ * @height: host framebuffer height, that is the panel height after rotation
+ * @total: accumulated statistics
+ * @frame: statistics of current frame
+ */
+static struct {
+    sgl_color_t          *framebuffer;
+    int16_t              width;
+    int16_t              height;
+    sgl_headless_stats_t total;
+    sgl_headless_stats_t frame;
+} headless;
+
+
+/**
+ * @brief headless flush area callback, copy the band into the host framebuffer
+ * @param area area of flush
+ * @param src source color
+ * @return none
+ */
+static void sgl_headless_flush_area(sgl_area_t *area, sgl_color_t *src)
+{
+    const int16_t w = area->x2 - area->x1 + 1;
+    const int16_t x1 = sgl_max(area->x1, 0);
+    const int16_t x2 = sgl_min(area->x2, headless.width - 1);
+    const int16_t y1 = sgl_max(area->y1, 0);
+    const int16_t y2 = sgl_min(area->y2, headless.height - 1);
+
+    headless.frame.flush_calls ++;
+
+    if (x1 <= x2 && y1 <= y2) {
+        const size_t len = (size_t)(x2 - x1 + 1);
+        src += (y1 - area->y1) * w + (x1 - area->x1);
+
+        for (int16_t y = y1; y <= y2; y++) {
+            memcpy(&headless.framebuffer[y * headless.width + x1], src, len * sizeof(sgl_color_t));
+            src += w;
+        }
+        headless.frame.flush_pixels += (uint64_t)len * (y2 - y1 + 1);
+    }
+
+    sgl_fbdev_flush_ready();
+}
+
+
+/**
+ * @brief headless copy area callback, copy pixels inside the host framebuffer
+ * @param dst destination area
+ * @param src source area, it has the same size as destination area
+ * @return none
+ * @note the rows are copied from bottom to top if the destination is below the source, so the areas can overlap
+ */
+static void sgl_headless_copy_area(sgl_area_t *dst, sgl_area_t *src)
+{
+    const size_t len = (size_t)(dst->x2 - dst->x1 + 1) * sizeof(sgl_color_t);
+    const int16_t h = dst->y2 - dst->y1 + 1;
+
+    for (int16_t i = 0; i < h; i++) {
+        const int16_t row = dst->y1 > src->y1 ? h - 1 - i : i;
+        memmove(&headless.framebuffer[(dst->y1 + row) * headless.width + dst->x1],
+                &headless.framebuffer[(src->y1 + row) * headless.width + src->x1], len);
+    }
+
+    headless.frame.copy_pixels += (uint64_t)(dst->x2 - dst->x1 + 1) * h;
+}
+
+
+/**
+ * @brief register a headless framebuffer device
+ * @param framebuffer full screen host framebuffer, xres * yres pixels, flush_area copies into it
+ * @param buffer0 draw buffer0
+ * @param buffer1 draw buffer1, can be NULL
+ * @param buffer_size draw buffer size in pixels, for example: 320 * 10 line buffer, you should set it to 320 * 10
+ * @param xres x resolution
+ * @param yres y resolution
+ * @return int, 0 if success, -1 if failed
+ * @note the headless device replaces a real panel, it should be registered before sgl_init()
+ *       just like sgl_fbdev_register(), all of the memory is owned by caller
+ */
+int sgl_headless_register(sgl_color_t *framebuffer, sgl_color_t *buffer0, sgl_color_t *buffer1,
+                          uint32_t buffer_size, int16_t xres, int16_t yres)
+{
+    sgl_check_ptr_return(framebuffer, -1);
+
+    sgl_fbinfo_t fbinfo = {
+        .buffer[0] = buffer0,
+        .buffer[1] = buffer1,
+        .buffer_size = buffer_size,
+        .xres = xres,
+        .yres = yres,
+        .flush_area = sgl_headless_flush_area,
+        .copy_area = sgl_headless_copy_area,
+    };
+
+    if (xres <= 0 || yres <= 0) {
+        SGL_LOG_ERROR("sgl_headless_register: invalid resolution");
+        return -1;
+    }
+
+    if (sgl_fbdev_register(&fbinfo)) {
+        SGL_LOG_ERROR("sgl_headless_register: register fbdev failed");
+        return -1;
+    }
+
+    memset(&headless, 0, sizeof(headless));
+    headless.framebuffer = framebuffer;
+
+#if (CONFIG_SGL_FBDEV_ROTATION == 90 || CONFIG_SGL_FBDEV_ROTATION == 270)
+    headless.width = yres;
+    headless.height = xres;
+#else
+    headless.width = xres;
+    headless.height = yres;
+#endif
+
+    memset(framebuffer, 0, (size_t)xres * yres * sizeof(sgl_color_t));
+    return 0;
+}
+
+
+/**
+ * @brief get the host framebuffer of the headless device
+ * @param none
+ * @return pointer to the host framebuffer, NULL if not registered
+ */
+sgl_color_t* sgl_headless_get_framebuffer(void)
+{
+    return headless.framebuffer;
+}
+
+
+/**
+ * @brief render one frame, that is a sgl_task_handler_sync() call with per-frame counters
+ * @param stats [out] statistics of this frame, can be NULL
+ * @return number of pixels flushed in this frame
+ */
+uint32_t sgl_headless_frame(sgl_headless_stats_t *stats)
+{
+    memset(&headless.frame, 0, sizeof(headless.frame));
+    headless.frame.frames = 1;
+
+    sgl_task_handler_sync();
+
+    headless.total.frames += headless.frame.frames;
+    headless.total.flush_calls += headless.frame.flush_calls;
+    headless.total.flush_pixels += headless.frame.flush_pixels;
+    headless.total.copy_pixels += headless.frame.copy_pixels;
+
+    if (stats) {
+        *stats = headless.frame;
+    }
+
+    return (uint32_t)headless.frame.flush_pixels;
+}
+
+
+/**
+ * @brief get the accumulated statistics since register or last reset
+ * @param stats [out] statistics
+ * @return none
+ */
+void sgl_headless_get_stats(sgl_headless_stats_t *stats)
+{
+    sgl_check_ptr_break(stats);
+    *stats = headless.total;
+}
+
+
+/**
+ * @brief reset the accumulated statistics
+ * @param none
+ * @return none
+ */
+void sgl_headless_reset_stats(void)
+{
+    memset(&headless.total, 0, sizeof(headless.total));
+}
+
+
+/**
+ * @brief convert a native color to 8 bits per channel rgb
+ * @param color native color
+ * @param rgb [out] red, green, blue
+ * @return none
+ */
+static inline void sgl_headless_color_to_rgb(sgl_color_t color, uint8_t *rgb)
+{
+#if (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_RGB332)
+    rgb[0] = (uint8_t)(color.ch.red * 255 / 7);
+    rgb[1] = (uint8_t)(color.ch.green * 255 / 7);
+    rgb[2] = (uint8_t)(color.ch.blue * 255 / 3);
+#elif (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_RGB565)
+    rgb[0] = (uint8_t)((color.ch.red << 3) | (color.ch.red >> 2));
+    rgb[1] = (uint8_t)((color.ch.green << 2) | (color.ch.green >> 4));
+    rgb[2] = (uint8_t)((color.ch.blue << 3) | (color.ch.blue >> 2));
+#else
+    rgb[0] = color.ch.red;
+    rgb[1] = color.ch.green;
+    rgb[2] = color.ch.blue;
+#endif
+}
+
+
+/**
+ * @brief dump the host framebuffer as binary PPM (P6) image
+ * @param path file path
+ * @return int, 0 if success, -1 if failed
+ */
+int sgl_headless_dump_ppm(const char *path)
+{
+    uint8_t rgb[3];
+    FILE *fp = NULL;
+
+    sgl_check_ptr_return(path, -1);
+    sgl_check_ptr_return(headless.framebuffer, -1);
+
+    fp = fopen(path, "wb");
+    if (fp == NULL) {
+        SGL_LOG_ERROR("sgl_headless_dump_ppm: open %s failed", path);
+        return -1;
+    }
+
+    fprintf(fp, "P6\n%d %d\n255\n", headless.width, headless.height);
+
+    for (int32_t i = 0; i < (int32_t)headless.width * headless.height; i++) {
+        sgl_headless_color_to_rgb(headless.framebuffer[i], rgb);
+        if (fwrite(rgb, 1, sizeof(rgb), fp) != sizeof(rgb)) {
+            SGL_LOG_ERROR("sgl_headless_dump_ppm: write %s failed", path);
+            fclose(fp);
+            return -1;
+        }
+    }
+
+    fclose(fp);
+    return 0;
+}
+
+
+/**
+ * @brief dump the host framebuffer as raw native pixels, row by row without padding
+ * @param path file path
+ * @return int, 0 if success, -1 if failed
+ */
+int sgl_headless_dump_raw(const char *path)
+{
+    FILE *fp = NULL;
+    size_t count = 0;
+
+    sgl_check_ptr_return(path, -1);
+    sgl_check_ptr_return(headless.framebuffer, -1);
+
+    fp = fopen(path, "wb");
+    if (fp == NULL) {
+        SGL_LOG_ERROR("sgl_headless_dump_raw: open %s failed", path);
+        return -1;
+    }
+
+    count = (size_t)headless.width * headless.height;
+    if (fwrite(headless.framebuffer, sizeof(sgl_color_t), count, fp) != count) {
+        SGL_LOG_ERROR("sgl_headless_dump_raw: write %s failed", path);
+        fclose(fp);
+        return -1;
+    }
+
+    fclose(fp);
+    return 0;
+}
+
+#endif // !CONFIG_SGL_HEADLESS
@@ -0,0 +1,117 @@
+/* source/components/headless/sgl_headless.h
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __SGL_HEADLESS_H__
+#define __SGL_HEADLESS_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sgl_cfgfix.h>
+#include "sgl_core.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (CONFIG_SGL_HEADLESS)
+
+/**
+ * @brief headless flush statistics
+ * @frames: number of frames rendered by sgl_headless_frame()
+ * @flush_calls: number of flush_area calls
+ * @flush_pixels: number of pixels copied into the host framebuffer
+ * @copy_pixels: number of pixels copied inside the host framebuffer by copy_area
+ */
+typedef struct sgl_headless_stats {
+    uint32_t frames;
+    uint32_t flush_calls;
+    uint64_t flush_pixels;
+    uint64_t copy_pixels;
+} sgl_headless_stats_t;
+
+
+/**
+ * @brief register a headless framebuffer device
+ * @param framebuffer full screen host framebuffer, xres * yres pixels, flush_area copies into it
+ * @param buffer0 draw buffer0
+ * @param buffer1 draw buffer1, can be NULL
+ * @param buffer_size draw buffer size in pixels, for example: 320 * 10 line buffer, you should set it to 320 * 10
+ * @param xres x resolution
+ * @param yres y resolution
+ * @return int, 0 if success, -1 if failed
+ * @note the headless device replaces a real panel, it should be registered before sgl_init()
+ *       just like sgl_fbdev_register(), all of the memory is owned by caller
+ */
+int sgl_headless_register(sgl_color_t *framebuffer, sgl_color_t *buffer0, sgl_color_t *buffer1,
+                          uint32_t buffer_size, int16_t xres, int16_t yres);
+
+/**
+ * @brief get the host framebuffer of the headless device
+ * @param none
+ * @return pointer to the host framebuffer, NULL if not registered
+ */
+sgl_color_t* sgl_headless_get_framebuffer(void);
+
+/**
+ * @brief render one frame, that is a sgl_task_handler_sync() call with per-frame counters
+ * @param stats [out] statistics of this frame, can be NULL
+ * @return number of pixels flushed in this frame
+ */
+uint32_t sgl_headless_frame(sgl_headless_stats_t *stats);
+
+/**
+ * @brief get the accumulated statistics since register or last reset
+ * @param stats [out] statistics
+ * @return none
+ */
+void sgl_headless_get_stats(sgl_headless_stats_t *stats);
+
+/**
+ * @brief reset the accumulated statistics
+ * @param none
+ * @return none
+ */
+void sgl_headless_reset_stats(void);
+
+/**
+ * @brief dump the host framebuffer as binary PPM (P6) image
+ * @param path file path
+ * @return int, 0 if success, -1 if failed
+ */
+int sgl_headless_dump_ppm(const char *path);
+
+/**
+ * @brief dump the host framebuffer as raw native pixels, row by row without padding
+ * @param path file path
+ * @return int, 0 if success, -1 if failed
+ */
+int sgl_headless_dump_raw(const char *path);
+
+#endif // !CONFIG_SGL_HEADLESS
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SGL_HEADLESS_H__
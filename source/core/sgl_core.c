@@ -32,6 +32,9 @@
 #include <sgl_font.h>
 #include <sgl_theme.h>
 #include <sgl_misc.h>
+#if (CONFIG_SGL_DRAW_THREADS)
+#include <pthread.h>
+#endif
 
 
 /* current sgl system variable, do not used it */
@@ -51,6 +54,12 @@ const uint8_t sgl_opa2_table[4]  = {0, 85, 170, 255};
 static uint8_t sgl_mem_pool[CONFIG_SGL_HEAP_MEMORY_SIZE];
 
 
+#if (CONFIG_SGL_DRAW_THREADS)
+static int draw_pool_init(uint32_t buffer_size);
+static void draw_pool_deinit(void);
+#endif
+
+
 /**
  * @brief register the frame buffer device
  * @param fbinfo the frame buffer device information
@@ -90,7 +99,7 @@ int sgl_fbdev_register(sgl_fbinfo_t *fbinfo)
     sgl_system.fbdev.surf.w = fbinfo->xres;
 
     sgl_system.tick_ms = 0;
-    sgl_system.fbdev.fb_status = 3;
+    sgl_system.fbdev.fb_status = 0;
     sgl_system.fbdev.fb_swap = 0;
 
     return 0;
@@ -142,6 +151,9 @@ uint8_t sgl_pixmal_get_pixel_bytes(const sgl_pixmap_t *pixmap)
         [SGL_PIXMAP_FMT_RLE_RGB888]   = 3,
         [SGL_PIXMAP_FMT_ARGB8888]     = 4,
         [SGL_PIXMAP_FMT_RLE_ARGB8888] = 4,
+        [SGL_PIXMAP_FMT_TILE_RGB888]  = 3,
+        [SGL_PIXMAP_FMT_TILE_ARGB8888] = 4,
+        [SGL_PIXMAP_FMT_NATIVE_ALPHA] = sizeof(sgl_color_t) + 1,
     };
 
     SGL_ASSERT(pixmap != NULL);
@@ -244,6 +256,153 @@ void sgl_obj_move_child_pos(sgl_obj_t *obj, int16_t ofs_x, int16_t ofs_y)
     }
 }
 
+#if (CONFIG_SGL_MOVE_AREA_NUM_MAX)
+/**
+ * @brief find the pending move of object
+ * @param obj point to object
+ * @return index of pending move, -1 if the object is not moved
+ */
+static inline int sgl_move_find(sgl_obj_t *obj)
+{
+    for (int i = 0; i < sgl_system.fbdev.move_num; i++) {
+        if (sgl_system.fbdev.move[i].obj == obj) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+
+/**
+ * @brief remove a pending move, the last pending move is moved into its slot
+ * @param index index of pending move
+ * @return none
+ */
+static inline void sgl_move_drop(int index)
+{
+    sgl_fbdev_t *fbdev = &sgl_system.fbdev;
+
+    fbdev->move_num --;
+    fbdev->move[index] = fbdev->move[fbdev->move_num];
+}
+
+
+/**
+ * @brief give up a pending move, the object and all of its descendants are dirty as a usual move
+ * @param index index of pending move
+ * @return none
+ */
+static inline void sgl_move_cancel(int index)
+{
+    sgl_obj_t *obj = sgl_system.fbdev.move[index].obj;
+
+    sgl_move_drop(index);
+    obj->dirty = 1;
+    sgl_obj_move_child_pos(obj, 0, 0);
+}
+
+
+/**
+ * @brief record a move of object, if it is recorded, only the exposed and newly covered regions are
+ *        damaged in next harvest and the descendants are not marked dirty
+ * @param obj point to object
+ * @param dx x offset
+ * @param dy y offset
+ * @return true if the move is recorded, false if the object should be marked dirty as usual
+ */
+static bool sgl_move_record(sgl_obj_t *obj, int16_t dx, int16_t dy)
+{
+    sgl_fbdev_t *fbdev = &sgl_system.fbdev;
+    int index = sgl_move_find(obj);
+
+    if (index < 0) {
+        /* the object is dirty for other reason or it has not been drawn yet */
+        if (obj->dirty || obj->needinit || obj->page || fbdev->move_num == CONFIG_SGL_MOVE_AREA_NUM_MAX) {
+            return false;
+        }
+
+        index = fbdev->move_num ++;
+        fbdev->move[index].obj = obj;
+        fbdev->move[index].dx = 0;
+        fbdev->move[index].dy = 0;
+    }
+
+    fbdev->move[index].dx += dx;
+    fbdev->move[index].dy += dy;
+    obj->dirty = 1;
+    fbdev->update_flag = 1;
+
+    return true;
+}
+
+
+/**
+ * @brief drop the pending moves of an object and its descendants, because it is destroyed
+ * @param obj point to object
+ * @return none
+ */
+static inline void sgl_move_forget(sgl_obj_t *obj)
+{
+    for (int i = sgl_system.fbdev.move_num - 1; i >= 0; i--) {
+        for (sgl_obj_t *p = sgl_system.fbdev.move[i].obj; ; p = p->parent) {
+            if (p == obj) {
+                sgl_move_drop(i);
+                break;
+            }
+
+            /* the parent of page is itself */
+            if (p->page) {
+                break;
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief move the coords of object and all of its descendants without marking them dirty
+ * @param obj point to object
+ * @param dx x offset
+ * @param dy y offset
+ * @return none
+ */
+static void sgl_obj_move_coords(sgl_obj_t *obj, int16_t dx, int16_t dy)
+{
+    sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX];
+    int top = 0;
+
+    obj->coords.x1 += dx;
+    obj->coords.x2 += dx;
+    obj->coords.y1 += dy;
+    obj->coords.y2 += dy;
+
+    if (obj->child == NULL) {
+        return;
+    }
+    stack[top++] = obj->child;
+
+    while (top > 0) {
+        SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
+        obj = stack[--top];
+
+        obj->coords.x1 += dx;
+        obj->coords.x2 += dx;
+        obj->coords.y1 += dy;
+        obj->coords.y2 += dy;
+
+        if (obj->sibling != NULL) {
+            stack[top++] = obj->sibling;
+        }
+
+        if (obj->child != NULL) {
+            stack[top++] = obj->child;
+        }
+    }
+}
+#endif // !CONFIG_SGL_MOVE_AREA_NUM_MAX
+
+
 
 /**
  * @brief Set object absolute position
@@ -258,6 +417,14 @@ void sgl_obj_set_abs_pos(sgl_obj_t *obj, int16_t abs_x, int16_t abs_y)
     int16_t x_diff = abs_x - obj->coords.x1;
     int16_t y_diff = abs_y - obj->coords.y1;
 
+#if (CONFIG_SGL_MOVE_AREA_NUM_MAX)
+    /* the object is only moved, its descendants are not dirty */
+    if (sgl_move_record(obj, x_diff, y_diff)) {
+        sgl_obj_move_coords(obj, x_diff, y_diff);
+        return;
+    }
+#endif
+
     sgl_obj_set_dirty(obj);
     obj->coords.x1 += x_diff;
     obj->coords.x2 += x_diff;
@@ -650,6 +817,7 @@ static sgl_page_t* sgl_page_create(void)
     };
 
     obj->area = obj->coords;
+    obj->bounds = obj->coords;
 
     /* init child list */
     sgl_obj_node_init(&page->obj);
@@ -695,6 +863,15 @@ sgl_obj_t* sgl_obj_create(sgl_obj_t *parent)
         obj->event_data = 0;
         obj->construct_fn = NULL;
         obj->dirty = 1;
+        sgl_area_init(&obj->area);
+        sgl_area_init(&obj->bounds);
+        obj->opaque = 0;
+#if (CONFIG_SGL_DRAW_THREADS)
+        obj->serial = 0;
+#endif
+#if (CONFIG_SGL_DISPLAY_LIST)
+        obj->dlist = 0;
+#endif
 
         /* init node */
         sgl_obj_node_init(obj);
@@ -753,6 +930,12 @@ int sgl_init(void)
 #if (CONFIG_SGL_FBDEV_RUNTIME_ROTATION)
     sgl_system.angle = 0;
 #endif
+#endif
+#if (CONFIG_SGL_DRAW_THREADS)
+    if (draw_pool_init(sgl_system.fbdev.fbinfo.buffer_size)) {
+        SGL_LOG_ERROR("sgl_init: draw worker threads init failed");
+        return -1;
+    }
 #endif
     /* create event queue */
     if (sgl_event_queue_init()) {
@@ -768,6 +951,23 @@ int sgl_init(void)
 }
 
 
+/**
+ * @brief sgl global deinitialization
+ * @param none
+ * @return none
+ * @note it stops the draw worker threads, and frees their draw buffers and the draw caches of every thread,
+ *       the objects are not freed, sgl_init() initializes the memory pool again if sgl is used again
+ */
+void sgl_deinit(void)
+{
+#if (CONFIG_SGL_DRAW_THREADS)
+    draw_pool_deinit();
+#endif
+    sgl_draw_corner_cache_free();
+    sgl_font_glyph_cache_free();
+}
+
+
 /**
  * @brief set current object as screen object
  * @param obj object, that you want to set an object as active page
@@ -866,53 +1066,141 @@ bool sgl_area_selfclip(sgl_area_t *clip, sgl_area_t *area)
 
 
 /**
- * @brief Computes the total boundary expansion (in Manhattan distance) required to merge rectangle b into rectangle a.
- *
- * @param a[in]    Pointer to the b rectangle
- * @param b[in]    Pointer to the a rectangle
- * @return int32_t Total expansion amount (always non-negative)
+ * @brief get the number of pixels of an area
+ * @param a[in] Pointer to the rectangle
+ * @return int32_t number of pixels
  */
-static inline int32_t sgl_area_growth(sgl_area_t *a, sgl_area_t *b)
+static inline int32_t sgl_area_pixels(sgl_area_t *a)
 {
-    return (a->x1 - sgl_min(a->x1, b->x1)) + (sgl_max(a->x2, b->x2) - a->x2)
-           + (a->y1 - sgl_min(a->y1, b->y1)) + (sgl_max(a->y2, b->y2) - a->y2);
+    return (int32_t)(a->x2 - a->x1 + 1) * (a->y2 - a->y1 + 1);
 }
 
 
 /**
- * @brief Quickly determines if two rectangles are close enough to be merged.
+ * @brief Computes the cost change of drawing two rectangles as their bounding box instead of one by one.
  *
- * This fast heuristic is useful in performance-critical contexts (e.g., real-time segmentation or region merging)
- * to avoid excessive fragmentation while preventing merges between distant regions.
+ * The cost of a dirty area is CONFIG_SGL_DIRTY_AREA_FLUSH_COST for the transaction plus
+ * CONFIG_SGL_DIRTY_AREA_PIXEL_COST for every pixel that is drawn and transferred. Merging saves
+ * one transaction and pays for the pixels of the bounding box that are not in a or b.
  *
  * @param a[in] Pointer to the first rectangle
  * @param b[in] Pointer to the second rectangle
- * @return bool true if the rectangles are sufficiently close for merging; false otherwise
+ * @param waste[out] pixels of the bounding box that are covered by neither a nor b
+ * @return int32_t cost change, the merge is worthwhile if it is not greater than 0
  */
-static inline bool sgl_merge_determines(sgl_area_t* a, sgl_area_t* b)
+static inline int32_t sgl_merge_cost(sgl_area_t *a, sgl_area_t *b, int32_t *waste)
 {
-    if ((a->x1 > b->x2 && a->x1 - b->x2 > 32) || (b->x1 > a->x2 && b->x1 - a->x2 > 32)) {
-        return false;
+    sgl_area_t merge = *a, overlap;
+    int32_t pixels = sgl_area_pixels(a) + sgl_area_pixels(b);
+
+    sgl_area_selfmerge(&merge, b);
+
+    /* the overlapped pixels are drawn twice if the rectangles are not merged */
+    if (sgl_area_clip(a, b, &overlap)) {
+        *waste = sgl_area_pixels(&merge) - pixels + sgl_area_pixels(&overlap);
     }
-    if ((a->y1 > b->y2 && a->y1 - b->y2 > 32) || (b->y1 > a->y2 && b->y1 - a->y2 > 32)) {
-        return false;
+    else {
+        *waste = sgl_area_pixels(&merge) - pixels;
+    }
+
+    return (sgl_area_pixels(&merge) - pixels) * CONFIG_SGL_DIRTY_AREA_PIXEL_COST - CONFIG_SGL_DIRTY_AREA_FLUSH_COST;
+}
+
+
+/**
+ * @brief remove a dirty area from pool, the last dirty area is moved into its slot
+ * @param index index of dirty area
+ * @return none
+ */
+static inline void sgl_dirty_area_remove(uint8_t index)
+{
+    sgl_fbdev_t *fbdev = &sgl_system.fbdev;
+
+    fbdev->dirty_num --;
+    fbdev->dirty[index] = fbdev->dirty[fbdev->dirty_num];
+}
+
+
+/**
+ * @brief merge the other dirty areas into a grown dirty area as long as the cost does not increase
+ * @param index index of the dirty area that has grown
+ * @return none
+ * @note a merged area may become worthwhile to merge with a neighbour, so it is repeated until nothing changes
+ */
+static void sgl_dirty_area_remerge(uint8_t index)
+{
+    sgl_fbdev_t *fbdev = &sgl_system.fbdev;
+    int32_t waste = 0;
+    uint8_t i = 0;
+
+    while (i < fbdev->dirty_num) {
+        if (i == index || sgl_merge_cost(&fbdev->dirty[index], &fbdev->dirty[i], &waste) > 0) {
+            i ++;
+            continue;
+        }
+
+        sgl_area_selfmerge(&fbdev->dirty[index], &fbdev->dirty[i]);
+        SGL_PERF_ADD(redundant, waste);
+        sgl_dirty_area_remove(i);
+
+        /* the grown area was the last one, it has been moved into slot i */
+        if (index == fbdev->dirty_num) {
+            index = i;
+        }
+        i = 0;
+    }
+}
+
+
+/**
+ * @brief add an area into dirty area pool, if the pool is full, the pair of areas that costs
+ *        least to merge is merged, the new area is one of the candidates
+ * @param area [in] Pointer to the area
+ * @return none
+ */
+static void sgl_dirty_area_insert(sgl_area_t *area)
+{
+    sgl_fbdev_t *fbdev = &sgl_system.fbdev;
+    int32_t cost = 0, best_cost = INT32_MAX, waste = 0, best_waste = 0;
+    uint8_t best_a = 0, best_b = 0;
+
+    if (fbdev->dirty_num < SGL_DIRTY_AREA_NUM_MAX) {
+        fbdev->dirty[fbdev->dirty_num++] = *area;
+        return;
+    }
+
+    /* the new area is the candidate of index SGL_DIRTY_AREA_NUM_MAX */
+    for (uint8_t a = 0; a < SGL_DIRTY_AREA_NUM_MAX; a++) {
+        for (uint8_t b = a + 1; b <= SGL_DIRTY_AREA_NUM_MAX; b++) {
+            cost = sgl_merge_cost(&fbdev->dirty[a], b < SGL_DIRTY_AREA_NUM_MAX ? &fbdev->dirty[b] : area, &waste);
+            if (cost < best_cost) {
+                best_cost = cost;
+                best_waste = waste;
+                best_a = a;
+                best_b = b;
+            }
+        }
     }
 
-    const int16_t mw = sgl_max(a->x2, b->x2) - sgl_min(a->x1, b->x1) + 1;
-    const int16_t mh = sgl_max(a->y2, b->y2) - sgl_min(a->y1, b->y1) + 1;
-    const int32_t sum = (int32_t)(a->x2-a->x1+1)*(a->y2-a->y1+1) + (int32_t)(b->x2-b->x1+1)*(b->y2-b->y1+1);
+    if (best_b < SGL_DIRTY_AREA_NUM_MAX) {
+        sgl_area_selfmerge(&fbdev->dirty[best_a], &fbdev->dirty[best_b]);
+        fbdev->dirty[best_b] = *area;
+    }
+    else {
+        sgl_area_selfmerge(&fbdev->dirty[best_a], area);
+    }
 
-    return sum > (int32_t)(mw * mh);
+    SGL_PERF_ADD(redundant, best_waste);
+    sgl_dirty_area_remerge(best_a);
 }
 
 
 /**
  * @brief merge an area into global dirty area
- * 
- * This function calculates how much rectangle 'a' would need to grow in each direction (left, right, top, bottom)
- * to fully enclose both 'a' and 'b'. The result is the sum of the expansions along all four sides.
- * Note: This is not the increase in area, th is a lightweight heuristic for merge cost in bounding-box algorithms.
- * 
+ *
+ * The area is merged into the dirty area that costs least to merge with, if the merge does not
+ * increase the total cost, see sgl_merge_cost(). Otherwise it is added as a new dirty area.
+ *
  * @param area [in] Pointer to the area
  * @return none
  * @warning This function is unsafe, you should check the area is not out of screen size by yourself
@@ -920,87 +1208,161 @@ static inline bool sgl_merge_determines(sgl_area_t* a, sgl_area_t* b)
 void sgl_dirty_area_push(sgl_area_t *area)
 {
     SGL_ASSERT(area != NULL);
-    int32_t best_idx = -1, min_growth = INT32_MAX, growth = INT32_MAX;
+    sgl_fbdev_t *fbdev = &sgl_system.fbdev;
+    int32_t best_idx = -1, min_cost = INT32_MAX, cost = 0, waste = 0, best_waste = 0;
+
     /* skip invalid area */
     if (area->x1 > area->x2 || area->y1 > area->y2) {
         return;
     }
 
-    for (uint8_t i = 0; i < sgl_system.fbdev.dirty_num; i++) {
-        if (sgl_merge_determines(&sgl_system.fbdev.dirty[i], area)) {
-            growth = sgl_area_growth(&sgl_system.fbdev.dirty[i], area);
-            if (growth == 0) {
-                /* already contains the area */
-                return;
-            }
-            else if (growth < min_growth) {
-                min_growth = growth;
-                best_idx = i;
-            }
+    for (uint8_t i = 0; i < fbdev->dirty_num; i++) {
+        if (fbdev->dirty[i].x1 <= area->x1 && fbdev->dirty[i].y1 <= area->y1
+            && fbdev->dirty[i].x2 >= area->x2 && fbdev->dirty[i].y2 >= area->y2) {
+            /* already contains the area */
+            return;
+        }
+
+        cost = sgl_merge_cost(&fbdev->dirty[i], area, &waste);
+        if (cost <= 0 && cost < min_cost) {
+            min_cost = cost;
+            best_waste = waste;
+            best_idx = i;
         }
     }
 
     if (best_idx >= 0) {
         /* merge object area into best_idx dirty area */
-        sgl_area_selfmerge(&sgl_system.fbdev.dirty[best_idx], area);
+        sgl_area_selfmerge(&fbdev->dirty[best_idx], area);
+        SGL_PERF_ADD(redundant, best_waste);
+        sgl_dirty_area_remerge(best_idx);
         return;
     }
 
-    if (sgl_system.fbdev.dirty_num < SGL_DIRTY_AREA_NUM_MAX) {
-        /* add new dirty area */
-        sgl_system.fbdev.dirty[sgl_system.fbdev.dirty_num++] = *area;
-    } else {
-        /* merge object area into last dirty area */
-        sgl_area_selfmerge(&sgl_system.fbdev.dirty[SGL_DIRTY_AREA_NUM_MAX - 1], area);
+    sgl_dirty_area_insert(area);
+}
+
+
+#if (CONFIG_SGL_MOVE_AREA_NUM_MAX)
+/**
+ * @brief push the part of area a that is out of area b into global dirty area
+ * @param a [in] Pointer to the area a
+ * @param b [in] Pointer to the area b
+ * @return none
+ * @note the part is split into top, bottom, left and right strips, every one can be empty
+ */
+static void sgl_dirty_area_push_diff(sgl_area_t *a, sgl_area_t *b)
+{
+    sgl_area_t strip;
+
+    if (!sgl_area_is_overlap(a, b)) {
+        sgl_dirty_area_push(a);
+        return;
     }
+
+    /* top and bottom strips in full width of a */
+    strip = (sgl_area_t){ .x1 = a->x1, .y1 = a->y1, .x2 = a->x2, .y2 = b->y1 - 1 };
+    sgl_dirty_area_push(&strip);
+    strip = (sgl_area_t){ .x1 = a->x1, .y1 = b->y2 + 1, .x2 = a->x2, .y2 = a->y2 };
+    sgl_dirty_area_push(&strip);
+
+    /* left and right strips between them */
+    strip = (sgl_area_t){ .x1 = a->x1, .y1 = sgl_max(a->y1, b->y1), .x2 = b->x1 - 1, .y2 = sgl_min(a->y2, b->y2) };
+    sgl_dirty_area_push(&strip);
+    strip = (sgl_area_t){ .x1 = b->x2 + 1, .y1 = sgl_max(a->y1, b->y1), .x2 = a->x2, .y2 = sgl_min(a->y2, b->y2) };
+    sgl_dirty_area_push(&strip);
 }
 
 
 /**
- * @brief initialize object
- * @param obj object
- * @param parent parent object
- * @return int, 0 means successful, -1 means failed
+ * @brief check if the pixels of a moved object can be copied on screen, and record the copy
+ * @param obj point to object, its area has been updated
+ * @param old [in] area of object in last frame
+ * @param dx x offset of the move
+ * @param dy y offset of the move
+ * @param copy [out] destination area of the copy
+ * @return true if the copy is recorded, false if the whole area of object should be drawn
+ * @note the pixels can be copied if the object is opaque, nothing is drawn above it at both positions
+ *       and no other copy of this frame changes them
  */
-int sgl_obj_init(sgl_obj_t *obj, sgl_obj_t *parent)
+static bool sgl_move_copy(sgl_obj_t *obj, sgl_area_t *old, int16_t dx, int16_t dy, sgl_area_t *copy)
 {
-    SGL_ASSERT(obj != NULL);
+#if (CONFIG_SGL_FBDEV_ROTATION == 0 && !CONFIG_SGL_FBDEV_RUNTIME_ROTATION && !CONFIG_SGL_DIRTY_AREA_TRACE)
+    sgl_fbdev_t *fbdev = &sgl_system.fbdev;
+    const int16_t inset = obj->radius + obj->border;
+    sgl_area_t src, prev, both;
 
-    if (parent == NULL) {
-        parent = sgl_screen_act();
-        if (parent == NULL) {
-            SGL_LOG_ERROR("sgl_obj_init: have no active page");
-            return -1;
-        }
+    if (fbdev->fbinfo.copy_area == NULL || !sgl_obj_is_opaque(obj) || fbdev->copy_num == CONFIG_SGL_MOVE_AREA_NUM_MAX) {
+        return false;
     }
 
-    /* set essential member */
-    obj->coords = parent->coords;
-    obj->parent = parent;
-    sgl_obj_set_dirty(obj);
+    /* the opaque part of object that is visible at both positions */
+    copy->x1 = obj->coords.x1 + inset;
+    copy->y1 = obj->coords.y1 + inset;
+    copy->x2 = obj->coords.x2 - inset;
+    copy->y2 = obj->coords.y2 - inset;
+    if (!sgl_area_selfclip(copy, &obj->area)) {
+        return false;
+    }
 
-    /* init object area to invalid */
-    sgl_area_init(&obj->area);
+    src = (sgl_area_t){ .x1 = copy->x1 - dx, .y1 = copy->y1 - dy, .x2 = copy->x2 - dx, .y2 = copy->y2 - dy };
+    if (!sgl_area_selfclip(&src, old)) {
+        return false;
+    }
+    *copy = (sgl_area_t){ .x1 = src.x1 + dx, .y1 = src.y1 + dy, .x2 = src.x2 + dx, .y2 = src.y2 + dy };
 
-    /* add the child into parent's child list */
-    sgl_obj_add_child(parent, obj);
+    /* the objects that are drawn after this one must not overlap both positions */
+    both = src;
+    sgl_area_selfmerge(&both, copy);
+    for (sgl_obj_t *p = obj; !p->page; p = p->parent) {
+        for (sgl_obj_t *s = p->sibling; s != NULL; s = s->sibling) {
+            if (sgl_area_is_overlap(&s->bounds, &both)) {
+                return false;
+            }
+        }
+    }
 
-    return 0;
+    /* the copies are done in order, an earlier copy must not change the pixels of this one */
+    for (int i = 0; i < fbdev->copy_num; i++) {
+        prev = fbdev->copy[i].dst;
+        if (sgl_area_is_overlap(&prev, &src) || sgl_area_is_overlap(&prev, copy)) {
+            return false;
+        }
+    }
+
+    fbdev->copy[fbdev->copy_num].dst = *copy;
+    fbdev->copy[fbdev->copy_num].dx = dx;
+    fbdev->copy[fbdev->copy_num].dy = dy;
+    fbdev->copy_num ++;
+
+    return true;
+#else
+    SGL_UNUSED(obj);
+    SGL_UNUSED(old);
+    SGL_UNUSED(dx);
+    SGL_UNUSED(dy);
+    SGL_UNUSED(copy);
+    return false;
+#endif
 }
 
 
 /**
- * @brief  free an object
- * @param  obj: object to free
- * @retval none
- * @note this function will free all the itself and children of the object
+ * @brief update the area of descendants of a moved object, a descendant that is dirty by itself
+ *        is left to harvest with all of its subtree
+ * @param obj point to moved object
+ * @return none
  */
-void sgl_obj_free(sgl_obj_t *obj)
+static void sgl_obj_area_move(sgl_obj_t *obj)
 {
-    SGL_ASSERT(obj != NULL);
+    int top = 0, index = 0;
+    sgl_area_t fill;
     sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX];
-    int top = 0;
-    stack[top++] = obj;
+
+    if (obj->child == NULL) {
+        return;
+    }
+    stack[top++] = obj->child;
 
     while (top > 0) {
         SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
@@ -1010,36 +1372,169 @@ void sgl_obj_free(sgl_obj_t *obj)
             stack[top++] = obj->sibling;
         }
 
+        /* the descendant is moved by itself too */
+        if (sgl_system.fbdev.move_num > 0 && (index = sgl_move_find(obj)) >= 0) {
+            sgl_move_cancel(index);
+            continue;
+        }
+
+        if (obj->dirty || sgl_obj_is_hidden(obj)) {
+            obj->dirty = 1;
+            sgl_obj_move_child_pos(obj, 0, 0);
+            continue;
+        }
+
+        fill = sgl_obj_get_fill_rect(obj->parent);
+        if (!sgl_area_clip(&fill, &obj->coords, &obj->area)) {
+            sgl_area_init(&obj->area);
+            sgl_obj_move_child_pos(obj, 0, 0);
+            continue;
+        }
+
         if (obj->child != NULL) {
             stack[top++] = obj->child;
         }
-
-        sgl_free(obj);
     }
 }
 
 
 /**
- * @brief Set object to dirty
- * @param obj point to object
- * @return none
- * @note this function will set object to dirty, include its children
+ * @brief damage a moved object by the regions that it exposes and newly covers
+ * @param obj point to object that is dirty
+ * @return true if the move is resolved, false if the object should be harvested as usual
+ * @note the part of the object that can be copied on screen is not drawn, see sgl_move_copy()
  */
-void sgl_obj_set_dirty(sgl_obj_t *obj)
+static bool sgl_dirty_area_move(sgl_obj_t *obj)
 {
-    SGL_ASSERT(obj != NULL);
-    obj->dirty = 1;
-    sgl_system.fbdev.update_flag = 1;
-}
+    int index = sgl_move_find(obj);
+    sgl_area_t old = obj->area, fill, copy;
+    int16_t dx = 0, dy = 0;
 
+    if (index < 0) {
+        return false;
+    }
 
-/**
- * @brief  Set the object to be destroyed
- * @param  obj: the object to set
- * @retval None
- * @note this function is used to set the destroyed flag of the object, then next draw cycle, the object will be removed
- *       the object should be not NULL.
- */
+    /* the object has not been drawn or it is moved out of parent */
+    fill = sgl_obj_get_fill_rect(obj->parent);
+    if (old.x1 > old.x2 || old.y1 > old.y2 || !sgl_area_clip(&fill, &obj->coords, &obj->area)) {
+        sgl_move_cancel(index);
+        return false;
+    }
+
+    dx = sgl_system.fbdev.move[index].dx;
+    dy = sgl_system.fbdev.move[index].dy;
+    sgl_move_drop(index);
+
+    /* the region that is exposed */
+    sgl_dirty_area_push_diff(&old, &obj->area);
+
+    /* the region that is newly covered, or the whole area if the object can not be copied */
+    if (sgl_move_copy(obj, &old, dx, dy, &copy)) {
+        sgl_dirty_area_push_diff(&obj->area, &copy);
+    }
+    else {
+        sgl_dirty_area_push(&obj->area);
+    }
+
+    sgl_obj_area_move(obj);
+    return true;
+}
+#endif // !CONFIG_SGL_MOVE_AREA_NUM_MAX
+
+
+/**
+ * @brief initialize object
+ * @param obj object
+ * @param parent parent object
+ * @return int, 0 means successful, -1 means failed
+ */
+int sgl_obj_init(sgl_obj_t *obj, sgl_obj_t *parent)
+{
+    SGL_ASSERT(obj != NULL);
+
+    if (parent == NULL) {
+        parent = sgl_screen_act();
+        if (parent == NULL) {
+            SGL_LOG_ERROR("sgl_obj_init: have no active page");
+            return -1;
+        }
+    }
+
+    /* set essential member */
+    obj->coords = parent->coords;
+    obj->parent = parent;
+    sgl_obj_set_dirty(obj);
+
+    /* init object area to invalid */
+    sgl_area_init(&obj->area);
+    sgl_area_init(&obj->bounds);
+
+    /* add the child into parent's child list */
+    sgl_obj_add_child(parent, obj);
+
+    return 0;
+}
+
+
+/**
+ * @brief  free an object
+ * @param  obj: object to free
+ * @retval none
+ * @note this function will free all the itself and children of the object
+ */
+void sgl_obj_free(sgl_obj_t *obj)
+{
+    SGL_ASSERT(obj != NULL);
+    sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX];
+    int top = 0;
+    stack[top++] = obj;
+
+    while (top > 0) {
+        SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
+        obj = stack[--top];
+
+        if (obj->sibling != NULL) {
+            stack[top++] = obj->sibling;
+        }
+
+        if (obj->child != NULL) {
+            stack[top++] = obj->child;
+        }
+
+        sgl_free(obj);
+    }
+}
+
+
+/**
+ * @brief Set object to dirty
+ * @param obj point to object
+ * @return none
+ * @note this function will set object to dirty, include its children
+ */
+void sgl_obj_set_dirty(sgl_obj_t *obj)
+{
+    SGL_ASSERT(obj != NULL);
+#if (CONFIG_SGL_MOVE_AREA_NUM_MAX)
+    int index = 0;
+
+    /* the moved object is changed, so it is drawn as usual */
+    if (unlikely(sgl_system.fbdev.move_num > 0) && (index = sgl_move_find(obj)) >= 0) {
+        sgl_move_cancel(index);
+    }
+#endif
+    obj->dirty = 1;
+    sgl_system.fbdev.update_flag = 1;
+}
+
+
+/**
+ * @brief  Set the object to be destroyed
+ * @param  obj: the object to set
+ * @retval None
+ * @note this function is used to set the destroyed flag of the object, then next draw cycle, the object will be removed
+ *       the object should be not NULL.
+ */
 void sgl_obj_set_destroyed(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
@@ -1115,13 +1610,8 @@ void sgl_obj_update_area(sgl_area_t *area)
         return;
     }
 
-    if (sgl_system.fbdev.dirty_num < SGL_DIRTY_AREA_NUM_MAX) {
-        /* add new dirty area */
-        sgl_system.fbdev.dirty[sgl_system.fbdev.dirty_num++] = clip;
-    } else {
-        /* merge object area into last dirty area */
-        sgl_area_selfmerge(&sgl_system.fbdev.dirty[SGL_DIRTY_AREA_NUM_MAX - 1], &clip);
-    }
+    /* add new dirty area, the pool is re-merged if it is full */
+    sgl_dirty_area_insert(&clip);
 }
 
 
@@ -1254,12 +1744,13 @@ uint32_t sgl_utf8_to_unicode(const char *utf8_str, uint32_t *p_unicode_buffer)
 
 
 /**
- * @brief Search for the index of a Unicode character in the font table
+ * @brief Search for the index of a Unicode character in the unicode parts of font
  * @param font Pointer to the font structure containing character data
  * @param unicode Unicode of the character to be searched
- * @return Index of the character in the font table
+ * @param ch_index Pointer to the index of the character in the font table
+ * @return true if the character is found, otherwise false
  */
-uint32_t sgl_search_unicode_ch_index(const sgl_font_t *font, uint32_t unicode)
+static bool font_search_ch_index(const sgl_font_t *font, uint32_t unicode, uint32_t *ch_index)
 {
     uint32_t i, left = 0, right = 0, mid = 0;
     uint32_t target = unicode;
@@ -1276,29 +1767,184 @@ uint32_t sgl_search_unicode_ch_index(const sgl_font_t *font, uint32_t unicode)
 
     if (code->list == NULL) {
         if (target >= code->len) {
-            SGL_LOG_WARN("sgl_search_unicode_ch_index: [0x%x]unicode not found in font table", unicode);
-            return 0;
+            return false;
         }
-        return target + code->tab_offset;
+        *ch_index = target + code->tab_offset;
+        return true;
     }
 
-    right = code->len - 1;
-    while (left <= right) {
+    /* the right is exclusive, so that it never wraps around when the target is less than the first one */
+    right = code->len;
+    while (left < right) {
         mid = left + (right - left) / 2;
 
         if (code->list[mid] == target) {
-            return mid + code->tab_offset;
+            *ch_index = mid + code->tab_offset;
+            return true;
         }
         else if (code->list[mid] < target) {
             left = mid + 1;
         }
         else {
-            right = mid - 1;
+            right = mid;
         }
     }
 
-    SGL_LOG_WARN("sgl_search_unicode_ch_index: [0x%x]unicode not found in font table", unicode);
-    return 0;
+    return false;
+}
+
+
+#if (CONFIG_SGL_FONT_LOOKUP_TABLE)
+#define FONT_LOOKUP_PAGE_SHIFT      (8)
+#define FONT_LOOKUP_PAGE_SIZE       (1 << FONT_LOOKUP_PAGE_SHIFT)
+#define FONT_LOOKUP_PAGE_NUM        (0x10000 >> FONT_LOOKUP_PAGE_SHIFT)
+
+/**
+ * @brief lookup table of a font, it is a two level page table of the basic multilingual plane,
+ *        the page 0 is the direct table of ASCII and Latin-1
+ * @font: font of the table
+ * @next: next table in the list
+ * @page: pages of 256 code points, every entry is the index of character plus 1, 0 is not found,
+ *        NULL is not built yet, a page that is failed to alloc points to font_lookup_none
+ */
+typedef struct font_lookup_table {
+    const sgl_font_t          *font;
+    struct font_lookup_table  *next;
+    uint16_t                  *page[FONT_LOOKUP_PAGE_NUM];
+} font_lookup_table_t;
+
+
+/* tables of fonts, they are never freed because the fonts are constant */
+static font_lookup_table_t *font_lookup_list = NULL;
+/* the table or page is failed to alloc, the character is searched in the font */
+static uint16_t font_lookup_none[1];
+
+/* the tables are built in the draw threads too, so they are published with compare and swap */
+#if (CONFIG_SGL_DRAW_THREADS)
+#define font_lookup_load(ptr)                 __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define font_lookup_publish(ptr, old, val)    __atomic_compare_exchange_n(ptr, &(old), val, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#else
+#define font_lookup_load(ptr)                 (*(ptr))
+#define font_lookup_publish(ptr, old, val)    ((*(ptr) = (val)), true)
+#endif
+
+
+/**
+ * @brief get the lookup table of font, it is created at first use
+ * @param font Pointer to the font structure containing character data
+ * @return lookup table of font, NULL if it is failed to alloc
+ */
+static font_lookup_table_t* font_lookup_get_table(const sgl_font_t *font)
+{
+    font_lookup_table_t *head = font_lookup_load(&font_lookup_list);
+    font_lookup_table_t *table = NULL;
+
+    while (1) {
+        for (font_lookup_table_t *t = head; t != NULL; t = t->next) {
+            if (t->font == font) {
+                if (table != NULL) {
+                    sgl_free(table);
+                }
+                return t;
+            }
+        }
+
+        if (table == NULL) {
+            table = sgl_malloc(sizeof(font_lookup_table_t));
+            if (table == NULL) {
+                return NULL;
+            }
+            memset(table, 0, sizeof(font_lookup_table_t));
+            table->font = font;
+        }
+
+        /* another thread may add a table at the same time, so the list is searched again if it fails */
+        table->next = head;
+        if (font_lookup_publish(&font_lookup_list, head, table)) {
+            return table;
+        }
+    }
+}
+
+
+/**
+ * @brief get a page of the lookup table, it is built at first use
+ * @param table lookup table of font
+ * @param index index of page
+ * @return page of lookup table, font_lookup_none if it is failed to alloc
+ */
+static uint16_t* font_lookup_get_page(font_lookup_table_t *table, uint32_t index)
+{
+    uint16_t *page = font_lookup_load(&table->page[index]);
+    uint16_t *expect = NULL;
+    uint32_t ch_index = 0;
+
+    if (page != NULL) {
+        return page;
+    }
+
+    page = sgl_malloc(FONT_LOOKUP_PAGE_SIZE * sizeof(uint16_t));
+    if (page == NULL) {
+        SGL_LOG_WARN("font_lookup_get_page: page %d of font lookup table is failed to alloc", (int)index);
+        page = font_lookup_none;
+    }
+    else {
+        for (uint32_t i = 0; i < FONT_LOOKUP_PAGE_SIZE; i++) {
+            bool found = font_search_ch_index(table->font, (index << FONT_LOOKUP_PAGE_SHIFT) + i, &ch_index);
+            page[i] = found ? (uint16_t)(ch_index + 1) : 0;
+        }
+    }
+
+    if (!font_lookup_publish(&table->page[index], expect, page)) {
+        if (page != font_lookup_none) {
+            sgl_free(page);
+        }
+        page = expect;
+    }
+
+    return page;
+}
+#endif
+
+
+/**
+ * @brief Search for the index of a Unicode character in the font table
+ * @param font Pointer to the font structure containing character data
+ * @param unicode Unicode of the character to be searched
+ * @return Index of the character in the font table
+ * @note a font that has more than one unicode part or has a unicode list is looked up in its page table,
+ *       the page of 256 code points is built at first use, so it is constant time for every band and frame,
+ *       a font of one direct part is already constant time, it has no table
+ */
+uint32_t sgl_search_unicode_ch_index(const sgl_font_t *font, uint32_t unicode)
+{
+    uint32_t ch_index = 0;
+
+#if (CONFIG_SGL_FONT_LOOKUP_TABLE)
+    if (unicode < 0x10000 && (font->unicode_num > 1 || font->unicode->list != NULL)) {
+        font_lookup_table_t *table = font_lookup_get_table(font);
+
+        if (table != NULL) {
+            uint16_t *page = font_lookup_get_page(table, unicode >> FONT_LOOKUP_PAGE_SHIFT);
+
+            if (page != font_lookup_none) {
+                ch_index = page[unicode & (FONT_LOOKUP_PAGE_SIZE - 1)];
+                if (ch_index == 0) {
+                    SGL_LOG_WARN("sgl_search_unicode_ch_index: [0x%x]unicode not found in font table", unicode);
+                    return 0;
+                }
+                return ch_index - 1;
+            }
+        }
+    }
+#endif
+
+    if (!font_search_ch_index(font, unicode, &ch_index)) {
+        SGL_LOG_WARN("sgl_search_unicode_ch_index: [0x%x]unicode not found in font table", unicode);
+        return 0;
+    }
+
+    return ch_index;
 }
 
 
@@ -1707,20 +2353,144 @@ void sgl_obj_set_layout(sgl_obj_t *obj, sgl_layout_desc_t *desc)
 }
 
 
+#if (CONFIG_SGL_OPAQUE_COVER_MAX)
 /**
- * @brief draw object slice completely
+ * @brief opaque cover in a band
+ * @num: number of covers
+ * @floor: draw order of the front-most object that covers the whole band, objects before it are not drawn
+ * @index: draw order of the object that makes the cover
+ * @area: the area that is covered
+ */
+typedef struct draw_cover {
+    int         num;
+    uint32_t    floor;
+    uint32_t    index[CONFIG_SGL_OPAQUE_COVER_MAX];
+    sgl_area_t  area[CONFIG_SGL_OPAQUE_COVER_MAX];
+} draw_cover_t;
+
+
+/**
+ * @brief collect the front-most opaque covers of a band, the objects are visited in draw order
  * @param obj it should point to active root object
  * @param surf surface that draw to
- * @param dirty_h dirty height
+ * @param cover [out] opaque covers
  * @return none
  */
-static inline void draw_obj_slice(sgl_obj_t *obj, sgl_surf_t *surf)
+static inline void draw_cover_collect(sgl_obj_t *obj, sgl_surf_t *surf, draw_cover_t *cover)
+{
+    int top = 0;
+    uint32_t index = 0;
+    sgl_area_t rect;
+    sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX];
+
+    cover->num = 0;
+    cover->floor = 0;
+    stack[top++] = obj;
+
+    while (top > 0) {
+        SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
+        obj = stack[--top];
+
+        if (obj->sibling != NULL) {
+            stack[top++] = obj->sibling;
+        }
+
+        if (sgl_obj_is_hidden(obj) || !sgl_surf_area_is_overlap(surf, &obj->bounds)) {
+            continue;
+        }
+        index ++;
+
+        if (sgl_obj_is_opaque(obj)) {
+            const int16_t inset = obj->radius + obj->border;
+
+            rect.x1 = obj->coords.x1 + inset;
+            rect.y1 = obj->coords.y1 + inset;
+            rect.x2 = obj->coords.x2 - inset;
+            rect.y2 = obj->coords.y2 - inset;
+
+            if (sgl_area_selfclip(&rect, &obj->area) && sgl_area_selfclip(&rect, (sgl_area_t*)surf)) {
+                if (rect.x1 == surf->x1 && rect.y1 == surf->y1 && rect.x2 == surf->x2 && rect.y2 == surf->y2) {
+                    /* the whole band is covered, the covers before it are useless */
+                    cover->floor = index;
+                    cover->num = 0;
+                }
+                else {
+                    /* keep the front-most covers */
+                    if (cover->num == CONFIG_SGL_OPAQUE_COVER_MAX) {
+                        cover->num --;
+                        memmove(&cover->index[0], &cover->index[1], cover->num * sizeof(cover->index[0]));
+                        memmove(&cover->area[0], &cover->area[1], cover->num * sizeof(cover->area[0]));
+                    }
+                    cover->index[cover->num] = index;
+                    cover->area[cover->num] = rect;
+                    cover->num ++;
+                }
+            }
+        }
+
+        if (obj->child != NULL) {
+            stack[top++] = obj->child;
+        }
+    }
+}
+
+
+/**
+ * @brief check if the visible part of object is covered by an opaque object that is drawn after it
+ * @param cover opaque covers of band
+ * @param index draw order of object
+ * @param obj point to object
+ * @param surf surface that draw to
+ * @return true if the object is covered, otherwise false
+ */
+static inline bool draw_cover_is_hidden(draw_cover_t *cover, uint32_t index, sgl_obj_t *obj, sgl_surf_t *surf)
+{
+    sgl_area_t visible;
+
+    if (index < cover->floor) {
+        return true;
+    }
+
+    if (!sgl_area_clip(&obj->area, (sgl_area_t*)surf, &visible)) {
+        return true;
+    }
+
+    for (int i = 0; i < cover->num; i++) {
+        if (cover->index[i] > index
+            && cover->area[i].x1 <= visible.x1 && cover->area[i].y1 <= visible.y1
+            && cover->area[i].x2 >= visible.x2 && cover->area[i].y2 >= visible.y2) {
+            return true;
+        }
+    }
+
+    return false;
+}
+#endif // !CONFIG_SGL_OPAQUE_COVER_MAX
+
+
+/**
+ * @brief render object tree into surface, the surface is not flushed
+ * @param obj it should point to active root object
+ * @param surf surface that draw to
+ * @return none
+ */
+static inline void draw_obj_render(sgl_obj_t *obj, sgl_surf_t *surf)
 {
     int top = 0;
     sgl_event_t evt;
     sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX];
+#if (CONFIG_SGL_OPAQUE_COVER_MAX)
+    uint32_t index = 0;
+    draw_cover_t cover;
+#endif
+#if (CONFIG_SGL_DISPLAY_LIST)
+    uint32_t cursor = 0;
+#endif
 
     SGL_ASSERT(obj != NULL);
+#if (CONFIG_SGL_OPAQUE_COVER_MAX)
+    draw_cover_collect(obj, surf, &cover);
+#endif
     stack[top++] = obj;
 
     while (top > 0) {
@@ -1731,21 +2501,113 @@ static inline void draw_obj_slice(sgl_obj_t *obj, sgl_surf_t *surf)
             stack[top++] = obj->sibling;
         }
 
-        if (sgl_obj_is_hidden(obj)) {
+        /* skip hidden object and the subtree that is out of band */
+        if (sgl_obj_is_hidden(obj) || !sgl_surf_area_is_overlap(surf, &obj->bounds)) {
+            continue;
+        }
+
+#if (CONFIG_SGL_OPAQUE_COVER_MAX)
+        /* skip object that is completely covered by opaque object above it, its children may be still visible */
+        if (draw_cover_is_hidden(&cover, ++index, obj, surf)) {
+            if (obj->child != NULL) {
+                stack[top++] = obj->child;
+            }
             continue;
         }
+#endif
 
-        if (sgl_surf_area_is_overlap(surf, &obj->area)) {
+        if (sgl_surf_area_is_overlap(surf, &obj->area)
+#if (CONFIG_SGL_DISPLAY_LIST)
+            /* the object that is recorded at the beginning of frame is replayed instead */
+            && !(obj->dlist && sgl_dlist_replay(obj, surf, &cursor))
+#endif
+        ) {
             evt.type = SGL_EVENT_DRAW_MAIN;
             SGL_ASSERT(obj->construct_fn != NULL);
             obj->construct_fn(surf, obj, &evt);
+            SGL_PERF_ADD(construct, 1);
         }
 
         if (obj->child != NULL) {
             stack[top++] = obj->child;
         }
     }
+}
 
+
+#if (CONFIG_SGL_DISPLAY_LIST)
+/**
+ * @brief record the draw commands of display list objects that are in dirty areas, the construct
+ *        function of these objects runs once here instead of once per band
+ * @param obj it should point to active root object
+ * @param dirty_area point to dirty area
+ * @param dirty_num dirty area number
+ * @return none
+ * @note the objects are visited in draw order, so that the bands can find them by a forward cursor
+ */
+static inline void draw_dlist_record(sgl_obj_t *obj, sgl_area_t *dirty_area, uint8_t dirty_num)
+{
+    int top = 0;
+    uint8_t i = 0;
+    sgl_surf_t *surf = NULL;
+    sgl_event_t evt = { .type = SGL_EVENT_DRAW_MAIN };
+    sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX];
+
+    sgl_dlist_reset();
+    stack[top++] = obj;
+
+    while (top > 0) {
+        SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
+        obj = stack[--top];
+
+        if (obj->sibling != NULL) {
+            stack[top++] = obj->sibling;
+        }
+
+        if (sgl_obj_is_hidden(obj)) {
+            continue;
+        }
+
+        for (i = 0; i < dirty_num; i++) {
+            if (sgl_area_is_overlap(&dirty_area[i], &obj->bounds)) {
+                break;
+            }
+        }
+
+        /* the whole subtree is out of dirty areas */
+        if (i == dirty_num) {
+            continue;
+        }
+
+        if (obj->dlist) {
+            for (i = 0; i < dirty_num; i++) {
+                if (sgl_area_is_overlap(&dirty_area[i], &obj->area)) {
+                    break;
+                }
+            }
+
+            if (i < dirty_num && (surf = sgl_dlist_record(obj)) != NULL) {
+                SGL_ASSERT(obj->construct_fn != NULL);
+                obj->construct_fn(surf, obj, &evt);
+                SGL_PERF_ADD(construct, 1);
+            }
+        }
+
+        if (obj->child != NULL) {
+            stack[top++] = obj->child;
+        }
+    }
+}
+#endif // !CONFIG_SGL_DISPLAY_LIST
+
+
+/**
+ * @brief flush a rendered surface into screen
+ * @param surf surface that has been rendered
+ * @return none
+ */
+static inline void draw_slice_flush(sgl_surf_t *surf)
+{
 #if (CONFIG_SGL_DIRTY_AREA_TRACE)
     if (sgl_system.fbdev.trace_flag) {
         sgl_draw_wireframe(surf, (sgl_area_t*)surf, surf->dirty, 1, SGL_DIRTY_AREA_TRACE_COLOR, SGL_ALPHA_MAX);
@@ -1759,6 +2621,378 @@ static inline void draw_obj_slice(sgl_obj_t *obj, sgl_surf_t *surf)
 }
 
 
+/**
+ * @brief draw object slice completely
+ * @param obj it should point to active root object
+ * @param surf surface that draw to
+ * @return none
+ */
+static inline void draw_obj_slice(sgl_obj_t *obj, sgl_surf_t *surf)
+{
+    draw_obj_render(obj, surf);
+    draw_slice_flush(surf);
+}
+
+
+/**
+ * @brief wait while any draw buffer in mask is being flushed
+ * @param fbdev point to frame buffer device
+ * @param mask bit mask of draw buffer
+ * @return none
+ * @note the flush_wait hook of device is called in the loop if it is set
+ */
+static inline void draw_buffer_wait(sgl_fbdev_t *fbdev, uint8_t mask)
+{
+    while (fbdev->fb_status & mask) {
+        if (fbdev->fbinfo.flush_wait != NULL) {
+            fbdev->fbinfo.flush_wait();
+        }
+    }
+}
+
+
+#if (CONFIG_SGL_MOVE_AREA_NUM_MAX)
+/**
+ * @brief copy the moved objects on screen, it should be done before drawing dirty areas
+ * @param fbdev point to frame buffer device
+ * @return none
+ * @note the copied pixels must be on screen, so all of the flushes in flight are waited at first
+ */
+static inline void draw_copy_task(sgl_fbdev_t *fbdev)
+{
+    sgl_area_t src;
+
+    if (fbdev->copy_num == 0) {
+        return;
+    }
+
+    draw_buffer_wait(fbdev, SGL_DRAW_BUFFER_MASK);
+
+    for (int i = 0; i < fbdev->copy_num; i++) {
+        src.x1 = fbdev->copy[i].dst.x1 - fbdev->copy[i].dx;
+        src.y1 = fbdev->copy[i].dst.y1 - fbdev->copy[i].dy;
+        src.x2 = fbdev->copy[i].dst.x2 - fbdev->copy[i].dx;
+        src.y2 = fbdev->copy[i].dst.y2 - fbdev->copy[i].dy;
+
+        fbdev->fbinfo.copy_area(&fbdev->copy[i].dst, &src);
+    }
+
+    fbdev->copy_num = 0;
+}
+#endif
+
+
+/**
+ * @brief start to flush a rendered surface, the function returns as soon as the flush is started
+ * @param fbdev point to frame buffer device
+ * @param surf surface that has been rendered
+ * @param index index of draw buffer that the surface is rendered into
+ * @return none
+ * @note only one flush is in flight, so it waits for the previous flush at first
+ */
+static inline void draw_slice_submit(sgl_fbdev_t *fbdev, sgl_surf_t *surf, uint8_t index)
+{
+    draw_buffer_wait(fbdev, SGL_DRAW_BUFFER_MASK);
+
+    fbdev->fb_status = (1 << index);
+    draw_slice_flush(surf);
+}
+
+
+#if (CONFIG_SGL_DRAW_THREADS)
+/**
+ * @brief band render worker pool
+ * @lock: protect the pending flag of workers and the running counter
+ * @start: wake up workers when bands are pending
+ * @done: wake up the draw task when a band is finished
+ * @mm_lock: protect memory pool, construct function may alloc memory in worker thread
+ * @head: root object that is rendered
+ * @running: number of bands that are not finished
+ * @ready: worker threads are created
+ * @quit: worker threads should exit
+ * @worker: worker thread and the surface it renders
+ */
+static struct {
+    pthread_mutex_t    lock;
+    pthread_cond_t     start;
+    pthread_cond_t     done;
+    pthread_mutex_t    mm_lock;
+    sgl_obj_t          *head;
+    int                running;
+    bool               ready;
+    bool               quit;
+    struct {
+        pthread_t      thread;
+        sgl_surf_t     surf;
+        bool           pending;
+    } worker[CONFIG_SGL_DRAW_THREADS];
+} draw_pool = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .start = PTHREAD_COND_INITIALIZER,
+    .done = PTHREAD_COND_INITIALIZER,
+    .mm_lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+
+/**
+ * @brief lock memory pool
+ * @param none
+ * @return none
+ */
+void sgl_mm_lock(void)
+{
+    pthread_mutex_lock(&draw_pool.mm_lock);
+}
+
+
+/**
+ * @brief unlock memory pool
+ * @param none
+ * @return none
+ */
+void sgl_mm_unlock(void)
+{
+    pthread_mutex_unlock(&draw_pool.mm_lock);
+}
+
+
+/**
+ * @brief band render worker thread
+ * @param arg index of worker
+ * @return none
+ */
+static void* draw_pool_worker(void *arg)
+{
+    const int id = (int)(intptr_t)arg;
+
+    pthread_mutex_lock(&draw_pool.lock);
+    while (1) {
+        while (!draw_pool.worker[id].pending && !draw_pool.quit) {
+            pthread_cond_wait(&draw_pool.start, &draw_pool.lock);
+        }
+        if (draw_pool.quit) {
+            break;
+        }
+        pthread_mutex_unlock(&draw_pool.lock);
+
+        draw_obj_render(draw_pool.head, &draw_pool.worker[id].surf);
+
+        pthread_mutex_lock(&draw_pool.lock);
+        draw_pool.worker[id].pending = false;
+        if (--draw_pool.running == 0) {
+            pthread_cond_signal(&draw_pool.done);
+        }
+    }
+    pthread_mutex_unlock(&draw_pool.lock);
+
+    /* the caches are thread local, so nobody else can free them */
+    sgl_draw_corner_cache_free();
+    sgl_font_glyph_cache_free();
+    return NULL;
+}
+
+
+/**
+ * @brief create band render worker threads and their draw buffer
+ * @param buffer_size draw buffer size in pixels of every worker
+ * @return int, 0 if success, -1 if failed
+ */
+static int draw_pool_init(uint32_t buffer_size)
+{
+    if (draw_pool.ready) {
+        return 0;
+    }
+
+    for (int i = 0; i < CONFIG_SGL_DRAW_THREADS; i++) {
+        draw_pool.worker[i].surf.buffer = (sgl_color_t*)sgl_malloc(buffer_size * sizeof(sgl_color_t));
+        if (draw_pool.worker[i].surf.buffer == NULL) {
+            SGL_LOG_ERROR("draw_pool_init: alloc worker buffer failed");
+            return -1;
+        }
+        draw_pool.worker[i].surf.size = buffer_size;
+        draw_pool.worker[i].pending = false;
+
+        if (pthread_create(&draw_pool.worker[i].thread, NULL, draw_pool_worker, (void*)(intptr_t)i)) {
+            SGL_LOG_ERROR("draw_pool_init: create worker thread failed");
+            return -1;
+        }
+    }
+
+    draw_pool.ready = true;
+    return 0;
+}
+
+
+/**
+ * @brief stop band render worker threads and free their draw buffer
+ * @param none
+ * @return none
+ */
+static void draw_pool_deinit(void)
+{
+    if (!draw_pool.ready) {
+        return;
+    }
+
+    /* the worker buffers may be still in flushing */
+    draw_buffer_wait(&sgl_system.fbdev, SGL_DRAW_BUFFER_MASK);
+
+    pthread_mutex_lock(&draw_pool.lock);
+    draw_pool.quit = true;
+    pthread_cond_broadcast(&draw_pool.start);
+    pthread_mutex_unlock(&draw_pool.lock);
+
+    for (int i = 0; i < CONFIG_SGL_DRAW_THREADS; i++) {
+        pthread_join(draw_pool.worker[i].thread, NULL);
+        sgl_free(draw_pool.worker[i].surf.buffer);
+        draw_pool.worker[i].surf.buffer = NULL;
+    }
+
+    draw_pool.quit = false;
+    draw_pool.ready = false;
+}
+
+
+/**
+ * @brief check if a dirty area contains an object that must be drawn band by band in order
+ * @param obj it should point to active root object
+ * @param dirty dirty area
+ * @return true if the dirty area must be drawn in serial, otherwise false
+ */
+static inline bool draw_area_is_serial(sgl_obj_t *obj, sgl_area_t *dirty)
+{
+    int top = 0;
+    sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX];
+
+    stack[top++] = obj;
+
+    while (top > 0) {
+        SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
+        obj = stack[--top];
+
+        if (obj->sibling != NULL) {
+            stack[top++] = obj->sibling;
+        }
+
+        if (sgl_obj_is_hidden(obj) || !sgl_area_is_overlap(dirty, &obj->bounds)) {
+            continue;
+        }
+
+        if (obj->serial && sgl_area_is_overlap(dirty, &obj->area)) {
+            return true;
+        }
+
+        if (obj->child != NULL) {
+            stack[top++] = obj->child;
+        }
+    }
+
+    return false;
+}
+
+
+/**
+ * @brief draw a dirty area by worker threads, every worker renders one band and
+ *        the bands are flushed in order from top to bottom
+ * @param fbdev point to frame buffer device
+ * @param head root object
+ * @param dirty dirty area
+ * @param band_h height of band
+ * @return none
+ */
+static void draw_area_parallel(sgl_fbdev_t *fbdev, sgl_obj_t *head, sgl_area_t *dirty, int16_t band_h)
+{
+    int16_t y1 = dirty->y1;
+    int num = 0;
+
+    while (y1 <= dirty->y2) {
+        /* the worker buffers of last wave may be still in flushing */
+        draw_buffer_wait(fbdev, SGL_DRAW_BUFFER_MASK);
+
+        pthread_mutex_lock(&draw_pool.lock);
+        for (num = 0; num < CONFIG_SGL_DRAW_THREADS && y1 <= dirty->y2; num++) {
+            sgl_surf_t *surf = &draw_pool.worker[num].surf;
+
+            surf->x1 = dirty->x1;
+            surf->x2 = dirty->x2;
+            surf->y1 = y1;
+            surf->y2 = y1 + sgl_min(dirty->y2 - y1 + 1, band_h) - 1;
+            surf->w = surf->x2 - surf->x1 + 1;
+            surf->h = band_h;
+            surf->dirty = dirty;
+
+            draw_pool.worker[num].pending = true;
+            y1 = surf->y2 + 1;
+        }
+        draw_pool.head = head;
+        draw_pool.running = num;
+        pthread_cond_broadcast(&draw_pool.start);
+
+        while (draw_pool.running > 0) {
+            pthread_cond_wait(&draw_pool.done, &draw_pool.lock);
+        }
+        pthread_mutex_unlock(&draw_pool.lock);
+
+        for (int i = 0; i < num; i++) {
+            draw_slice_submit(fbdev, &draw_pool.worker[i].surf, fbdev->fb_swap);
+        }
+    }
+}
+#endif // !CONFIG_SGL_DRAW_THREADS
+
+
+/**
+ * @brief reset the subtree bounds of object to its own area
+ * @param obj point to object
+ * @return none
+ */
+static inline void sgl_obj_bounds_reset(sgl_obj_t *obj)
+{
+    if (sgl_obj_is_hidden(obj)) {
+        sgl_area_init(&obj->bounds);
+    }
+    else {
+        obj->bounds = obj->area;
+    }
+}
+
+
+/**
+ * @brief update the subtree bounds of all objects, the children are visited before parent
+ * @param root it should point to active root object
+ * @return none
+ * @note hidden object has invalid bounds and its children are not visited
+ */
+static inline void sgl_obj_bounds_update(sgl_obj_t *root)
+{
+    sgl_obj_t *obj = root;
+    sgl_obj_bounds_reset(obj);
+
+    while (1) {
+        /* go down to the first child */
+        if (obj->child != NULL && !sgl_obj_is_hidden(obj)) {
+            obj = obj->child;
+            sgl_obj_bounds_reset(obj);
+            continue;
+        }
+
+        /* the subtree is finished, merge it into parent until a sibling is found */
+        while (obj != root && obj->sibling == NULL) {
+            sgl_area_selfmerge(&obj->parent->bounds, &obj->bounds);
+            obj = obj->parent;
+        }
+
+        if (obj == root) {
+            return;
+        }
+
+        sgl_area_selfmerge(&obj->parent->bounds, &obj->bounds);
+        obj = obj->sibling;
+        sgl_obj_bounds_reset(obj);
+    }
+}
+
+
 /**
  * @brief collect all dirty area by for each all object that is dirty and visible
  * @param obj it should point to active root object
@@ -1768,6 +3002,7 @@ static inline void draw_obj_slice(sgl_obj_t *obj, sgl_surf_t *surf)
 static inline void sgl_dirty_area_harvest(sgl_obj_t *obj)
 {
     sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX];
+    sgl_obj_t *root = obj;
     int top = 0;
     stack[top++] = obj;
 
@@ -1786,6 +3021,12 @@ static inline void sgl_dirty_area_harvest(sgl_obj_t *obj)
             /* merge destroy area */
             sgl_dirty_area_push(&obj->area);
 
+#if (CONFIG_SGL_MOVE_AREA_NUM_MAX)
+            if (unlikely(sgl_system.fbdev.move_num > 0)) {
+                sgl_move_forget(obj);
+            }
+#endif
+
             sgl_event_t evt = {
                 .type = SGL_EVENT_DESTROYED,
             };
@@ -1824,6 +3065,17 @@ static inline void sgl_dirty_area_harvest(sgl_obj_t *obj)
 
         /* check child dirty and merge all dirty area */
         if (sgl_obj_is_dirty(obj)) {
+#if (CONFIG_SGL_MOVE_AREA_NUM_MAX)
+            /* the object is only moved, its descendants are not harvested if they are not dirty */
+            if (unlikely(sgl_system.fbdev.move_num > 0) && sgl_dirty_area_move(obj)) {
+                sgl_obj_clear_dirty(obj);
+
+                if (obj->child != NULL) {
+                    stack[top++] = obj->child;
+                }
+                continue;
+            }
+#endif
             /* merge dirty area */
             sgl_dirty_area_push(&obj->area);
 
@@ -1846,6 +3098,16 @@ static inline void sgl_dirty_area_harvest(sgl_obj_t *obj)
             stack[top++] = obj->child;
         }
     }
+
+#if (CONFIG_SGL_MOVE_AREA_NUM_MAX)
+    /* the moved object is not harvested, for example it is hidden, it will be harvested as usual */
+    while (sgl_system.fbdev.move_num > 0) {
+        sgl_move_cancel(sgl_system.fbdev.move_num - 1);
+    }
+#endif
+
+    /* object may be moved, resized, added, removed or hidden, so update the subtree bounds */
+    sgl_obj_bounds_update(root);
 }
 
 
@@ -1863,6 +3125,10 @@ static inline void sgl_draw_task(sgl_fbdev_t *fbdev, sgl_area_t *dirty_area, uin
     sgl_obj_t  *head = fbdev->active;
     sgl_area_t *dirty = NULL;
 
+#if (CONFIG_SGL_DISPLAY_LIST)
+    draw_dlist_record(head, dirty_area, dirty_num);
+#endif
+
     /* dirty area number must less than SGL_DIRTY_AREA_MAX */
     for (uint8_t i = 0; i < dirty_num; i++) {
         dirty = &dirty_area[i];
@@ -1875,6 +3141,8 @@ static inline void sgl_draw_task(sgl_fbdev_t *fbdev, sgl_area_t *dirty_area, uin
 
         /* check dirty area, ensure it is valid */
         SGL_ASSERT(dirty->x1 >= 0 && dirty->y1 >= 0 && dirty->x2 < SGL_SCREEN_WIDTH && dirty->y2 < SGL_SCREEN_HEIGHT);
+        SGL_PERF_ADD(dirty_area, 1);
+        SGL_PERF_ADD(dirty_pixel, sgl_area_pixels(dirty));
 
 #if (!CONFIG_SGL_USE_FBDEV_VRAM)
 
@@ -1889,18 +3157,30 @@ static inline void sgl_draw_task(sgl_fbdev_t *fbdev, sgl_area_t *dirty_area, uin
 
         SGL_LOG_TRACE("[fb:%d]sgl_draw_task: dirty area  x1:%d y1:%d x2:%d y2:%d", fbdev->fb_swap, dirty->x1, dirty->y1, dirty->x2, dirty->y2);
 
+#if (CONFIG_SGL_DRAW_THREADS)
+        /* the bands are rendered by worker threads if no object keeps state from band to band */
+        if (draw_pool.ready && !draw_area_is_serial(head, dirty)) {
+            draw_area_parallel(fbdev, head, dirty, surf->h);
+            continue;
+        }
+#endif
+
         while (surf->y1 <= dirty->y2) {
             draw_h = sgl_min(dirty->y2 - surf->y1 + 1, surf->h);
             surf->y2 = surf->y1 + draw_h - 1;
 
-            /* wait current framebuffer for ready */
-            while (sgl_fbdev_flush_wait_ready(fbdev));
+            /* wait current framebuffer for ready, it is in flight since two bands ago */
+            draw_buffer_wait(fbdev, 1 << fbdev->fb_swap);
+            surf->buffer = (sgl_color_t*)fbdev->fbinfo.buffer[fbdev->fb_swap];
 
-            /* reset current framebuffer ready flag */
-            fbdev->fb_status = (fbdev->fb_status & (2 - fbdev->fb_swap));
+            /* draw object slice and start to flush it */
+            draw_obj_render(head, surf);
+            draw_slice_submit(fbdev, surf, fbdev->fb_swap);
 
-            /* draw object slice until the dirty area is finished */
-            draw_obj_slice(head, surf);
+            /* render next band into the other buffer while this one is in flight */
+            if (fbdev->fbinfo.buffer[1] != NULL) {
+                fbdev->fb_swap ^= 1;
+            }
             surf->y1 += draw_h;
         }
 #else
@@ -1933,6 +3213,11 @@ void sgl_task_handler_sync(void)
         sgl_system.fbdev.update_flag = 0;
     }
 
+#if (CONFIG_SGL_MOVE_AREA_NUM_MAX)
+    /* copy the moved objects on screen, the rest of them is in dirty area */
+    draw_copy_task(&sgl_system.fbdev);
+#endif
+
 #if (CONFIG_SGL_DIRTY_AREA_TRACE)
     /* update trace dirty area */
     if (sgl_system.fbdev.dirty_num) {
@@ -31,4 +31,9 @@ set(SGL_SOURCE
     ${CMAKE_CURRENT_LIST_DIR}/sgl_draw_ring.c
     ${CMAKE_CURRENT_LIST_DIR}/sgl_draw_icon.c
     ${CMAKE_CURRENT_LIST_DIR}/sgl_draw_xform.c
+    ${CMAKE_CURRENT_LIST_DIR}/sgl_draw_dlist.c
+    ${CMAKE_CURRENT_LIST_DIR}/sgl_draw_ops.c
+    ${CMAKE_CURRENT_LIST_DIR}/sgl_draw_corner.c
+    ${CMAKE_CURRENT_LIST_DIR}/sgl_draw_img_cache.c
+    ${CMAKE_CURRENT_LIST_DIR}/sgl_draw_pixmap.c
 )
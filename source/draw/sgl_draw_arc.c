@@ -101,20 +101,216 @@ static inline uint8_t arc_get_dot(sgl_arc_dot_t *dot,int ax, int ay)
 }
 
 
+/**
+ * @brief angle range of arc
+ * @flag: 255 if the arc is a full circle, 1 if the arc is larger than 180 degree, otherwise 0
+ * @sx: x of start direction
+ * @sy: y of start direction
+ * @ex: x of end direction
+ * @ey: y of end direction
+ * @dot: round caps of smooth mode
+ */
+typedef struct sgl_arc_angle
+{
+    uint8_t        flag;
+    int32_t        sx;
+    int32_t        sy;
+    int32_t        ex;
+    int32_t        ey;
+    sgl_arc_dot_t  dot[2];
+} sgl_arc_angle_t;
+
+
+/**
+ * @brief get the largest distance to the center column of the pixels in a row that are inside a squared radius
+ * @param prev result of the previous row, -2 if it is unknown
+ * @param limit squared radius, the pixel is inside if its squared distance is less than it
+ * @param y2 squared distance of the row
+ * @return the largest distance, -1 if there is no pixel inside
+ * @note the distance of neighbouring rows is close, so the previous result is moved pixel by pixel
+ */
+static inline int16_t arc_row_half(int16_t prev, int32_t limit, int32_t y2)
+{
+    int16_t d = prev;
+
+    if (d < -1) {
+        limit -= y2;
+        return limit > 0 ? (int16_t)sgl_sqrt(limit - 1) : -1;
+    }
+
+    while (d >= 0 && sgl_pow2(d) + y2 >= limit) {
+        d --;
+    }
+    while (sgl_pow2(d + 1) + y2 < limit) {
+        d ++;
+    }
+    return d;
+}
+
+
+/**
+ * @brief get the pixels of an arc row that are from d1 to d2 away from the center column, in left half and right half
+ * @param clip clip area
+ * @param cx center x of arc
+ * @param d1 first distance, the center column is in left half
+ * @param d2 last distance
+ * @param part [out] x range in left half and right half, a range is empty if x1 > x2
+ * @return none
+ */
+static inline void arc_row_part(const sgl_area_t *clip, int16_t cx, int16_t d1, int16_t d2, sgl_area_t part[2])
+{
+    part[0].x1 = sgl_max(cx - d2, clip->x1);
+    part[0].x2 = sgl_min(cx - d1, clip->x2);
+    part[1].x1 = sgl_max(cx + sgl_max(d1, 1), clip->x1);
+    part[1].x2 = sgl_min(cx + d2, clip->x2);
+}
+
+
+/**
+ * @brief find where the sign of a line changes in a part of row
+ * @param a slope of line, the value of line is a * dx + b
+ * @param b offset of line
+ * @param strict compare the value with zero by > if it is true, otherwise by >=
+ * @param dx1 first distance to the center column
+ * @param dx2 last distance to the center column
+ * @return the first distance that the result of compare differs from dx1, dx2 + 1 if there is none
+ * @note the line is monotone, so the result is found by binary search
+ */
+static int32_t arc_sign_change(int32_t a, int32_t b, bool strict, int32_t dx1, int32_t dx2)
+{
+    const bool first = strict ? (a * dx1 + b > 0) : (a * dx1 + b >= 0);
+    int32_t lo = dx1, hi = dx2 + 1, mid;
+
+    while (hi - lo > 1) {
+        mid = lo + (hi - lo) / 2;
+        if ((strict ? (a * mid + b > 0) : (a * mid + b >= 0)) == first) {
+            lo = mid;
+        }
+        else {
+            hi = mid;
+        }
+    }
+
+    return hi;
+}
+
+
+/**
+ * @brief blend a pixel of arc
+ * @param desc arc description
+ * @param angle angle range of arc
+ * @param blend pixel
+ * @param x x of pixel
+ * @param y y of pixel
+ * @param edge_alpha coverage of the radius
+ * @return none
+ */
+static inline void arc_blend_pixel(sgl_draw_arc_t *desc, sgl_arc_angle_t *angle, sgl_color_t *blend, int x, int y, uint8_t edge_alpha)
+{
+    int32_t dx = x - desc->cx, dy = y - desc->cy;
+    int32_t ds, de, sd, ed, dist;
+    uint8_t in_range;
+    sgl_color_t tmp_color = desc->color;
+
+    if (angle->flag != 255) {
+        ds = (dx *  angle->sy - dy *  angle->sx);
+        de = (dy *  angle->ex - dx *  angle->ey);
+        in_range =  angle->flag > 0 ? (ds > 0 || de >0) : (ds >= 0 && de >= 0);
+        if (!in_range) {
+
+            switch (desc->mode) {
+            case SGL_ARC_MODE_NORMAL:
+                sd = sgl_xy_has_component(dx,dy, angle->sx, angle->sy) ? sgl_abs(ds) : 256;
+                ed = sgl_xy_has_component(dx,dy, angle->ex, angle->ey) ? sgl_abs(de) : 256;
+                dist =  sgl_min(sd, ed);
+                tmp_color = (dist < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, *blend, sgl_min(255 - dist, edge_alpha)) : *blend;
+                break;
+
+            case SGL_ARC_MODE_RING:
+                sd = sgl_xy_has_component(dx,dy, angle->sx, angle->sy) ? sgl_abs(ds) : 256;
+                ed = sgl_xy_has_component(dx,dy, angle->ex, angle->ey) ? sgl_abs(de) : 256;
+                dist =  sgl_min(sd, ed);
+                tmp_color = (dist < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, desc->bg_color, sgl_min(255 - dist, edge_alpha)) : desc->bg_color;
+                break;
+
+            case SGL_ARC_MODE_NORMAL_SMOOTH:
+                dist = arc_get_dot(angle->dot, x, y);
+                tmp_color = (dist < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, *blend, dist) : desc->color;
+                break;
+
+            case SGL_ARC_MODE_RING_SMOOTH:
+                dist = arc_get_dot(angle->dot, x, y);
+                tmp_color = (dist < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, desc->bg_color, dist) : desc->color;
+                break;
+
+            default: break;
+            }
+        }
+    }
+
+    *blend = desc->alpha == SGL_ALPHA_MAX ? sgl_color_mixer(tmp_color, *blend, edge_alpha) : sgl_color_mixer(sgl_color_mixer(tmp_color, *blend, edge_alpha), *blend, desc->alpha);
+}
+
+
+/**
+ * @brief draw the solid part of an arc row, the pixels in angle range are filled as spans
+ * @param surf pointer to surface
+ * @param desc arc description
+ * @param angle angle range of arc
+ * @param buf pixel of first x of clip area in this row
+ * @param clip clip area
+ * @param part x range of the solid part
+ * @param y row
+ * @return none
+ * @note the start line and end line of angle cross a row at most once, so a part has at most three runs
+ */
+static void arc_draw_solid(sgl_surf_t *surf, sgl_draw_arc_t *desc, sgl_arc_angle_t *angle, sgl_color_t *buf, sgl_area_t *clip, sgl_area_t *part, int y)
+{
+    const int32_t dy = y - desc->cy;
+    const bool strict = angle->flag > 0;
+    const int32_t dx2 = part->x2 - desc->cx;
+    int32_t dx, next;
+    sgl_area_t span = { .y1 = y, .y2 = y };
+
+    for (dx = part->x1 - desc->cx; dx <= dx2; dx = next) {
+        if (angle->flag == 255) {
+            next = dx2 + 1;
+        }
+        else {
+            next = sgl_min(arc_sign_change(angle->sy, -dy * angle->sx, strict, dx, dx2),
+                           arc_sign_change(-angle->ey, dy * angle->ex, strict, dx, dx2));
+        }
+
+        if (angle->flag == 255 || (strict ? (dx * angle->sy - dy * angle->sx > 0 || dy * angle->ex - dx * angle->ey > 0) :
+                                            (dx * angle->sy - dy * angle->sx >= 0 && dy * angle->ex - dx * angle->ey >= 0))) {
+            span.x1 = desc->cx + dx;
+            span.x2 = desc->cx + next - 1;
+            sgl_draw_ops_surf_area(surf, &span, desc->color, desc->alpha);
+        }
+        else {
+            for (int x = desc->cx + dx; x < desc->cx + next; x++) {
+                arc_blend_pixel(desc, angle, &buf[x - clip->x1], x, y, SGL_ALPHA_MAX);
+            }
+        }
+    }
+}
+
+
 /**
  * @brief draw an arc with alpha
  * @param surf pointer to surface
  * @param area pointer to area
  * @param desc pointer to arc description
  * @return none
+ * @note the solid part of every row is filled as spans, only the edge pixels and the pixels
+ *       out of angle range compute the coverage
  */
 void sgl_draw_fill_arc(sgl_surf_t *surf, sgl_area_t *area, sgl_draw_arc_t *desc)
 {
     int y2 = 0, real_r2 = 0, edge_alpha = 0;
     int in_r2 = sgl_pow2(desc->radius_in);
     int out_r2 = sgl_pow2(desc->radius_out);
-    int inv_inner = 0, inv_outer = 0;
-    sgl_arc_dot_t arc_dot[2];
+    sgl_arc_angle_t angle = { .flag = 0xff };
 
     int in_r2_max = sgl_pow2(desc->radius_in - 1);
     int out_r2_max = sgl_pow2(desc->radius_out + 1);
@@ -122,12 +318,16 @@ void sgl_draw_fill_arc(sgl_surf_t *surf, sgl_area_t *area, sgl_draw_arc_t *desc)
     int32_t rate2 = (0xff00) / (out_r2_max - out_r2);
 
     sgl_color_t *buf = NULL, *blend = NULL;
-    int32_t dx, dy;
-    uint8_t flag = 0xff, in_range;
-    int32_t ds = 0, de = 0, sd = 0, ed = 0;
-    int32_t sx = 0, sy = 0, ex = 0, ey = 0;
-    sgl_color_t tmp_color;
-    sgl_area_t clip = SGL_AREA_MAX;
+    int16_t hole = -2, in_edge = -2, solid = -2, out = -2;
+    int16_t d_hole, d_in_edge, d_solid;
+    sgl_area_t clip = SGL_AREA_MAX, part[2];
+
+#if (CONFIG_SGL_DISPLAY_LIST)
+    if (unlikely(sgl_dlist_is_recording(surf))) {
+        sgl_dlist_fill_arc(area, desc);
+        return;
+    }
+#endif
 
     sgl_surf_clip_area_return(surf, area, &clip);
 
@@ -146,102 +346,69 @@ void sgl_draw_fill_arc(sgl_surf_t *surf, sgl_area_t *area, sgl_draw_arc_t *desc)
         /* Compute arc span with wrap-around support (e.g. start=315 end=45 => span=90°) */
         int16_t arc_span = desc->end_angle - desc->start_angle;
         if (arc_span < 0) arc_span += 360;
-        flag = (arc_span > 180) ? 1 : 0;
-        sx = sgl_sin(desc->start_angle);
-        sy = -sgl_cos(desc->start_angle);
-        ex = sgl_sin(desc->end_angle);
-        ey = -sgl_cos(desc->end_angle);
+        angle.flag = (arc_span > 180) ? 1 : 0;
+        angle.sx = sgl_sin(desc->start_angle);
+        angle.sy = -sgl_cos(desc->start_angle);
+        angle.ex = sgl_sin(desc->end_angle);
+        angle.ey = -sgl_cos(desc->end_angle);
 
         if (desc->mode == SGL_ARC_MODE_NORMAL_SMOOTH || desc->mode == SGL_ARC_MODE_RING_SMOOTH) {
-            arc_dot_sin_cos(desc->cx, desc->cy, desc->radius_in, desc->radius_out, &arc_dot[0], sx, sy);
-            arc_dot_sin_cos(desc->cx, desc->cy, desc->radius_in, desc->radius_out, &arc_dot[1], ex, ey);
+            arc_dot_sin_cos(desc->cx, desc->cy, desc->radius_in, desc->radius_out, &angle.dot[0], angle.sx, angle.sy);
+            arc_dot_sin_cos(desc->cx, desc->cy, desc->radius_in, desc->radius_out, &angle.dot[1], angle.ex, angle.ey);
         }
 
-        sx = sx >> 7;
-        sy = sy >> 7;
-        ex = ex >> 7;
-        ey = ey >> 7;
+        angle.sx = angle.sx >> 7;
+        angle.sy = angle.sy >> 7;
+        angle.ex = angle.ex >> 7;
+        angle.ey = angle.ey >> 7;
     }
 
     buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
-    for (int y = clip.y1; y <= clip.y2; y++) {
-        dy = y - desc->cy;
-        y2 = sgl_pow2(dy);
-        blend = buf;
-
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            dx = x - desc->cx;
-            real_r2 = sgl_pow2(x - desc->cx) + y2;
-
-            if (real_r2 >= out_r2_max) {
-                if (x > desc->cx) {
-                    blend++;
-                    break;
-                }
-                continue;
-            }
-            if (real_r2 < in_r2_max) {
-                if (x < desc->cx) {
-                    blend += ((desc->cx - x) * 2);
-                    x = desc->cx * 2 - x;
-                }
-                continue;
-            }
-            if (real_r2 < in_r2 ) {
-                if(inv_inner == 0) {
-                    inv_inner = rate;
-                }
-                edge_alpha  = (real_r2 - in_r2_max) * inv_inner >> 8;
-            }
-            else if (real_r2 > out_r2) {
-                if(inv_outer == 0) {
-                    inv_outer = rate2;
-                }
-                edge_alpha = (out_r2_max - real_r2) * inv_outer >> 8;
-            }
-            else {
-                edge_alpha = SGL_ALPHA_MAX;
+    for (int y = clip.y1; y <= clip.y2; y++, buf += surf->w) {
+        y2 = sgl_pow2(y - desc->cy);
+        out = arc_row_half(out, out_r2_max, y2);
+        if (out < 0) {
+            continue;
+        }
+
+        /* the parts are hole, inner edge, solid and outer edge, from the center to outside */
+        hole = arc_row_half(hole, in_r2_max, y2);
+        in_edge = arc_row_half(in_edge, in_r2, y2);
+        solid = arc_row_half(solid, out_r2 + 1, y2);
+        d_hole = sgl_min(hole, out);
+        d_in_edge = sgl_min(sgl_max(in_edge, d_hole), out);
+        d_solid = sgl_min(sgl_max(solid, d_in_edge), out);
+
+        arc_row_part(&clip, desc->cx, d_hole + 1, d_in_edge, part);
+        for (int i = 0; i < 2; i++) {
+            blend = &buf[part[i].x1 - clip.x1];
+            for (int x = part[i].x1; x <= part[i].x2; x++, blend++) {
+                real_r2 = sgl_pow2(x - desc->cx) + y2;
+                edge_alpha = (real_r2 - in_r2_max) * rate >> 8;
+                arc_blend_pixel(desc, &angle, blend, x, y, edge_alpha);
             }
+        }
 
-            tmp_color = desc->color;
-            if (flag != 255) {
-                ds = (dx *  sy - dy *  sx);
-                de = (dy *  ex - dx *  ey);
-                in_range =  flag > 0 ? (ds > 0 || de >0) : (ds >= 0 && de >= 0);
-                if (!in_range) {
-
-                    switch (desc->mode) {
-                    case SGL_ARC_MODE_NORMAL:
-                        sd = sgl_xy_has_component(dx,dy, sx, sy) ? sgl_abs(ds) : 256;
-                        ed = sgl_xy_has_component(dx,dy, ex, ey) ? sgl_abs(de) : 256;
-                        dx =  sgl_min(sd, ed);
-                        tmp_color = (dx < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, *blend, sgl_min(255 - dx, edge_alpha)) : *blend;
-                        break;
-
-                    case SGL_ARC_MODE_RING:
-                        sd = sgl_xy_has_component(dx,dy, sx, sy) ? sgl_abs(ds) : 256;
-                        ed = sgl_xy_has_component(dx,dy, ex, ey) ? sgl_abs(de) : 256;
-                        dx =  sgl_min(sd, ed);
-                        tmp_color = (dx < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, desc->bg_color, sgl_min(255 - dx, edge_alpha)) : desc->bg_color;
-                        break;
-
-                    case SGL_ARC_MODE_NORMAL_SMOOTH:
-                        dx = arc_get_dot(arc_dot, x, y);
-                        tmp_color = (dx < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, *blend, dx) : desc->color;
-                        break;
-
-                    case SGL_ARC_MODE_RING_SMOOTH:
-                        dx = arc_get_dot(arc_dot, x, y);
-                        tmp_color = (dx < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, desc->bg_color, dx) : desc->color;
-                        break;
-
-                    default: break;
-                    }
-                }
+        arc_row_part(&clip, desc->cx, d_in_edge + 1, d_solid, part);
+        if (d_in_edge < 0) {
+            /* there is no hole in this row, the solid part of both halves is one span */
+            part[0].x2 = part[1].x2;
+            part[1].x1 = part[1].x2 + 1;
+        }
+        for (int i = 0; i < 2; i++) {
+            if (part[i].x1 <= part[i].x2) {
+                arc_draw_solid(surf, desc, &angle, buf, &clip, &part[i], y);
             }
+        }
 
-            *blend = desc->alpha == SGL_ALPHA_MAX ? sgl_color_mixer(tmp_color, *blend, edge_alpha) : sgl_color_mixer(sgl_color_mixer(tmp_color, *blend, edge_alpha), *blend, desc->alpha);
+        arc_row_part(&clip, desc->cx, d_solid + 1, out, part);
+        for (int i = 0; i < 2; i++) {
+            blend = &buf[part[i].x1 - clip.x1];
+            for (int x = part[i].x1; x <= part[i].x2; x++, blend++) {
+                real_r2 = sgl_pow2(x - desc->cx) + y2;
+                edge_alpha = (out_r2_max - real_r2) * rate2 >> 8;
+                arc_blend_pixel(desc, &angle, blend, x, y, edge_alpha);
+            }
         }
-        buf += surf->w;
     }
 }
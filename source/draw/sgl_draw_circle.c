@@ -37,6 +37,7 @@
  * @param color Color of the circle
  * @param alpha Alpha of the circle
  * @return none
+ * @note the inside of every row is filled as one span, only the edge pixels compute the distance
  */
 void sgl_draw_fill_circle(sgl_surf_t *surf, sgl_area_t *area, int16_t cx, int16_t cy, int16_t radius, sgl_color_t color, uint8_t alpha)
 {
@@ -47,37 +48,58 @@ void sgl_draw_fill_circle(sgl_surf_t *surf, sgl_area_t *area, int16_t cx, int16_
     int cx2 = 2 * cx + 1;
     int cy2 = 2 * cy + 1;
     int dx2 = 0, dy2 = 0;
+    int16_t j_in = -1, j_out = -1;
+    sgl_area_t span, part[2];
     const int diameter = radius << 1;
     const int r2_max = sgl_pow2(diameter);
     const int r2 = sgl_max(sgl_pow2(diameter - 3), 0); 
     const int r2_fix_diff = (SGL_ALPHA_MAX  << SGL_FIXED_SHIFT) / sgl_max(r2_max - r2, 1);
     sgl_color_t *blend, *buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
 
-    for (int y = clip.y1; y <= clip.y2; y++) {
-        blend = buf;
+    for (int y = clip.y1; y <= clip.y2; y++, buf += surf->w) {
         dy2 = sgl_pow2(2 * y - cy2);
-
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            dx2 = sgl_pow2(2 * x - cx2) + dy2;
-
-            if (dx2 >= r2_max) {
-                if (x > cx)
-                    break;
-                continue;
-            }
-            else if (dx2 >= r2) {
+        j_out = sgl_draw_circle_half(j_out, r2_max, dy2);
+        if (j_out == 0) {
+            continue;
+        }
+        j_in = sgl_draw_circle_half(j_in, r2, dy2);
+
+        sgl_draw_circle_part(&clip, cx, 1, j_in, part);
+        span.x1 = part[0].x1;
+        span.x2 = part[1].x2;
+        span.y1 = span.y2 = y;
+        sgl_draw_ops_surf_area(surf, &span, color, alpha);
+
+        sgl_draw_circle_part(&clip, cx, j_in + 1, j_out, part);
+        for (int i = 0; i < 2; i++) {
+            blend = &buf[part[i].x1 - clip.x1];
+            for (int x = part[i].x1; x <= part[i].x2; x++, blend++) {
+                dx2 = sgl_pow2(2 * x - cx2) + dy2;
                 edge_alpha = ((r2_max - dx2) * r2_fix_diff) >> SGL_FIXED_SHIFT;
                 *blend = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(color, *blend, edge_alpha) : sgl_color_mixer(sgl_color_mixer(color, *blend, edge_alpha), *blend, alpha));
             }
-            else {
-                *blend = (alpha == SGL_ALPHA_MAX) ? color : sgl_color_mixer(color, *blend, alpha);
-            }
         }
-        buf += surf->w;
     }
 }
 
-#if (!CONFIG_SGL_PIXMAP_BILINEAR_INTERP)
+
+/**
+ * @brief sample the color of pixmap
+ * @param pixmap pixmap
+ * @param fx x of pixmap in fixed point
+ * @param fy y of pixmap in fixed point
+ * @return color of pixmap
+ */
+static inline sgl_color_t circle_pixmap_sample(const sgl_pixmap_t *pixmap, int32_t fx, int32_t fy)
+{
+#if (CONFIG_SGL_PIXMAP_BILINEAR_INTERP)
+    return sgl_draw_biln_color((const sgl_color_t *)pixmap->bitmap.array, pixmap->width, pixmap->height, fx, fy);
+#else
+    return *sgl_pixmap_get_buf(pixmap, fx >> SGL_FIXED_SHIFT, fy >> SGL_FIXED_SHIFT);
+#endif
+}
+
+
 /**
  * @brief Draw a circle with pixmap and alpha
  * @param surf Surface
@@ -99,91 +121,50 @@ void sgl_draw_fill_circle_pixmap(sgl_surf_t *surf, sgl_area_t *area, int16_t cx,
     int cx2 = 2 * cx + 1;
     int cy2 = 2 * cy + 1;
     int dx2 = 0, dy2 = 0;
+    int16_t j_in = -1, j_out = -1;
+    sgl_area_t part[2];
     const int diameter = radius << 1;
     const int r2_max = sgl_pow2(diameter);
     const int r2 = sgl_max(sgl_pow2(diameter - 3), 0); 
     const int r2_fix_diff = (SGL_ALPHA_MAX  << SGL_FIXED_SHIFT) / sgl_max(r2_max - r2, 1);
-    sgl_color_t *blend, *pbuf, *buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
-
-    const uint32_t scale_x = (pixmap->width << SGL_FIXED_SHIFT) / (radius * 2);
-    const uint32_t scale_y = (pixmap->height << SGL_FIXED_SHIFT) / (radius * 2);
-    uint32_t step_x = 0, step_y = 0;
-
-    for (int y = clip.y1; y <= clip.y2; y++) {
-        blend = buf;
-        dy2 = sgl_pow2(2 * y - cy2);
-        step_y = (scale_y * (y - s_y)) >> SGL_FIXED_SHIFT;
-
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            dx2 = sgl_pow2(2 * x - cx2) + dy2;
-            step_x = (scale_x * (x - s_x)) >> SGL_FIXED_SHIFT;
-            pbuf = sgl_pixmap_get_buf(pixmap, step_x, step_y);
-
-            if (dx2 >= r2_max) {
-                if(x > cx)
-                    break;
-                continue;
-            }
-            else if (dx2 >= r2) {
-                edge_alpha = ((r2_max - dx2) * r2_fix_diff) >> SGL_FIXED_SHIFT;
-                *blend = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(*pbuf, *blend, edge_alpha) : sgl_color_mixer(sgl_color_mixer(*pbuf, *blend, edge_alpha), *blend, alpha));
-            }
-            else {
-                *blend = (alpha == SGL_ALPHA_MAX ? *pbuf : sgl_color_mixer(*pbuf, *blend, alpha));
-            }
-        }
-        buf += surf->w;
-    }
-}
-#else
-void sgl_draw_fill_circle_pixmap(sgl_surf_t *surf, sgl_area_t *area, int16_t cx, int16_t cy, int16_t radius, const sgl_pixmap_t *pixmap, uint8_t alpha)
-{
-    sgl_area_t clip = SGL_AREA_MAX;
-    sgl_surf_clip_area_return(surf, area, &clip);
-
-    uint8_t edge_alpha = 0;
-    int s_x = cx - radius, s_y = cy - radius;
-    int cx2 = 2 * cx + 1;
-    int cy2 = 2 * cy + 1;
-    int dx2 = 0, dy2 = 0;
-    const int diameter = radius << 1;
-    const int r2_max = sgl_pow2(diameter);
-    const int r2 = sgl_max(sgl_pow2(diameter - 3), 0); 
-    const int r2_fix_diff = (SGL_ALPHA_MAX  << SGL_FIXED_SHIFT) / sgl_max(r2_max - r2, 1);
-    sgl_color_t ip_color, *blend, *buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1), *pbuf = (sgl_color_t *)pixmap->bitmap.array;
+    sgl_color_t ip_color, *blend, *buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
 
     const int32_t scale_x = ((int32_t)pixmap->width << SGL_FIXED_SHIFT) / (radius * 2);
     const int32_t scale_y = ((int32_t)pixmap->height << SGL_FIXED_SHIFT) / (radius * 2);
-    int fx = 0, fy = 0;
+    int32_t fx = 0, fy = 0;
 
-    for (int y = clip.y1; y <= clip.y2; y++) {
-        blend = buf;
+    for (int y = clip.y1; y <= clip.y2; y++, buf += surf->w) {
         dy2 = sgl_pow2(2 * y - cy2);
+        j_out = sgl_draw_circle_half(j_out, r2_max, dy2);
+        if (j_out == 0) {
+            continue;
+        }
+        j_in = sgl_draw_circle_half(j_in, r2, dy2);
         fy = (int32_t)(y - s_y) * scale_y;
 
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            dx2 = sgl_pow2(2 * x - cx2) + dy2;
-
+        /* inside, the pixels are not blended with the edge coverage */
+        sgl_draw_circle_part(&clip, cx, 1, j_in, part);
+        blend = &buf[part[0].x1 - clip.x1];
+        for (int x = part[0].x1; x <= part[1].x2; x++, blend++) {
             fx = (int32_t)(x - s_x) * scale_x;
-            ip_color = sgl_draw_biln_color(pbuf, pixmap->width, pixmap->height, fx, fy);
+            ip_color = circle_pixmap_sample(pixmap, fx, fy);
+            *blend = (alpha == SGL_ALPHA_MAX ? ip_color : sgl_color_mixer(ip_color, *blend, alpha));
+        }
 
-            if (dx2 >= r2_max) {
-                if(x > cx)
-                    break;
-                continue;
-            }
-            else if (dx2 >= r2) {
+        sgl_draw_circle_part(&clip, cx, j_in + 1, j_out, part);
+        for (int i = 0; i < 2; i++) {
+            blend = &buf[part[i].x1 - clip.x1];
+            for (int x = part[i].x1; x <= part[i].x2; x++, blend++) {
+                dx2 = sgl_pow2(2 * x - cx2) + dy2;
+                fx = (int32_t)(x - s_x) * scale_x;
+                ip_color = circle_pixmap_sample(pixmap, fx, fy);
                 edge_alpha = ((r2_max - dx2) * r2_fix_diff) >> SGL_FIXED_SHIFT;
                 *blend = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(ip_color, *blend, edge_alpha) : sgl_color_mixer(sgl_color_mixer(ip_color, *blend, edge_alpha), *blend, alpha));
             }
-            else {
-                *blend = (alpha == SGL_ALPHA_MAX ? ip_color : sgl_color_mixer(ip_color, *blend, alpha));
-            }
         }
-        buf += surf->w;
     }
 }
-#endif // CONFIG_SGL_PIXMAP_BILINEAR_INTERP
+
 
 /**
  * @brief Draw a circle with alpha and border
@@ -221,36 +202,58 @@ void sgl_draw_fill_circle_with_border(sgl_surf_t *surf, sgl_area_t *area, int16_
     uint8_t edge_alpha;
     sgl_color_t edge_c, *blend, *buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
     int dx2, dy2;
+    int16_t in = -1, in_edge = -1, border = -1, out = -1;
+    int16_t j_in, j_in_edge, j_border;
+    sgl_area_t span, part[2];
 
-    for (int y = clip.y1; y <= clip.y2; y++) {
-        blend = buf;
+    for (int y = clip.y1; y <= clip.y2; y++, buf += surf->w) {
         dy2 = sgl_pow2(2 * y - cy2);
+        out = sgl_draw_circle_half(out, out_r2_max, dy2);
+        if (out == 0) {
+            continue;
+        }
 
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            dx2 = sgl_pow2(2 * x - cx2) + dy2;
-            if (dx2 >= out_r2_max) {
-                if (x > cx) break;
-                continue;
-            }
-
-            if (dx2 <= in_r2) {
-                *blend = (alpha == SGL_ALPHA_MAX) ? color : sgl_color_mixer(color, *blend, alpha);
-            }
-            else if (dx2 < in_r2_max) {
+        /* the parts are inside, inner edge, border and outer edge, from the center to outside */
+        in = sgl_draw_circle_half(in, in_r2 + 1, dy2);
+        in_edge = sgl_draw_circle_half(in_edge, in_r2_max, dy2);
+        border = sgl_draw_circle_half(border, out_r2 + 1, dy2);
+        j_in = sgl_min(in, out);
+        j_in_edge = sgl_min(sgl_max(in_edge, j_in), out);
+        j_border = sgl_min(sgl_max(border, j_in_edge), out);
+
+        sgl_draw_circle_part(&clip, cx, 1, j_in, part);
+        span.x1 = part[0].x1;
+        span.x2 = part[1].x2;
+        span.y1 = span.y2 = y;
+        sgl_draw_ops_surf_area(surf, &span, color, alpha);
+
+        sgl_draw_circle_part(&clip, cx, j_in + 1, j_in_edge, part);
+        for (int i = 0; i < 2; i++) {
+            blend = &buf[part[i].x1 - clip.x1];
+            for (int x = part[i].x1; x <= part[i].x2; x++, blend++) {
+                dx2 = sgl_pow2(2 * x - cx2) + dy2;
                 edge_alpha = ((dx2 - in_r2) * in_fix) >> SGL_FIXED_SHIFT;
                 edge_c = sgl_color_mixer(border_color, color, edge_alpha);
                 *blend = (alpha == SGL_ALPHA_MAX) ? edge_c : sgl_color_mixer(edge_c, *blend, alpha);
             }
-            else if (dx2 <= out_r2) {
-                *blend = (alpha == SGL_ALPHA_MAX) ? border_color : sgl_color_mixer(border_color, *blend, alpha);
-            }
-            else {
+        }
+
+        sgl_draw_circle_part(&clip, cx, j_in_edge + 1, j_border, part);
+        for (int i = 0; i < 2; i++) {
+            part[i].y1 = part[i].y2 = y;
+            sgl_draw_ops_surf_area(surf, &part[i], border_color, alpha);
+        }
+
+        sgl_draw_circle_part(&clip, cx, j_border + 1, out, part);
+        for (int i = 0; i < 2; i++) {
+            blend = &buf[part[i].x1 - clip.x1];
+            for (int x = part[i].x1; x <= part[i].x2; x++, blend++) {
+                dx2 = sgl_pow2(2 * x - cx2) + dy2;
                 edge_alpha = ((out_r2_max - dx2) * out_fix) >> SGL_FIXED_SHIFT;
                 edge_c = sgl_color_mixer(border_color, *blend, edge_alpha);
                 *blend = (alpha == SGL_ALPHA_MAX) ? edge_c : sgl_color_mixer(edge_c, *blend, alpha);
             }
         }
-        buf += surf->w;
     }
 }
 
@@ -274,6 +277,13 @@ void sgl_draw_circle(sgl_surf_t *surf, sgl_area_t *area, sgl_draw_circle_t *desc
         return;
     }
 
+#if (CONFIG_SGL_DISPLAY_LIST)
+    if (unlikely(sgl_dlist_is_recording(surf))) {
+        sgl_dlist_circle(area, desc);
+        return;
+    }
+#endif
+
     if (desc->pixmap == NULL) {
         if (border) {
             sgl_draw_fill_circle_with_border(surf, area, desc->cx, desc->cy, radius, color, border_color, border, alpha);
@@ -0,0 +1,288 @@
+/* source/draw/sgl_draw_corner.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <sgl_core.h>
+#include <sgl_draw.h>
+#include <sgl_math.h>
+#include <sgl_mm.h>
+#include <string.h>
+
+
+/* number of tables that can be cached, the memory of them is limited by CONFIG_SGL_DRAW_CORNER_CACHE_SIZE */
+#define  SGL_DRAW_CORNER_ENTRY_NUM          (8)
+
+/* the edge pixels of a row are less than 2 * (sqrt(2 * radius + 1) + 1), that is less than 256 for radius 4095 */
+#define  SGL_DRAW_CORNER_ROW_COVER          (256)
+
+
+#if (CONFIG_SGL_DRAW_CORNER_CACHE_SIZE > 0)
+/**
+ * @brief cached corner table
+ * @radius: radius of corner
+ * @border: border width, -1 is a corner without border
+ * @stamp: last used stamp, the entry of the smallest stamp is evicted first
+ * @size: bytes of rows and coverage
+ * @row: rows of corner, the coverage follows them in the same memory
+ */
+typedef struct draw_corner_entry {
+    int16_t                 radius;
+    int16_t                 border;
+    uint32_t                stamp;
+    uint32_t                size;
+    sgl_draw_corner_row_t   *row;
+} draw_corner_entry_t;
+
+
+/**
+ * @brief corner cache, every draw thread has its own cache, so it is not locked
+ * @entry: cached tables
+ * @stamp: use counter
+ * @size: bytes of all of cached tables
+ */
+static sgl_thread_local struct {
+    draw_corner_entry_t     entry[SGL_DRAW_CORNER_ENTRY_NUM];
+    uint32_t                stamp;
+    uint32_t                size;
+} corner_cache;
+#endif
+
+
+/* coverage of the row that is not cached */
+static sgl_thread_local uint8_t corner_cover[SGL_DRAW_CORNER_ROW_COVER];
+
+
+/**
+ * @brief compute a row of corner
+ * @param radius radius of corner
+ * @param border border width, -1 is a corner without border
+ * @param dy distance to the center row of corner, 1 ~ radius
+ * @param row [out] pixel count of every part
+ * @param cover [out] coverage of edge pixels, inner edge first, then outer edge, can be NULL
+ * @return number of edge pixels
+ * @note the parts are the same as the per pixel math of sgl_draw_fill_rect() and
+ *       sgl_draw_fill_rect_with_border(), the pixel dx is inside if dx * dx + dy * dy is
+ *       less than radius * radius, and it is an edge pixel if it is less than (radius + 1) * (radius + 1)
+ */
+static uint16_t draw_corner_build_row(int16_t radius, int16_t border, int16_t dy, sgl_draw_corner_row_t *row, uint8_t *cover)
+{
+    const int dy2 = sgl_pow2(dy);
+    const int radius_in = border < 0 ? radius : sgl_max(radius - border, 0);
+    const int out_r2 = sgl_pow2(radius);
+    const int out_r2_max = sgl_pow2(radius + 1);
+    const int in_r2 = sgl_pow2(radius_in);
+    const int in_r2_max = sgl_pow2(radius_in + 1);
+    const int out_fix_diff = (SGL_ALPHA_MAX << SGL_FIXED_SHIFT) / sgl_max(out_r2_max - out_r2, 1);
+    const int in_fix_diff = (SGL_ALPHA_MAX << SGL_FIXED_SHIFT) / sgl_max(in_r2_max - in_r2, 1);
+    uint16_t num = 0;
+    int real_r2;
+    uint8_t alpha;
+
+    memset(row, 0, sizeof(sgl_draw_corner_row_t));
+
+    for (int dx = 1; ; dx++) {
+        real_r2 = sgl_pow2(dx) + dy2;
+
+        if (real_r2 >= out_r2_max) {
+            break;
+        }
+
+        if (border < 0) {
+            if (real_r2 >= out_r2) {
+                alpha = ((out_r2_max - real_r2) * out_fix_diff) >> SGL_FIXED_SHIFT;
+                row->out_edge ++;
+            }
+            else {
+                row->inside ++;
+                continue;
+            }
+        }
+        else if (real_r2 < in_r2) {
+            row->inside ++;
+            continue;
+        }
+        else if (real_r2 < in_r2_max) {
+            alpha = ((in_r2_max - real_r2) * in_fix_diff) >> SGL_FIXED_SHIFT;
+            row->in_edge ++;
+        }
+        else if (real_r2 <= out_r2) {
+            row->border ++;
+            continue;
+        }
+        else {
+            alpha = ((out_r2_max - real_r2) * out_fix_diff) >> SGL_FIXED_SHIFT;
+            row->out_edge ++;
+        }
+
+        if (cover != NULL && num < SGL_DRAW_CORNER_ROW_COVER) {
+            cover[num] = alpha;
+        }
+        num ++;
+    }
+
+    return num;
+}
+
+
+#if (CONFIG_SGL_DRAW_CORNER_CACHE_SIZE > 0)
+/**
+ * @brief find or build the cached table of corner
+ * @param radius radius of corner
+ * @param border border width, -1 is a corner without border
+ * @return cached entry, NULL if the table is larger than cache or memory is not enough
+ */
+static draw_corner_entry_t* draw_corner_cache_get(int16_t radius, int16_t border)
+{
+    draw_corner_entry_t *entry = NULL, *lru = NULL;
+    uint32_t covers = 0, size;
+    uint8_t *cover;
+
+    corner_cache.stamp ++;
+
+    for (int i = 0; i < SGL_DRAW_CORNER_ENTRY_NUM; i++) {
+        entry = &corner_cache.entry[i];
+        if (entry->row != NULL && entry->radius == radius && entry->border == border) {
+            entry->stamp = corner_cache.stamp;
+            return entry;
+        }
+    }
+
+    for (int16_t dy = 1; dy <= radius; dy++) {
+        sgl_draw_corner_row_t row;
+        covers += draw_corner_build_row(radius, border, dy, &row, NULL);
+    }
+
+    size = radius * sizeof(sgl_draw_corner_row_t) + covers;
+    if (size > CONFIG_SGL_DRAW_CORNER_CACHE_SIZE || covers > UINT16_MAX) {
+        return NULL;
+    }
+
+    /* evict the least recently used tables until there are a free entry and enough budget */
+    while (1) {
+        entry = NULL;
+        lru = NULL;
+        for (int i = 0; i < SGL_DRAW_CORNER_ENTRY_NUM; i++) {
+            if (corner_cache.entry[i].row == NULL) {
+                entry = &corner_cache.entry[i];
+            }
+            else if (lru == NULL || corner_cache.entry[i].stamp < lru->stamp) {
+                lru = &corner_cache.entry[i];
+            }
+        }
+
+        if (entry != NULL && corner_cache.size + size <= CONFIG_SGL_DRAW_CORNER_CACHE_SIZE) {
+            break;
+        }
+
+        corner_cache.size -= lru->size;
+        sgl_free(lru->row);
+        lru->row = NULL;
+    }
+
+    entry->row = sgl_malloc(size);
+    if (entry->row == NULL) {
+        return NULL;
+    }
+
+    cover = (uint8_t *)&entry->row[radius];
+    covers = 0;
+    for (int16_t dy = 1; dy <= radius; dy++) {
+        uint16_t num = draw_corner_build_row(radius, border, dy, &entry->row[dy - 1], &cover[covers]);
+        entry->row[dy - 1].cover = covers;
+        covers += num;
+    }
+
+    entry->radius = radius;
+    entry->border = border;
+    entry->stamp = corner_cache.stamp;
+    entry->size = size;
+    corner_cache.size += size;
+    return entry;
+}
+#endif
+
+
+/**
+ * @brief prepare the coverage of a corner of rounded rectangle
+ * @param corner [out] corner
+ * @param radius radius of corner
+ * @param border border width, -1 is a corner without border
+ * @return none
+ * @note the table of corner is cached by radius and border if it is not larger than CONFIG_SGL_DRAW_CORNER_CACHE_SIZE,
+ *       otherwise the rows are computed by sgl_draw_corner_get_row(), the corner is valid until next call in same thread
+ */
+void sgl_draw_corner_init(sgl_draw_corner_t *corner, int16_t radius, int16_t border)
+{
+    corner->radius = radius;
+    corner->border = border;
+    corner->row = NULL;
+    corner->cover = NULL;
+
+#if (CONFIG_SGL_DRAW_CORNER_CACHE_SIZE > 0)
+    draw_corner_entry_t *entry = draw_corner_cache_get(radius, border);
+    if (entry != NULL) {
+        corner->row = entry->row;
+        corner->cover = (const uint8_t *)&entry->row[radius];
+    }
+#endif
+}
+
+
+/**
+ * @brief get a row of corner
+ * @param corner corner that is prepared by sgl_draw_corner_init()
+ * @param dy distance to the center row of corner, 1 ~ radius
+ * @param row [out] pixel count of every part, from the center column of corner to outside
+ * @return coverage of edge pixels, inner edge first, then outer edge
+ */
+const uint8_t* sgl_draw_corner_get_row(const sgl_draw_corner_t *corner, int16_t dy, sgl_draw_corner_row_t *row)
+{
+    if (corner->row != NULL) {
+        *row = corner->row[dy - 1];
+        return &corner->cover[row->cover];
+    }
+
+    draw_corner_build_row(corner->radius, corner->border, dy, row, corner_cover);
+    return corner_cover;
+}
+
+
+/**
+ * @brief free the cached corner tables of the calling thread
+ * @param none
+ * @return none
+ * @note every draw thread has its own cache, so it is called by each of them before it exits
+ */
+void sgl_draw_corner_cache_free(void)
+{
+#if (CONFIG_SGL_DRAW_CORNER_CACHE_SIZE > 0)
+    for (int i = 0; i < SGL_DRAW_CORNER_ENTRY_NUM; i++) {
+        if (corner_cache.entry[i].row != NULL) {
+            sgl_free(corner_cache.entry[i].row);
+            corner_cache.entry[i].row = NULL;
+        }
+    }
+
+    corner_cache.size = 0;
+#endif
+}
@@ -0,0 +1,443 @@
+/* source/draw/sgl_draw_dlist.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <sgl_core.h>
+#include <sgl_draw.h>
+#include <sgl_math.h>
+#include <sgl_mm.h>
+#include <sgl_log.h>
+#include <string.h>
+
+#if (CONFIG_SGL_DISPLAY_LIST)
+
+
+/* the initial capacity of commands and entries, they grow by double */
+#define  SGL_DLIST_CMD_INIT                 (64)
+#define  SGL_DLIST_ENTRY_INIT               (16)
+
+
+/**
+ * @brief display list command type
+ */
+typedef enum sgl_dlist_type {
+    SGL_DLIST_RECT = 0,
+    SGL_DLIST_FILL_RECT,
+    SGL_DLIST_STRING,
+    SGL_DLIST_TEXT_LAYOUT,
+    SGL_DLIST_CIRCLE,
+    SGL_DLIST_FILL_RING,
+    SGL_DLIST_FILL_ARC,
+} sgl_dlist_type_t;
+
+
+/**
+ * @brief display list command, the arguments of draw function are copied
+ * @type: command type
+ * @area: clip area of draw function
+ * @bbox: bounding box of pixels that may be touched, it is used to skip command out of band
+ */
+typedef struct sgl_dlist_cmd {
+    uint8_t              type;
+    sgl_area_t           area;
+    sgl_area_t           bbox;
+    union {
+        struct {
+            sgl_rect_t       rect;
+            sgl_draw_rect_t  desc;
+        } rect;
+        struct {
+            sgl_area_t       rect;
+            int16_t          radius;
+            sgl_color_t      color;
+            uint8_t          alpha;
+        } fill_rect;
+        struct {
+            int16_t          x;
+            int16_t          y;
+            const char       *str;
+            sgl_color_t      color;
+            uint8_t          alpha;
+            const sgl_font_t *font;
+        } string;
+        struct {
+            int16_t          x;
+            int16_t          y;
+            const sgl_text_layout_t *layout;
+            sgl_color_t      color;
+            uint8_t          alpha;
+        } text;
+        struct {
+            int16_t          cx;
+            int16_t          cy;
+            int16_t          radius_in;
+            int16_t          radius_out;
+            sgl_color_t      color;
+            uint8_t          alpha;
+        } ring;
+        sgl_draw_circle_t    circle;
+        sgl_draw_arc_t       arc;
+    };
+} sgl_dlist_cmd_t;
+
+
+/**
+ * @brief commands of an object
+ * @obj: object that records the commands
+ * @first: index of first command
+ * @num: number of commands
+ * @valid: false if memory is not enough while recording, the object will be drawn directly
+ */
+typedef struct sgl_dlist_entry {
+    sgl_obj_t            *obj;
+    uint32_t             first;
+    uint32_t             num;
+    bool                 valid;
+} sgl_dlist_entry_t;
+
+
+/**
+ * @brief display list of current frame
+ * @cmd: command buffer
+ * @cmd_num: number of commands
+ * @cmd_cap: capacity of command buffer
+ * @entry: entry buffer
+ * @entry_num: number of entries
+ * @entry_cap: capacity of entry buffer
+ */
+static struct {
+    sgl_dlist_cmd_t      *cmd;
+    uint32_t             cmd_num;
+    uint32_t             cmd_cap;
+    sgl_dlist_entry_t    *entry;
+    uint32_t             entry_num;
+    uint32_t             entry_cap;
+} dlist;
+
+
+/* the recording surface, draw functions append commands instead of drawing into it */
+sgl_surf_t sgl_dlist_surf;
+
+
+/**
+ * @brief append a command to the entry that is being recorded
+ * @param area clip area of draw function
+ * @param bbox bounding box of the command, it will be clipped by area
+ * @return pointer to the command, NULL if it is out of area or memory is not enough
+ */
+static sgl_dlist_cmd_t* sgl_dlist_push(sgl_area_t *area, sgl_area_t *bbox)
+{
+    sgl_dlist_entry_t *entry = &dlist.entry[dlist.entry_num - 1];
+    sgl_dlist_cmd_t *cmd = NULL;
+
+    if (!entry->valid || !sgl_area_selfclip(bbox, area)) {
+        return NULL;
+    }
+
+    if (dlist.cmd_num == dlist.cmd_cap) {
+        uint32_t cap = dlist.cmd_cap ? dlist.cmd_cap * 2 : SGL_DLIST_CMD_INIT;
+        cmd = (sgl_dlist_cmd_t*)sgl_realloc(dlist.cmd, cap * sizeof(sgl_dlist_cmd_t));
+        if (cmd == NULL) {
+            SGL_LOG_WARN("sgl_dlist_push: out of memory, draw object directly");
+            entry->valid = false;
+            return NULL;
+        }
+        dlist.cmd = cmd;
+        dlist.cmd_cap = cap;
+    }
+
+    cmd = &dlist.cmd[dlist.cmd_num ++];
+    cmd->area = *area;
+    cmd->bbox = *bbox;
+    entry->num ++;
+
+    return cmd;
+}
+
+
+/**
+ * @brief reset display list, all of the commands of last frame are dropped
+ * @param none
+ * @return none
+ * @note the memory is kept for next frame
+ */
+void sgl_dlist_reset(void)
+{
+    dlist.cmd_num = 0;
+    dlist.entry_num = 0;
+
+    sgl_dlist_surf.x1 = 0;
+    sgl_dlist_surf.y1 = 0;
+    sgl_dlist_surf.x2 = SGL_POS_MAX;
+    sgl_dlist_surf.y2 = SGL_POS_MAX;
+    sgl_dlist_surf.w = SGL_POS_MAX;
+    sgl_dlist_surf.h = SGL_POS_MAX;
+    sgl_dlist_surf.buffer = NULL;
+    sgl_dlist_surf.size = 0;
+    sgl_dlist_surf.dirty = (sgl_area_t*)&sgl_dlist_surf;
+}
+
+
+/**
+ * @brief start to record the commands of an object
+ * @param obj object
+ * @return the recording surface, it should be passed to construct function of object,
+ *         NULL if memory is not enough
+ */
+sgl_surf_t* sgl_dlist_record(sgl_obj_t *obj)
+{
+    sgl_dlist_entry_t *entry = NULL;
+
+    if (dlist.entry_num == dlist.entry_cap) {
+        uint32_t cap = dlist.entry_cap ? dlist.entry_cap * 2 : SGL_DLIST_ENTRY_INIT;
+        entry = (sgl_dlist_entry_t*)sgl_realloc(dlist.entry, cap * sizeof(sgl_dlist_entry_t));
+        if (entry == NULL) {
+            SGL_LOG_WARN("sgl_dlist_record: out of memory, draw object directly");
+            return NULL;
+        }
+        dlist.entry = entry;
+        dlist.entry_cap = cap;
+    }
+
+    entry = &dlist.entry[dlist.entry_num ++];
+    entry->obj = obj;
+    entry->first = dlist.cmd_num;
+    entry->num = 0;
+    entry->valid = true;
+
+    return &sgl_dlist_surf;
+}
+
+
+/**
+ * @brief replay the commands of an object into a band
+ * @param obj object
+ * @param surf surface of band
+ * @param cursor [in][out] the entry that the search starts from, entries are recorded in draw order
+ * @return true if the object is drawn, false if it is not recorded and should be drawn directly
+ */
+bool sgl_dlist_replay(sgl_obj_t *obj, sgl_surf_t *surf, uint32_t *cursor)
+{
+    sgl_dlist_entry_t *entry = NULL;
+    sgl_dlist_cmd_t *cmd = NULL;
+    uint32_t i = *cursor;
+
+    while (i < dlist.entry_num && dlist.entry[i].obj != obj) {
+        i ++;
+    }
+
+    if (i == dlist.entry_num || !dlist.entry[i].valid) {
+        return false;
+    }
+
+    *cursor = i + 1;
+    entry = &dlist.entry[i];
+
+    for (i = 0; i < entry->num; i++) {
+        cmd = &dlist.cmd[entry->first + i];
+
+        if (!sgl_surf_area_is_overlap(surf, &cmd->bbox)) {
+            continue;
+        }
+
+        switch (cmd->type) {
+        case SGL_DLIST_RECT:
+            sgl_draw_rect(surf, &cmd->area, &cmd->rect.rect, &cmd->rect.desc);
+            break;
+        case SGL_DLIST_FILL_RECT:
+            sgl_draw_fill_rect(surf, &cmd->area, &cmd->fill_rect.rect, cmd->fill_rect.radius, cmd->fill_rect.color, cmd->fill_rect.alpha);
+            break;
+        case SGL_DLIST_STRING:
+            sgl_draw_string(surf, &cmd->area, cmd->string.x, cmd->string.y, cmd->string.str, cmd->string.color, cmd->string.alpha, cmd->string.font);
+            break;
+        case SGL_DLIST_TEXT_LAYOUT:
+            sgl_draw_text_layout(surf, &cmd->area, cmd->text.x, cmd->text.y, cmd->text.layout, cmd->text.color, cmd->text.alpha);
+            break;
+        case SGL_DLIST_CIRCLE:
+            sgl_draw_circle(surf, &cmd->area, &cmd->circle);
+            break;
+        case SGL_DLIST_FILL_RING:
+            sgl_draw_fill_ring(surf, &cmd->area, cmd->ring.cx, cmd->ring.cy, cmd->ring.radius_in, cmd->ring.radius_out, cmd->ring.color, cmd->ring.alpha);
+            break;
+        case SGL_DLIST_FILL_ARC:
+            sgl_draw_fill_arc(surf, &cmd->area, &cmd->arc);
+            break;
+        default:
+            SGL_LOG_WARN("sgl_dlist_replay: invalid command type %d", cmd->type);
+            break;
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief record sgl_draw_rect()
+ */
+void sgl_dlist_rect(sgl_area_t *area, sgl_rect_t *rect, sgl_draw_rect_t *desc)
+{
+    sgl_area_t bbox = *rect;
+    sgl_dlist_cmd_t *cmd = sgl_dlist_push(area, &bbox);
+
+    if (cmd != NULL) {
+        cmd->type = SGL_DLIST_RECT;
+        cmd->rect.rect = *rect;
+        cmd->rect.desc = *desc;
+    }
+}
+
+
+/**
+ * @brief record sgl_draw_fill_rect()
+ */
+void sgl_dlist_fill_rect(sgl_area_t *area, sgl_area_t *rect, int16_t radius, sgl_color_t color, uint8_t alpha)
+{
+    sgl_area_t bbox = *rect;
+    sgl_dlist_cmd_t *cmd = sgl_dlist_push(area, &bbox);
+
+    if (cmd != NULL) {
+        cmd->type = SGL_DLIST_FILL_RECT;
+        cmd->fill_rect.rect = *rect;
+        cmd->fill_rect.radius = radius;
+        cmd->fill_rect.color = color;
+        cmd->fill_rect.alpha = alpha;
+    }
+}
+
+
+/**
+ * @brief record sgl_draw_string(), the string is not copied, it must be alive until the frame is finished
+ */
+void sgl_dlist_string(sgl_area_t *area, int16_t x, int16_t y, const char *str, sgl_color_t color, uint8_t alpha, const sgl_font_t *font)
+{
+    sgl_area_t bbox = {
+        .x1 = SGL_POS_MIN,
+        .y1 = y,
+        .x2 = SGL_POS_MAX,
+        .y2 = y + font->font_height - 1,
+    };
+    sgl_dlist_cmd_t *cmd = sgl_dlist_push(area, &bbox);
+
+    if (cmd != NULL) {
+        cmd->type = SGL_DLIST_STRING;
+        cmd->string.x = x;
+        cmd->string.y = y;
+        cmd->string.str = str;
+        cmd->string.color = color;
+        cmd->string.alpha = alpha;
+        cmd->string.font = font;
+    }
+}
+
+
+/**
+ * @brief record sgl_draw_text_layout(), the layout is not copied, it must not be updated until the frame is finished
+ */
+void sgl_dlist_text_layout(sgl_area_t *area, int16_t x, int16_t y, const sgl_text_layout_t *layout, sgl_color_t color, uint8_t alpha)
+{
+    sgl_area_t bbox = {
+        .x1 = SGL_POS_MIN,
+        .y1 = y,
+        .x2 = SGL_POS_MAX,
+        .y2 = y + layout->font->font_height - 1,
+    };
+    sgl_dlist_cmd_t *cmd = sgl_dlist_push(area, &bbox);
+
+    if (cmd != NULL) {
+        cmd->type = SGL_DLIST_TEXT_LAYOUT;
+        cmd->text.x = x;
+        cmd->text.y = y;
+        cmd->text.layout = layout;
+        cmd->text.color = color;
+        cmd->text.alpha = alpha;
+    }
+}
+
+
+/**
+ * @brief record sgl_draw_circle()
+ */
+void sgl_dlist_circle(sgl_area_t *area, sgl_draw_circle_t *desc)
+{
+    sgl_area_t bbox = {
+        .x1 = desc->cx - desc->radius,
+        .y1 = desc->cy - desc->radius,
+        .x2 = desc->cx + desc->radius,
+        .y2 = desc->cy + desc->radius,
+    };
+    sgl_dlist_cmd_t *cmd = sgl_dlist_push(area, &bbox);
+
+    if (cmd != NULL) {
+        cmd->type = SGL_DLIST_CIRCLE;
+        cmd->circle = *desc;
+    }
+}
+
+
+/**
+ * @brief record sgl_draw_fill_ring()
+ */
+void sgl_dlist_fill_ring(sgl_area_t *area, int16_t cx, int16_t cy, int16_t radius_in, int16_t radius_out, sgl_color_t color, uint8_t alpha)
+{
+    sgl_area_t bbox = {
+        .x1 = cx - radius_out,
+        .y1 = cy - radius_out,
+        .x2 = cx + radius_out,
+        .y2 = cy + radius_out,
+    };
+    sgl_dlist_cmd_t *cmd = sgl_dlist_push(area, &bbox);
+
+    if (cmd != NULL) {
+        cmd->type = SGL_DLIST_FILL_RING;
+        cmd->ring.cx = cx;
+        cmd->ring.cy = cy;
+        cmd->ring.radius_in = radius_in;
+        cmd->ring.radius_out = radius_out;
+        cmd->ring.color = color;
+        cmd->ring.alpha = alpha;
+    }
+}
+
+
+/**
+ * @brief record sgl_draw_fill_arc()
+ */
+void sgl_dlist_fill_arc(sgl_area_t *area, sgl_draw_arc_t *desc)
+{
+    sgl_area_t bbox = {
+        .x1 = desc->cx - desc->radius_out,
+        .y1 = desc->cy - desc->radius_out,
+        .x2 = desc->cx + desc->radius_out,
+        .y2 = desc->cy + desc->radius_out,
+    };
+    sgl_dlist_cmd_t *cmd = sgl_dlist_push(area, &bbox);
+
+    if (cmd != NULL) {
+        cmd->type = SGL_DLIST_FILL_ARC;
+        cmd->arc = *desc;
+    }
+}
+
+#endif // !CONFIG_SGL_DISPLAY_LIST
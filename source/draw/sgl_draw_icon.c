@@ -43,8 +43,7 @@ void sgl_draw_icon( sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, sg
     const uint8_t *dot = icon->bitmap;
     sgl_area_t clip = SGL_AREA_MAX;
     sgl_color_t *buf = NULL;
-    int rel_x, rel_y, byte_x, dot_index;
-    uint8_t alpha_dot;
+    uint32_t dot_index;
 
     sgl_area_t icon_rect = {
         .x1 = x,
@@ -61,19 +60,10 @@ void sgl_draw_icon( sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, sg
         return;
     }
 
+    /* a row of icon is (width / 2) bytes, the mask index of row is counted by the bytes */
     for (int y = clip.y1; y <= clip.y2; y++) {
         buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, y - surf->y1);
-        rel_y = y - icon_rect.y1;
-
-        for (int x = clip.x1; x <= clip.x2; x++) {
-            rel_x = x - icon_rect.x1;
-
-            byte_x = rel_x >> 1;
-            dot_index = byte_x + (rel_y * (icon->width >> 1));
-            alpha_dot = (rel_x & 1) ? dot[dot_index] & 0xF : (dot[dot_index] >> 4);
-            alpha_dot = alpha_dot | (alpha_dot << 4);
-            *buf = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(color, *buf, alpha_dot) : sgl_color_mixer(sgl_color_mixer(color, *buf, alpha_dot), *buf, alpha));
-            buf++;
-        }
+        dot_index = (y - icon_rect.y1) * ((icon->width >> 1) << 1) + (clip.x1 - icon_rect.x1);
+        sgl_draw_ops.mask(buf, dot, dot_index, clip.x2 - clip.x1 + 1, 4, color, alpha);
     }
 }
@@ -0,0 +1,246 @@
+/* source/draw/sgl_draw_img_cache.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <sgl_core.h>
+#include <sgl_draw.h>
+#include <sgl_mm.h>
+#include <sgl_log.h>
+#include <string.h>
+
+#if (CONFIG_SGL_IMG_CACHE_SIZE > 0)
+
+
+/**
+ * @brief decoded image cache, it is only used by the main thread, so it is not locked
+ * @head: most recently used entry
+ * @size: bytes of all of entries
+ * @stats: hit, miss and eviction counters
+ */
+static struct {
+    sgl_img_cache_entry_t  *head;
+    uint32_t               size;
+    sgl_img_cache_stats_t  stats;
+} img_cache;
+
+
+/**
+ * @brief unlink an entry from image cache and free it
+ * @param link the link that points to the entry
+ * @return none
+ */
+static void img_cache_free(sgl_img_cache_entry_t **link)
+{
+    sgl_img_cache_entry_t *entry = *link;
+
+    *link = entry->next;
+    img_cache.size -= entry->size;
+    img_cache.stats.entries --;
+    sgl_free(entry);
+}
+
+
+/**
+ * @brief evict the least recently used entry that is not in use
+ * @param none
+ * @return true if an entry is evicted, false if all of entries are in use
+ */
+static bool img_cache_evict(void)
+{
+    sgl_img_cache_entry_t **link = &img_cache.head, **lru = NULL;
+
+    while (*link != NULL) {
+        if ((*link)->refs == 0) {
+            lru = link;
+        }
+        link = &(*link)->next;
+    }
+
+    if (lru == NULL) {
+        return false;
+    }
+
+    img_cache_free(lru);
+    img_cache.stats.evictions ++;
+    return true;
+}
+
+
+/**
+ * @brief find a decoded image in image cache and use it
+ * @param src pixmap identity
+ * @param frame frame index of pixmap
+ * @return entry of image, NULL if it is not cached
+ * @note the cache is not locked, it must be used out of draw threads, such as in SGL_EVENT_DRAW_INIT,
+ *       the found entry must be released by sgl_img_cache_release()
+ */
+sgl_img_cache_entry_t* sgl_img_cache_find(const void *src, uint32_t frame)
+{
+    sgl_img_cache_entry_t **link = &img_cache.head, *entry;
+
+    while ((entry = *link) != NULL) {
+        if (entry->src == src && entry->frame == frame && src != NULL) {
+            /* move it to the head, the tail is the least recently used one */
+            *link = entry->next;
+            entry->next = img_cache.head;
+            img_cache.head = entry;
+            entry->refs ++;
+            img_cache.stats.hits ++;
+            return entry;
+        }
+        link = &entry->next;
+    }
+
+    img_cache.stats.misses ++;
+    return NULL;
+}
+
+
+/**
+ * @brief allocate an entry for a decoded image and use it
+ * @param src pixmap identity
+ * @param frame frame index of pixmap
+ * @param width width of image
+ * @param height height of image
+ * @param alpha true if the image has pixel alpha
+ * @return entry of image, the caller decodes the image into it, NULL if the image is larger than
+ *         cache, the images in use fill the cache or memory is not enough
+ * @note the least recently used images that are not in use are evicted until the image fits in
+ *       CONFIG_SGL_IMG_CACHE_SIZE, the entry must be released by sgl_img_cache_release()
+ */
+sgl_img_cache_entry_t* sgl_img_cache_alloc(const void *src, uint32_t frame, uint16_t width, uint16_t height, bool alpha)
+{
+    const uint64_t pixels = (uint64_t)width * height;
+    const uint64_t size = sizeof(sgl_img_cache_entry_t) + pixels * (sizeof(sgl_color_t) + (alpha ? 1 : 0));
+    sgl_img_cache_entry_t *entry = NULL;
+
+    if (src == NULL || pixels == 0 || size > CONFIG_SGL_IMG_CACHE_SIZE) {
+        return NULL;
+    }
+
+    while (img_cache.size + size > CONFIG_SGL_IMG_CACHE_SIZE) {
+        if (!img_cache_evict()) {
+            return NULL;
+        }
+    }
+
+    entry = (sgl_img_cache_entry_t*)sgl_malloc((size_t)size);
+    if (entry == NULL) {
+        SGL_LOG_WARN("sgl_img_cache_alloc: out of memory, the image is not cached");
+        return NULL;
+    }
+
+    /* the colors and the alpha follow the entry in the same memory */
+    entry->src = src;
+    entry->frame = frame;
+    entry->size = (uint32_t)size;
+    entry->width = width;
+    entry->height = height;
+    entry->refs = 1;
+    entry->color = (sgl_color_t*)(entry + 1);
+    entry->alpha = alpha ? (uint8_t*)(entry->color + pixels) : NULL;
+
+    entry->next = img_cache.head;
+    img_cache.head = entry;
+    img_cache.size += entry->size;
+    img_cache.stats.entries ++;
+    return entry;
+}
+
+
+/**
+ * @brief stop using an entry of image cache
+ * @param entry entry of image
+ * @return none
+ * @note the entry stays in cache until it is evicted, so the image can be found again
+ */
+void sgl_img_cache_release(sgl_img_cache_entry_t *entry)
+{
+    sgl_img_cache_entry_t **link = &img_cache.head;
+
+    SGL_ASSERT(entry != NULL && entry->refs > 0);
+    entry->refs --;
+
+    /* the dropped entry is freed by its last user */
+    if (entry->refs > 0 || entry->src != NULL) {
+        return;
+    }
+
+    while (*link != entry) {
+        link = &(*link)->next;
+    }
+    img_cache_free(link);
+}
+
+
+/**
+ * @brief drop the images of a pixmap from image cache, for example its data is rewritten
+ * @param src pixmap identity, NULL drops all of the images
+ * @return none
+ * @note the entry in use is not found any more, it is freed when it is released
+ */
+void sgl_img_cache_drop(const void *src)
+{
+    sgl_img_cache_entry_t **link = &img_cache.head;
+
+    while (*link != NULL) {
+        if (src == NULL || (*link)->src == src) {
+            (*link)->src = NULL;
+            if ((*link)->refs == 0) {
+                img_cache_free(link);
+                continue;
+            }
+        }
+        link = &(*link)->next;
+    }
+}
+
+
+/**
+ * @brief get the statistics of image cache
+ * @param stats [out] statistics
+ * @return none
+ */
+void sgl_img_cache_get_stats(sgl_img_cache_stats_t *stats)
+{
+    SGL_ASSERT(stats != NULL);
+    *stats = img_cache.stats;
+    stats->size = img_cache.size;
+}
+
+
+/**
+ * @brief reset the hit, miss and eviction counters of image cache
+ * @param none
+ * @return none
+ */
+void sgl_img_cache_reset_stats(void)
+{
+    img_cache.stats.hits = 0;
+    img_cache.stats.misses = 0;
+    img_cache.stats.evictions = 0;
+}
+
+
+#endif // !CONFIG_SGL_IMG_CACHE_SIZE
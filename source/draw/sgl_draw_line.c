@@ -40,7 +40,6 @@
  */
 void sgl_draw_fill_hline(sgl_surf_t *surf, sgl_area_t *area, int16_t y, int16_t x1, int16_t x2, uint8_t width, sgl_color_t color, uint8_t alpha)
 {
-    sgl_color_t *buf = NULL, *blend = NULL;
     sgl_area_t c_rect = {.x1 = x1, .x2 = x2, .y1 = y - (width - 1) / 2, .y2 = y + width / 2}, clip = SGL_AREA_MAX;
 
     if (c_rect.x1 > c_rect.x2) {
@@ -52,14 +51,7 @@ void sgl_draw_fill_hline(sgl_surf_t *surf, sgl_area_t *area, int16_t y, int16_t
         return;
     }
 
-    buf = sgl_surf_get_buf(surf,  clip.x1 - surf->x1, clip.y1 - surf->y1);
-    for (int y = clip.y1; y <= clip.y2; y++) {
-        blend = buf;
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            *blend = alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha);
-        }
-        buf += surf->w;
-    }
+    sgl_draw_ops_surf_area(surf, &clip, color, alpha);
 }
 
 
@@ -76,7 +68,6 @@ void sgl_draw_fill_hline(sgl_surf_t *surf, sgl_area_t *area, int16_t y, int16_t
  */
 void sgl_draw_fill_vline(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y1, int16_t y2, uint8_t width, sgl_color_t color, uint8_t alpha)
 {
-    sgl_color_t *buf = NULL, *blend = NULL;
     sgl_area_t c_rect = {.x1 = x - (width - 1) / 2, .x2 = x + width / 2, .y1 = y1,.y2 = y2}, clip = SGL_AREA_MAX;
 
     if (c_rect.y1 > c_rect.y2) {
@@ -88,13 +79,52 @@ void sgl_draw_fill_vline(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t
         return;
     }
 
-    buf = sgl_surf_get_buf(surf,  clip.x1 - surf->x1, clip.y1 - surf->y1);
-    for (int y = clip.y1; y <= clip.y2; y++) {
-        blend = buf;
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            *blend = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha));
-        }
-        buf += surf->w;
+    sgl_draw_ops_surf_area(surf, &clip, color, alpha);
+}
+
+
+/**
+ * @brief distance from pixel to the line segment, in 1/256 pixel
+ * @param pax pixel x relative to line start
+ * @param pay pixel y relative to line start
+ * @param bax line x direction
+ * @param bay line y direction
+ * @param b_sqd squared line length
+ * @param inv_b_sqd (1 << 32) / b_sqd
+ * @return distance with 8 bits fraction
+ */
+static inline int32_t draw_line_sdf(int64_t pax, int64_t pay, int64_t bax, int64_t bay, int64_t b_sqd, int64_t inv_b_sqd)
+{
+    int64_t dot = pax * bax + pay * bay;
+
+    if (dot < 0)
+        dot = 0;
+    else if (dot > b_sqd)
+        dot = b_sqd;
+
+    const int64_t h = dot << 8;
+    const int64_t dx = (pax << 8) - ((bax * h * inv_b_sqd) >> 32);
+    const int64_t dy = (pay << 8) - ((bay * h * inv_b_sqd) >> 32);
+
+    return sgl_sqrt(dx * dx + dy * dy);
+}
+
+
+/**
+ * @brief blend an anti-aliased edge pixel of slanted line
+ * @param blend pixel to blend
+ * @param c edge coverage, 0 ~ 255
+ * @param color line color
+ * @param alpha alpha of color
+ * @return none
+ */
+static inline void draw_line_edge_pixel(sgl_color_t *blend, uint8_t c, sgl_color_t color, uint8_t alpha)
+{
+    if (alpha == SGL_ALPHA_MAX) {
+        *blend = sgl_color_mixer(*blend, color, c);
+    } else {
+        uint8_t final_a = (uint8_t)(((uint16_t)c * alpha) >> 8);
+        *blend = sgl_color_mixer(color, *blend, final_a);
     }
 }
 
@@ -111,7 +141,9 @@ void sgl_draw_fill_vline(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t
  * @param color line color
  * @param alpha alpha of color
  * @return none
- * @note This algorithm is SDF algorithm
+ * @note This algorithm is SDF algorithm, every row is limited to the strip of the line, the
+ *       distance is only evaluated from both ends of the row until the first solid pixel,
+ *       the solid span between them is filled by draw ops
  */
 void draw_line_fill_slanted(sgl_surf_t *surf, sgl_area_t *area, int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t thickness, sgl_color_t color, uint8_t alpha)
 {
@@ -121,6 +153,8 @@ void draw_line_fill_slanted(sgl_surf_t *surf, sgl_area_t *area, int16_t x1, int1
     const int16_t thick_half = (thickness >> 2);
     const int32_t inner_limit = (thick_half - 1) << 8;
     const int32_t outer_limit = thick_half << 8;
+    const int64_t abs_bax = bax < 0 ? -bax : bax, abs_bay = bay < 0 ? -bay : bay;
+    int64_t strip = 0, len_max;
 
     sgl_area_t clip = SGL_AREA_MAX;
     sgl_area_t c_rect = {
@@ -130,44 +164,58 @@ void draw_line_fill_slanted(sgl_surf_t *surf, sgl_area_t *area, int16_t x1, int1
         .y2 = (y1 > y2 ? y1 : y2) + thick_half,
     };
 
+    if (thick_half <= 0) return;
+
     sgl_surf_clip_area_return(surf, area, &clip);
     if (!sgl_area_selfclip(&clip, &c_rect)) return;
 
+    /* half width of the strip along x, the fixed point projection error grows with the length
+     * of line, so the radius is widened by it and one more pixel for rounding */
+    if (bay != 0) {
+        len_max = (b_sqd <= UINT32_MAX) ? (int64_t)sgl_sqrt((uint32_t)b_sqd) + 1 : abs_bax + abs_bay;
+        strip = (thick_half + 2 + (((abs_bax + abs_bay) * b_sqd) >> 32)) * len_max;
+        strip = (strip + abs_bay - 1) / abs_bay + 1;
+    }
+
     sgl_color_t *buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
     const int32_t stride = surf->w;
 
-    for (int y = clip.y1; y <= clip.y2; y++) {
-        sgl_color_t *blend = buf;
+    for (int y = clip.y1; y <= clip.y2; y++, buf += stride) {
         const int64_t pay = (int64_t)y - y1;
-        
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            const int64_t pax = (int64_t)x - x1;
-            int64_t dot = pax * bax + pay * bay;
+        int32_t lo = clip.x1, hi = clip.x2, sa, sb, len;
+
+        if (bay != 0) {
+            const int64_t xc = x1 + (bax * pay) / bay;
+            lo = sgl_max(lo, xc - strip);
+            hi = sgl_min(hi, xc + strip);
+        }
 
-            if (dot < 0)
-                dot = 0; 
-            else if (dot > b_sqd)
-                dot = b_sqd;
+        for (sa = lo; sa <= hi; sa++) {
+            len = draw_line_sdf((int64_t)sa - x1, pay, bax, bay, b_sqd, inv_b_sqd);
+            if (len < inner_limit) {
+                break;
+            }
+            else if (len < outer_limit) {
+                draw_line_edge_pixel(&buf[sa - clip.x1], (uint8_t)(len - inner_limit), color, alpha);
+            }
+        }
 
-            const int64_t h = dot << 8; 
-            const int64_t dx = (pax << 8) - ((bax * h * inv_b_sqd) >> 32);
-            const int64_t dy = (pay << 8) - ((bay * h * inv_b_sqd) >> 32);
-            const int32_t len = sgl_sqrt(dx * dx + dy * dy);
+        if (sa > hi) {
+            continue;
+        }
 
+        for (sb = hi; sb > sa; sb--) {
+            len = draw_line_sdf((int64_t)sb - x1, pay, bax, bay, b_sqd, inv_b_sqd);
             if (len < inner_limit) {
-                *blend = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha));
+                break;
             }
             else if (len < outer_limit) {
-                const uint8_t c = (uint8_t)(len - inner_limit);
-                if (alpha == SGL_ALPHA_MAX) {
-                    *blend = sgl_color_mixer(*blend, color, c);
-                } else {
-                    uint8_t final_a = (uint8_t)(((uint16_t)c * alpha) >> 8);
-                    *blend = sgl_color_mixer(color, *blend, final_a);
-                }
+                draw_line_edge_pixel(&buf[sb - clip.x1], (uint8_t)(len - inner_limit), color, alpha);
             }
         }
-        buf += stride;
+
+        sgl_area_t span = { .x1 = sa, .y1 = y, .x2 = sb, .y2 = y };
+        sgl_draw_ops_surf_area(surf, &span, color, alpha);
     }
 }
 
@@ -0,0 +1,575 @@
+/* source/draw/sgl_draw_ops.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <sgl_core.h>
+#include <sgl_draw.h>
+#include <string.h>
+
+#if (CONFIG_SGL_DRAW_SIMD) && defined(__SSE2__)
+#include <emmintrin.h>
+#define  SGL_DRAW_SSE2                      (1)
+#elif (CONFIG_SGL_DRAW_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#define  SGL_DRAW_NEON                      (1)
+#endif
+
+
+/**
+ * the current draw operations, every entry is valid, the software implementation is default
+ */
+sgl_draw_ops_t sgl_draw_ops = {
+    .fill  = sgl_draw_soft_fill,
+    .blend = sgl_draw_soft_blend,
+    .copy  = sgl_draw_soft_copy,
+    .mask  = sgl_draw_soft_mask,
+};
+
+
+/**
+ * @brief fill a span with color
+ * @param dst destination
+ * @param len number of pixels
+ * @param color fill color
+ * @return none
+ * @note 16 and 32 bits pixels are stored by 128 bits vector with SSE2 or NEON, without them
+ *       RGB565 pixels are stored two pixels per word
+ */
+static inline void draw_span_fill(sgl_color_t *dst, int32_t len, sgl_color_t color)
+{
+#if (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_RGB565 || CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_ARGB8888)
+#if (SGL_DRAW_SSE2)
+#if (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_RGB565)
+    const __m128i v = _mm_set1_epi16((short)color.full);
+#else
+    const __m128i v = _mm_set1_epi32((int)color.full);
+#endif
+    const int32_t n = 16 / sizeof(sgl_color_t);
+
+    for (; len >= n; len -= n, dst += n) {
+        _mm_storeu_si128((__m128i *)dst, v);
+    }
+#elif (SGL_DRAW_NEON)
+#if (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_RGB565)
+    const uint16x8_t v = vdupq_n_u16(color.full);
+
+    for (; len >= 8; len -= 8, dst += 8) {
+        vst1q_u16((uint16_t *)dst, v);
+    }
+#else
+    const uint32x4_t v = vdupq_n_u32(color.full);
+
+    for (; len >= 4; len -= 4, dst += 4) {
+        vst1q_u32((uint32_t *)dst, v);
+    }
+#endif
+#elif (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_RGB565)
+    const uint32_t pair = (uint32_t)color.full | ((uint32_t)color.full << 16);
+
+    if (len > 0 && ((uintptr_t)dst & 0x2)) {
+        *dst++ = color;
+        len--;
+    }
+
+    for (; len >= 2; len -= 2, dst += 2) {
+        memcpy(dst, &pair, sizeof(pair));
+    }
+#endif
+#endif
+    sgl_color_set(dst, color, len);
+}
+
+
+/**
+ * @brief blend color into a span with alpha
+ * @param dst destination
+ * @param len number of pixels
+ * @param color blend color
+ * @param alpha alpha of color
+ * @return none
+ * @note every pixel is the same as sgl_color_mixer(color, pixel, alpha), the channels are
+ *       computed as (bg * (max - a) + fg * a) >> shift, that is the same as bg + (fg - bg) * a >> shift,
+ *       so the foreground part is computed once for the span
+ */
+static inline void draw_span_blend(sgl_color_t *dst, int32_t len, sgl_color_t color, uint8_t alpha)
+{
+#if (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_RGB565)
+    const uint16_t f = ((uint16_t)alpha + 4) >> 3;
+    SGL_PERF_ADD(blend, len);
+
+#if (SGL_DRAW_SSE2)
+    const __m128i inv = _mm_set1_epi16(32 - f);
+    const __m128i mask6 = _mm_set1_epi16(0x3F), mask5 = _mm_set1_epi16(0x1F);
+    const __m128i fr = _mm_set1_epi16(color.ch.red * f);
+    const __m128i fg = _mm_set1_epi16(color.ch.green * f);
+    const __m128i fb = _mm_set1_epi16(color.ch.blue * f);
+    __m128i p, r, g, b;
+
+    for (; len >= 8; len -= 8, dst += 8) {
+        p = _mm_loadu_si128((const __m128i *)dst);
+        r = _mm_srli_epi16(p, 11);
+        g = _mm_and_si128(_mm_srli_epi16(p, 5), mask6);
+        b = _mm_and_si128(p, mask5);
+        r = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(r, inv), fr), 5);
+        g = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(g, inv), fg), 5);
+        b = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(b, inv), fb), 5);
+        p = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b);
+        _mm_storeu_si128((__m128i *)dst, p);
+    }
+#elif (SGL_DRAW_NEON)
+    const uint16x8_t inv = vdupq_n_u16(32 - f);
+    const uint16x8_t mask6 = vdupq_n_u16(0x3F), mask5 = vdupq_n_u16(0x1F);
+    const uint16x8_t fr = vdupq_n_u16(color.ch.red * f);
+    const uint16x8_t fg = vdupq_n_u16(color.ch.green * f);
+    const uint16x8_t fb = vdupq_n_u16(color.ch.blue * f);
+    uint16x8_t p, r, g, b;
+
+    for (; len >= 8; len -= 8, dst += 8) {
+        p = vld1q_u16((const uint16_t *)dst);
+        r = vshrq_n_u16(p, 11);
+        g = vandq_u16(vshrq_n_u16(p, 5), mask6);
+        b = vandq_u16(p, mask5);
+        r = vshrq_n_u16(vmlaq_u16(fr, r, inv), 5);
+        g = vshrq_n_u16(vmlaq_u16(fg, g, inv), 5);
+        b = vshrq_n_u16(vmlaq_u16(fb, b, inv), 5);
+        p = vorrq_u16(vorrq_u16(vshlq_n_u16(r, 11), vshlq_n_u16(g, 5)), b);
+        vst1q_u16((uint16_t *)dst, p);
+    }
+#endif
+
+    /* two pixels per word, every pixel is spread to 0x07E0F81F to blend all of channels by one multiplication */
+    const uint32_t fg32 = ((uint32_t)color.full | ((uint32_t)color.full << 16)) & 0x07E0F81F;
+    uint32_t word, bg, res, out;
+
+    for (; len >= 2; len -= 2, dst += 2) {
+        memcpy(&word, dst, sizeof(word));
+        bg = ((word & 0xFFFF) | (word << 16)) & 0x07E0F81F;
+        res = ((((fg32 - bg) * f) >> 5) + bg) & 0x07E0F81F;
+        out = (res | (res >> 16)) & 0xFFFF;
+        bg = ((word >> 16) | (word & 0xFFFF0000)) & 0x07E0F81F;
+        res = ((((fg32 - bg) * f) >> 5) + bg) & 0x07E0F81F;
+        out |= (res | (res >> 16)) << 16;
+        memcpy(dst, &out, sizeof(out));
+    }
+
+    if (len) {
+        bg = ((uint32_t)dst->full | ((uint32_t)dst->full << 16)) & 0x07E0F81F;
+        res = ((((fg32 - bg) * f) >> 5) + bg) & 0x07E0F81F;
+        dst->full = (uint16_t)((res >> 16) | res);
+    }
+#else
+#if (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_ARGB8888) && (SGL_DRAW_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i inv = _mm_set1_epi16(256 - alpha);
+    const __m128i fgf = _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_set1_epi32((int)color.full), zero), _mm_set1_epi16(alpha));
+    __m128i p, lo, hi;
+
+    SGL_PERF_ADD(blend, len & ~3);
+    for (; len >= 4; len -= 4, dst += 4) {
+        p = _mm_loadu_si128((const __m128i *)dst);
+        lo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(p, zero), inv), fgf), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(p, zero), inv), fgf), 8);
+        _mm_storeu_si128((__m128i *)dst, _mm_packus_epi16(lo, hi));
+    }
+#elif (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_ARGB8888) && (SGL_DRAW_NEON)
+    const uint16x8_t inv = vdupq_n_u16(256 - alpha);
+    const uint16x8_t fgf = vmulq_n_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(color.full))), alpha);
+    uint8x16_t p;
+    uint16x8_t lo, hi;
+
+    SGL_PERF_ADD(blend, len & ~3);
+    for (; len >= 4; len -= 4, dst += 4) {
+        p = vld1q_u8((const uint8_t *)dst);
+        lo = vmlaq_u16(fgf, vmovl_u8(vget_low_u8(p)), inv);
+        hi = vmlaq_u16(fgf, vmovl_u8(vget_high_u8(p)), inv);
+        vst1q_u8((uint8_t *)dst, vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8)));
+    }
+#endif
+    for (int32_t i = 0; i < len; i++) {
+        dst[i] = sgl_color_mixer(color, dst[i], alpha);
+    }
+#endif
+}
+
+
+/**
+ * @brief blend a row of source pixels into a span with alpha
+ * @param dst destination
+ * @param src source, it must not overlap with destination
+ * @param len number of pixels
+ * @param alpha alpha of source
+ * @return none
+ * @note every pixel is the same as sgl_color_mixer(src, dst, alpha), the channels are computed
+ *       as (bg * (max - a) + fg * a) >> shift like draw_span_blend(), only the foreground is loaded per pixel
+ */
+static inline void draw_span_copy_blend(sgl_color_t *dst, const sgl_color_t *src, int32_t len, uint8_t alpha)
+{
+#if (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_RGB565) && (SGL_DRAW_SSE2)
+    const uint16_t f = ((uint16_t)alpha + 4) >> 3;
+    const __m128i inv = _mm_set1_epi16(32 - f), fv = _mm_set1_epi16(f);
+    const __m128i mask6 = _mm_set1_epi16(0x3F), mask5 = _mm_set1_epi16(0x1F);
+    __m128i p, q, r, g, b;
+
+    SGL_PERF_ADD(blend, len & ~7);
+    for (; len >= 8; len -= 8, dst += 8, src += 8) {
+        p = _mm_loadu_si128((const __m128i *)dst);
+        q = _mm_loadu_si128((const __m128i *)src);
+        r = _mm_add_epi16(_mm_mullo_epi16(_mm_srli_epi16(p, 11), inv), _mm_mullo_epi16(_mm_srli_epi16(q, 11), fv));
+        g = _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(p, 5), mask6), inv),
+                          _mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(q, 5), mask6), fv));
+        b = _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(p, mask5), inv), _mm_mullo_epi16(_mm_and_si128(q, mask5), fv));
+        p = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(_mm_srli_epi16(r, 5), 11), _mm_slli_epi16(_mm_srli_epi16(g, 5), 5)),
+                         _mm_srli_epi16(b, 5));
+        _mm_storeu_si128((__m128i *)dst, p);
+    }
+#elif (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_RGB565) && (SGL_DRAW_NEON)
+    const uint16_t f = ((uint16_t)alpha + 4) >> 3;
+    const uint16x8_t inv = vdupq_n_u16(32 - f), fv = vdupq_n_u16(f);
+    const uint16x8_t mask6 = vdupq_n_u16(0x3F), mask5 = vdupq_n_u16(0x1F);
+    uint16x8_t p, q, r, g, b;
+
+    SGL_PERF_ADD(blend, len & ~7);
+    for (; len >= 8; len -= 8, dst += 8, src += 8) {
+        p = vld1q_u16((const uint16_t *)dst);
+        q = vld1q_u16((const uint16_t *)src);
+        r = vmlaq_u16(vmulq_u16(vshrq_n_u16(q, 11), fv), vshrq_n_u16(p, 11), inv);
+        g = vmlaq_u16(vmulq_u16(vandq_u16(vshrq_n_u16(q, 5), mask6), fv), vandq_u16(vshrq_n_u16(p, 5), mask6), inv);
+        b = vmlaq_u16(vmulq_u16(vandq_u16(q, mask5), fv), vandq_u16(p, mask5), inv);
+        p = vorrq_u16(vorrq_u16(vshlq_n_u16(vshrq_n_u16(r, 5), 11), vshlq_n_u16(vshrq_n_u16(g, 5), 5)), vshrq_n_u16(b, 5));
+        vst1q_u16((uint16_t *)dst, p);
+    }
+#elif (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_ARGB8888) && (SGL_DRAW_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i inv = _mm_set1_epi16(256 - alpha), fv = _mm_set1_epi16(alpha);
+    __m128i p, q, lo, hi;
+
+    SGL_PERF_ADD(blend, len & ~3);
+    for (; len >= 4; len -= 4, dst += 4, src += 4) {
+        p = _mm_loadu_si128((const __m128i *)dst);
+        q = _mm_loadu_si128((const __m128i *)src);
+        lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(p, zero), inv), _mm_mullo_epi16(_mm_unpacklo_epi8(q, zero), fv));
+        hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(p, zero), inv), _mm_mullo_epi16(_mm_unpackhi_epi8(q, zero), fv));
+        _mm_storeu_si128((__m128i *)dst, _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8)));
+    }
+#elif (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_ARGB8888) && (SGL_DRAW_NEON)
+    const uint8x8_t inv = vdup_n_u8((uint8_t)(255 - alpha)), fv = vdup_n_u8(alpha);
+    uint8x16_t p, q;
+    uint16x8_t lo, hi;
+
+    SGL_PERF_ADD(blend, len & ~3);
+    for (; len >= 4; len -= 4, dst += 4, src += 4) {
+        p = vld1q_u8((const uint8_t *)dst);
+        q = vld1q_u8((const uint8_t *)src);
+        /* bg * (256 - a) is bg * (255 - a) + bg, it keeps the products in 16 bits */
+        lo = vaddw_u8(vmlal_u8(vmull_u8(vget_low_u8(q), fv), vget_low_u8(p), inv), vget_low_u8(p));
+        hi = vaddw_u8(vmlal_u8(vmull_u8(vget_high_u8(q), fv), vget_high_u8(p), inv), vget_high_u8(p));
+        vst1q_u8((uint8_t *)dst, vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8)));
+    }
+#endif
+    for (int32_t i = 0; i < len; i++) {
+        dst[i] = sgl_color_mixer(src[i], dst[i], alpha);
+    }
+}
+
+
+/**
+ * @brief fill pixels with color by software
+ * @param dst start of destination
+ * @param stride pixels of a row of destination
+ * @param w width of pixels to fill
+ * @param h height of pixels to fill
+ * @param color fill color
+ * @return none
+ */
+void sgl_draw_soft_fill(sgl_color_t *dst, int16_t stride, int16_t w, int16_t h, sgl_color_t color)
+{
+    /* the rows are continuous, fill them as one span */
+    if (stride == w) {
+        draw_span_fill(dst, (int32_t)w * h, color);
+        return;
+    }
+
+    for (int16_t y = 0; y < h; y++) {
+        draw_span_fill(dst, w, color);
+        dst += stride;
+    }
+}
+
+
+/**
+ * @brief blend color into pixels with alpha by software
+ * @param dst start of destination
+ * @param stride pixels of a row of destination
+ * @param w width of pixels to blend
+ * @param h height of pixels to blend
+ * @param color blend color
+ * @param alpha alpha of color
+ * @return none
+ */
+void sgl_draw_soft_blend(sgl_color_t *dst, int16_t stride, int16_t w, int16_t h, sgl_color_t color, uint8_t alpha)
+{
+    if (stride == w) {
+        draw_span_blend(dst, (int32_t)w * h, color, alpha);
+        return;
+    }
+
+    for (int16_t y = 0; y < h; y++) {
+        draw_span_blend(dst, w, color, alpha);
+        dst += stride;
+    }
+}
+
+
+/**
+ * @brief copy a row of pixels by software
+ * @param dst destination
+ * @param src source, it must not overlap with destination
+ * @param len number of pixels
+ * @param alpha alpha of source, the source is blended into destination if it is not SGL_ALPHA_MAX
+ * @return none
+ */
+void sgl_draw_soft_copy(sgl_color_t *dst, const sgl_color_t *src, int16_t len, uint8_t alpha)
+{
+    if (alpha == SGL_ALPHA_MAX) {
+        memcpy(dst, src, (size_t)len * sizeof(sgl_color_t));
+        return;
+    }
+
+    draw_span_copy_blend(dst, src, len, alpha);
+}
+
+
+/**
+ * @brief blend color into a pixel by coverage
+ * @param dst destination pixel
+ * @param cover coverage of pixel
+ * @param color blend color
+ * @param alpha alpha of color, it is applied after coverage
+ * @return none
+ * @note the zero coverage is skipped and the full coverage is stored directly or blended once
+ */
+static inline void draw_mask_pixel(sgl_color_t *dst, uint8_t cover, sgl_color_t color, uint8_t alpha)
+{
+    if (cover == SGL_ALPHA_MIN) {
+        return;
+    }
+    else if (cover == SGL_ALPHA_MAX) {
+        *dst = (alpha == SGL_ALPHA_MAX) ? color : sgl_color_mixer(color, *dst, alpha);
+    }
+    else {
+        *dst = (alpha == SGL_ALPHA_MAX) ? sgl_color_mixer(color, *dst, cover) :
+               sgl_color_mixer(sgl_color_mixer(color, *dst, cover), *dst, alpha);
+    }
+}
+
+
+/**
+ * @brief blend color into a row by A4 mask, two pixels per byte
+ * @param dst destination
+ * @param mask coverage mask
+ * @param index index of the first pixel in mask
+ * @param len number of pixels
+ * @param color blend color
+ * @param alpha alpha of color
+ * @return none
+ */
+static inline void draw_mask_row_a4(sgl_color_t *dst, const uint8_t *mask, uint32_t index, int16_t len, sgl_color_t color, uint8_t alpha)
+{
+    const uint8_t *src = &mask[index >> 1];
+    int16_t i = 0;
+
+    if ((index & 1) && len > 0) {
+        draw_mask_pixel(&dst[i++], sgl_opa4_table[*src++ & 0x0F], color, alpha);
+    }
+
+    for (; i + 1 < len; i += 2) {
+        const uint8_t byte = *src++;
+        if (byte == 0) {
+            continue;
+        }
+        draw_mask_pixel(&dst[i], sgl_opa4_table[byte >> 4], color, alpha);
+        draw_mask_pixel(&dst[i + 1], sgl_opa4_table[byte & 0x0F], color, alpha);
+    }
+
+    if (i < len) {
+        draw_mask_pixel(&dst[i], sgl_opa4_table[*src >> 4], color, alpha);
+    }
+}
+
+
+/**
+ * @brief blend color into a row by A2 mask, four pixels per byte
+ * @param dst destination
+ * @param mask coverage mask
+ * @param index index of the first pixel in mask
+ * @param len number of pixels
+ * @param color blend color
+ * @param alpha alpha of color
+ * @return none
+ */
+static inline void draw_mask_row_a2(sgl_color_t *dst, const uint8_t *mask, uint32_t index, int16_t len, sgl_color_t color, uint8_t alpha)
+{
+    const uint8_t *src = &mask[index >> 2];
+    uint8_t byte = *src << ((index & 0x3) * 2);
+    int16_t i = 0, n = 4 - (index & 0x3);
+
+    while (i < len) {
+        if (byte == 0) {
+            i += n;
+        }
+        else {
+            for (; n > 0 && i < len; n--, i++, byte <<= 2) {
+                draw_mask_pixel(&dst[i], sgl_opa2_table[byte >> 6], color, alpha);
+            }
+        }
+        if (i < len) {
+            byte = *(++src);
+            n = 4;
+        }
+    }
+}
+
+
+/**
+ * @brief blend color into a row by A1 mask, eight pixels per byte
+ * @param dst destination
+ * @param mask coverage mask
+ * @param index index of the first pixel in mask
+ * @param len number of pixels
+ * @param color blend color
+ * @param alpha alpha of color
+ * @return none
+ */
+static inline void draw_mask_row_a1(sgl_color_t *dst, const uint8_t *mask, uint32_t index, int16_t len, sgl_color_t color, uint8_t alpha)
+{
+    const uint8_t *src = &mask[index >> 3];
+    uint8_t byte = *src << (index & 0x7);
+    int16_t i = 0, n = 8 - (index & 0x7);
+
+    while (i < len) {
+        if (byte == 0) {
+            i += n;
+        }
+        else {
+            for (; n > 0 && i < len; n--, i++, byte <<= 1) {
+                if (byte & 0x80) {
+                    dst[i] = (alpha == SGL_ALPHA_MAX) ? color : sgl_color_mixer(color, dst[i], alpha);
+                }
+            }
+        }
+        if (i < len) {
+            byte = *(++src);
+            n = 8;
+        }
+    }
+}
+
+
+/**
+ * @brief blend color into a row by A8 mask, the byte is coverage itself
+ * @param dst destination
+ * @param mask coverage mask
+ * @param index index of the first pixel in mask
+ * @param len number of pixels
+ * @param color blend color
+ * @param alpha alpha of color
+ * @return none
+ */
+static inline void draw_mask_row_a8(sgl_color_t *dst, const uint8_t *mask, uint32_t index, int16_t len, sgl_color_t color, uint8_t alpha)
+{
+    mask += index;
+
+    for (int16_t i = 0; i < len; i++) {
+        draw_mask_pixel(&dst[i], mask[i], color, alpha);
+    }
+}
+
+
+/**
+ * @brief blend color into a row of pixels by coverage mask by software
+ * @param dst destination
+ * @param mask coverage mask, pixels are packed from the most significant bits of byte
+ * @param index index of the first pixel in mask
+ * @param len number of pixels
+ * @param bpp bits per pixel of mask, 1, 2, 4 or 8, 8 means the byte is coverage itself
+ * @param color blend color
+ * @param alpha alpha of color, it is applied after coverage
+ * @return none
+ * @note every bpp has its own row kernel, and the opaque alpha is a constant of kernel, so that
+ *       there is no branch of bpp and alpha in the pixel loop
+ */
+void sgl_draw_soft_mask(sgl_color_t *dst, const uint8_t *mask, uint32_t index, int16_t len, uint8_t bpp, sgl_color_t color, uint8_t alpha)
+{
+    switch (bpp) {
+    case 4:
+        if (alpha == SGL_ALPHA_MAX) {
+            draw_mask_row_a4(dst, mask, index, len, color, SGL_ALPHA_MAX);
+        }
+        else {
+            draw_mask_row_a4(dst, mask, index, len, color, alpha);
+        }
+        break;
+    case 2:
+        if (alpha == SGL_ALPHA_MAX) {
+            draw_mask_row_a2(dst, mask, index, len, color, SGL_ALPHA_MAX);
+        }
+        else {
+            draw_mask_row_a2(dst, mask, index, len, color, alpha);
+        }
+        break;
+    case 1:
+        if (alpha == SGL_ALPHA_MAX) {
+            draw_mask_row_a1(dst, mask, index, len, color, SGL_ALPHA_MAX);
+        }
+        else {
+            draw_mask_row_a1(dst, mask, index, len, color, alpha);
+        }
+        break;
+    default:
+        if (alpha == SGL_ALPHA_MAX) {
+            draw_mask_row_a8(dst, mask, index, len, color, SGL_ALPHA_MAX);
+        }
+        else {
+            draw_mask_row_a8(dst, mask, index, len, color, alpha);
+        }
+        break;
+    }
+}
+
+
+/**
+ * @brief register draw operations, such as a 2D accelerator of port
+ * @param ops draw operations, the NULL entry keeps software implementation,
+ *            NULL restores all of the software implementations
+ * @return none
+ * @note the operations are called by draw threads at the same time if CONFIG_SGL_DRAW_THREADS is set,
+ *       and the pixels must be written when the operation returns. register it before sgl_init()
+ *       or between frames, the table is copied, so it can be a local variable
+ */
+void sgl_draw_ops_register(const sgl_draw_ops_t *ops)
+{
+    sgl_draw_ops.fill  = (ops && ops->fill)  ? ops->fill  : sgl_draw_soft_fill;
+    sgl_draw_ops.blend = (ops && ops->blend) ? ops->blend : sgl_draw_soft_blend;
+    sgl_draw_ops.copy  = (ops && ops->copy)  ? ops->copy  : sgl_draw_soft_copy;
+    sgl_draw_ops.mask  = (ops && ops->mask)  ? ops->mask  : sgl_draw_soft_mask;
+}
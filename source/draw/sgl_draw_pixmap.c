@@ -0,0 +1,427 @@
+/* source/draw/sgl_draw_pixmap.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <sgl_core.h>
+#include <sgl_draw.h>
+#include <sgl_log.h>
+#include <string.h>
+
+
+/* the native pixel of RGB565 framebuffer is the little endian RGB565 pixel */
+#if (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_RGB565) && defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define  SGL_PIXMAP_RGB565_IS_NATIVE        (1)
+#else
+#define  SGL_PIXMAP_RGB565_IS_NATIVE        (0)
+#endif
+
+/* pixels that are converted on the stack at a time by sgl_pixmap_to_native() */
+#define  SGL_PIXMAP_NATIVE_CHUNK            (32)
+
+
+static void pixmap_row_native(sgl_color_t *color, uint8_t *alpha, const uint8_t *src, uint32_t len)
+{
+    memcpy(color, src, len * sizeof(sgl_color_t));
+    if (alpha != NULL) {
+        memset(alpha, SGL_ALPHA_MAX, len);
+    }
+}
+
+
+static void pixmap_row_rgb332(sgl_color_t *color, uint8_t *alpha, const uint8_t *src, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        color[i] = sgl_rgb332_to_color(src[i]);
+    }
+    if (alpha != NULL) {
+        memset(alpha, SGL_ALPHA_MAX, len);
+    }
+}
+
+
+static void pixmap_row_argb2222(sgl_color_t *color, uint8_t *alpha, const uint8_t *src, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        color[i] = sgl_rgb222_to_color(src[i]);
+    }
+    if (alpha != NULL) {
+        for (uint32_t i = 0; i < len; i++) {
+            alpha[i] = sgl_opa2_table[src[i] >> 6];
+        }
+    }
+}
+
+
+static void pixmap_row_rgb565(sgl_color_t *color, uint8_t *alpha, const uint8_t *src, uint32_t len)
+{
+#if (SGL_PIXMAP_RGB565_IS_NATIVE)
+    memcpy(color, src, len * sizeof(sgl_color_t));
+#else
+    uint32_t pix_value;
+
+    for (uint32_t i = 0; i < len; i++, src += 2) {
+        pix_value = src[0] | (src[1] << 8);
+        color[i] = sgl_rgb565_to_color(pix_value);
+    }
+#endif
+    if (alpha != NULL) {
+        memset(alpha, SGL_ALPHA_MAX, len);
+    }
+}
+
+
+static void pixmap_row_argb4444(sgl_color_t *color, uint8_t *alpha, const uint8_t *src, uint32_t len)
+{
+    uint32_t pix_value;
+
+    for (uint32_t i = 0; i < len; i++) {
+        pix_value = src[i * 2] | (src[i * 2 + 1] << 8);
+        color[i] = sgl_rgb444_to_color(pix_value);
+    }
+    if (alpha != NULL) {
+        for (uint32_t i = 0; i < len; i++) {
+            alpha[i] = sgl_opa4_table[src[i * 2 + 1] >> 4];
+        }
+    }
+}
+
+
+static void pixmap_row_rgb888(sgl_color_t *color, uint8_t *alpha, const uint8_t *src, uint32_t len)
+{
+    uint32_t pix_value;
+
+    for (uint32_t i = 0; i < len; i++, src += 3) {
+        pix_value = src[0] | (src[1] << 8) | (src[2] << 16);
+        color[i] = sgl_rgb888_to_color(pix_value);
+    }
+    if (alpha != NULL) {
+        memset(alpha, SGL_ALPHA_MAX, len);
+    }
+}
+
+
+static void pixmap_row_argb8888(sgl_color_t *color, uint8_t *alpha, const uint8_t *src, uint32_t len)
+{
+    uint32_t pix_value;
+
+    for (uint32_t i = 0; i < len; i++) {
+        pix_value = src[i * 4] | (src[i * 4 + 1] << 8) | (src[i * 4 + 2] << 16);
+        color[i] = sgl_rgb888_to_color(pix_value);
+    }
+    if (alpha != NULL) {
+        for (uint32_t i = 0; i < len; i++) {
+            alpha[i] = src[i * 4 + 3];
+        }
+    }
+}
+
+
+static void pixmap_row_native_alpha(sgl_color_t *color, uint8_t *alpha, const uint8_t *src, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        memcpy(&color[i], &src[i * SGL_PIXMAP_NATIVE_ALPHA_BYTES], sizeof(sgl_color_t));
+    }
+    if (alpha != NULL) {
+        for (uint32_t i = 0; i < len; i++) {
+            alpha[i] = src[i * SGL_PIXMAP_NATIVE_ALPHA_BYTES + sizeof(sgl_color_t)];
+        }
+    }
+}
+
+
+/**
+ * @brief get the row converter of a pixel format
+ * @param format pixel format of pixmap
+ * @return row converter, NULL if the format is RLE compressed or invalid
+ * @note look it up once per draw, then the rows are converted without a per pixel switch
+ */
+sgl_pixmap_row_cvt_t sgl_pixmap_get_row_cvt(uint8_t format)
+{
+    static const sgl_pixmap_row_cvt_t s_row_cvt[] = {
+        [SGL_PIXMAP_FMT_NONE]     = pixmap_row_native,
+        [SGL_PIXMAP_FMT_RGB332]   = pixmap_row_rgb332,
+        [SGL_PIXMAP_FMT_ARGB2222] = pixmap_row_argb2222,
+        [SGL_PIXMAP_FMT_RGB565]   = pixmap_row_rgb565,
+        [SGL_PIXMAP_FMT_ARGB4444] = pixmap_row_argb4444,
+        [SGL_PIXMAP_FMT_RGB888]   = pixmap_row_rgb888,
+        [SGL_PIXMAP_FMT_ARGB8888] = pixmap_row_argb8888,
+        [SGL_PIXMAP_FMT_NATIVE_ALPHA] = pixmap_row_native_alpha,
+    };
+
+    if (format >= SGL_ARRAY_SIZE(s_row_cvt)) {
+        return NULL;
+    }
+    return s_row_cvt[format];
+}
+
+
+/* index of pixel in the recently seen pixels of tile decoder */
+#define  SGL_PIXMAP_TILE_HASH(px)           ((((px) >> 16 & 0xff) * 3 + ((px) >> 8 & 0xff) * 5 + ((px) & 0xff) * 7 + ((px) >> 24) * 11) & 63)
+
+
+/**
+ * @brief start to decode a tile of tiled pixmap
+ * @param dec decoder state
+ * @return none
+ */
+void sgl_pixmap_tile_dec_init(sgl_pixmap_tile_dec_t *dec)
+{
+    SGL_ASSERT(dec != NULL);
+    memset(dec, 0, sizeof(sgl_pixmap_tile_dec_t));
+    dec->px = 0xff000000;
+}
+
+
+/**
+ * @brief decode the next pixels of a tile
+ * @param dec decoder state
+ * @param color [out] native colors, NULL to skip the pixels
+ * @param alpha [out] alpha of pixels, NULL if the alpha is not needed
+ * @param src [in/out] bytes of tile, it is moved after the decoded operations
+ * @param len bytes that are valid from src
+ * @param n number of pixels
+ * @return number of decoded pixels, it is less than n if the next operation is not in len bytes
+ * @note an operation is never split, so len of SGL_PIXMAP_TILE_OP_MAX bytes always decodes a pixel
+ */
+uint32_t sgl_pixmap_tile_decode(sgl_pixmap_tile_dec_t *dec, sgl_color_t *color, uint8_t *alpha, const uint8_t **src, uint32_t len, uint32_t n)
+{
+    const uint8_t *p = *src;
+    uint32_t px = dec->px, run = dec->run, i = 0, k, size;
+    uint8_t r, g, b, op;
+    int8_t vg;
+    sgl_color_t c;
+
+    while (i < n) {
+        if (run == 0) {
+            if (len == 0) {
+                break;
+            }
+
+            op = p[0];
+            size = (op == 0xfe) ? 4 : (op == 0xff) ? 5 : ((op >> 6) == 2) ? 2 : 1;
+            if (size > len) {
+                break;
+            }
+
+            r = (uint8_t)(px >> 16);
+            g = (uint8_t)(px >> 8);
+            b = (uint8_t)px;
+            run = 1;
+
+            if (op == 0xfe) {
+                px = (px & 0xff000000) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+            }
+            else if (op == 0xff) {
+                px = ((uint32_t)p[4] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+            }
+            else {
+                switch (op >> 6) {
+                case 0:
+                    px = dec->index[op];
+                    break;
+                case 1:
+                    r += ((op >> 4) & 3) - 2;
+                    g += ((op >> 2) & 3) - 2;
+                    b += (op & 3) - 2;
+                    px = (px & 0xff000000) | ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+                    break;
+                case 2:
+                    vg = (int8_t)((op & 0x3f) - 32);
+                    r += vg - 8 + (p[1] >> 4);
+                    g += vg;
+                    b += vg - 8 + (p[1] & 0x0f);
+                    px = (px & 0xff000000) | ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+                    break;
+                default:
+                    run = (op & 0x3f) + 1;
+                    break;
+                }
+            }
+
+            dec->index[SGL_PIXMAP_TILE_HASH(px)] = px;
+            p += size;
+            len -= size;
+        }
+
+        /* the pixel of operation is repeated by the run */
+        k = sgl_min(run, n - i);
+        if (color != NULL) {
+            c = sgl_rgb888_to_color(px & 0xffffff);
+            for (uint32_t j = 0; j < k; j++) {
+                color[i + j] = c;
+            }
+        }
+        if (alpha != NULL) {
+            memset(&alpha[i], px >> 24, k);
+        }
+        run -= k;
+        i += k;
+    }
+
+    dec->px = px;
+    dec->run = run;
+    *src = p;
+    return i;
+}
+
+
+/**
+ * @brief store converted pixels into native pixmap
+ * @param dst [out] native pixels
+ * @param color native colors
+ * @param alpha alpha of pixels, NULL if the native pixmap has no alpha
+ * @param len number of pixels
+ * @return none
+ */
+static void pixmap_native_store(uint8_t *dst, const sgl_color_t *color, const uint8_t *alpha, uint32_t len)
+{
+    if (alpha == NULL) {
+        memcpy(dst, color, len * sizeof(sgl_color_t));
+        return;
+    }
+
+    for (uint32_t i = 0; i < len; i++, dst += SGL_PIXMAP_NATIVE_ALPHA_BYTES) {
+        memcpy(dst, &color[i], sizeof(sgl_color_t));
+        dst[sizeof(sgl_color_t)] = alpha[i];
+    }
+}
+
+
+/**
+ * @brief decode a tiled pixmap in memory to native pixmap
+ * @param buf [out] pixels of native pixmap
+ * @param has_alpha true if the native pixmap has alpha
+ * @param src tiled pixmap in memory
+ * @return int, 0 if success, -1 if the data is broken
+ */
+static int pixmap_tile_to_native(uint8_t *buf, bool has_alpha, const sgl_pixmap_t *src)
+{
+    const uint8_t *data = src->bitmap.array, *p, *end;
+    const uint16_t tile_w = data[0] | (data[1] << 8);
+    const uint16_t tile_h = data[2] | (data[3] << 8);
+    const uint8_t *table = data + SGL_PIXMAP_TILE_HEAD_SIZE;
+    const uint32_t pix_byte = has_alpha ? SGL_PIXMAP_NATIVE_ALPHA_BYTES : sizeof(sgl_color_t);
+    sgl_color_t color[SGL_PIXMAP_NATIVE_CHUNK];
+    uint8_t alpha[SGL_PIXMAP_NATIVE_CHUNK];
+    sgl_pixmap_tile_dec_t dec;
+    uint32_t tile = 0, offset, w, h, n;
+
+    if (tile_w == 0 || tile_h == 0) {
+        return -1;
+    }
+
+    for (uint32_t y = 0; y < src->height; y += tile_h) {
+        h = sgl_min((uint32_t)tile_h, src->height - y);
+        for (uint32_t x = 0; x < src->width; x += tile_w, tile ++) {
+            w = sgl_min((uint32_t)tile_w, src->width - x);
+            p = data + (table[tile * 4] | (table[tile * 4 + 1] << 8) | (table[tile * 4 + 2] << 16) | ((uint32_t)table[tile * 4 + 3] << 24));
+            end = data + (table[tile * 4 + 4] | (table[tile * 4 + 5] << 8) | (table[tile * 4 + 6] << 16) | ((uint32_t)table[tile * 4 + 7] << 24));
+
+            sgl_pixmap_tile_dec_init(&dec);
+            for (uint32_t row = 0; row < h; row++) {
+                offset = (y + row) * src->width + x;
+                /* a row of tile is decoded on the stack by chunks, then stored into its place */
+                for (uint32_t i = 0; i < w; i += n) {
+                    n = sgl_min(w - i, (uint32_t)SGL_PIXMAP_NATIVE_CHUNK);
+                    if (end < p || sgl_pixmap_tile_decode(&dec, color, has_alpha ? alpha : NULL, &p, end - p, n) < n) {
+                        return -1;
+                    }
+                    pixmap_native_store(&buf[(offset + i) * pix_byte], color, has_alpha ? alpha : NULL, n);
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+
+/**
+ * @brief get the bytes of pixmap that is converted by sgl_pixmap_to_native()
+ * @param src pixmap in memory
+ * @return bytes of native pixmap, 0 if the pixmap can not be converted
+ */
+uint32_t sgl_pixmap_native_size(const sgl_pixmap_t *src)
+{
+    SGL_ASSERT(src != NULL);
+
+    if (sgl_pixmap_get_row_cvt(src->format) == NULL && src->format != SGL_PIXMAP_FMT_TILE_RGB888 && src->format != SGL_PIXMAP_FMT_TILE_ARGB8888) {
+        return 0;
+    }
+
+    return (uint32_t)src->width * src->height * (sgl_pixmap_format_has_alpha(src->format) ? SGL_PIXMAP_NATIVE_ALPHA_BYTES : sizeof(sgl_color_t));
+}
+
+
+/**
+ * @brief convert a pixmap to framebuffer native format
+ * @param dst [out] native pixmap, its bitmap points to buf
+ * @param buf [out] sgl_pixmap_native_size() bytes, it must be aligned for sgl_color_t
+ * @param src pixmap in memory, it must not be RLE compressed, the tiled pixmap is decoded
+ * @return int, 0 if success, -1 if failed
+ * @note the memory is owned by caller, convert it at load time, then draw dst by ext_img.
+ *       the source without alpha is converted to SGL_PIXMAP_FMT_NONE, the source with alpha
+ *       is converted to SGL_PIXMAP_FMT_NATIVE_ALPHA that keeps the alpha of every pixel.
+ */
+int sgl_pixmap_to_native(sgl_pixmap_t *dst, void *buf, const sgl_pixmap_t *src)
+{
+    const uint32_t pixels = (uint32_t)src->width * src->height;
+    const bool has_alpha = sgl_pixmap_format_has_alpha(src->format);
+    sgl_pixmap_row_cvt_t cvt;
+
+    SGL_ASSERT(dst != NULL && buf != NULL && src != NULL);
+
+    cvt = sgl_pixmap_get_row_cvt(src->format);
+    if (src->format == SGL_PIXMAP_FMT_TILE_RGB888 || src->format == SGL_PIXMAP_FMT_TILE_ARGB8888) {
+        if (src->bitmap.array == NULL || pixmap_tile_to_native((uint8_t*)buf, has_alpha, src) != 0) {
+            SGL_LOG_ERROR("sgl_pixmap_to_native: tiled pixmap is broken");
+            return -1;
+        }
+    }
+    else if (cvt == NULL || src->bitmap.array == NULL) {
+        SGL_LOG_ERROR("sgl_pixmap_to_native: pixmap format %d can not be converted", src->format);
+        return -1;
+    }
+    else if (!has_alpha) {
+        cvt((sgl_color_t*)buf, NULL, src->bitmap.array, pixels);
+    }
+    else {
+        const uint8_t pix_byte = sgl_pixmal_get_pixel_bytes(src);
+        sgl_color_t color[SGL_PIXMAP_NATIVE_CHUNK];
+        uint8_t alpha[SGL_PIXMAP_NATIVE_CHUNK];
+        uint32_t n;
+
+        for (uint32_t i = 0; i < pixels; i += n) {
+            n = sgl_min(pixels - i, (uint32_t)SGL_PIXMAP_NATIVE_CHUNK);
+            cvt(color, alpha, &src->bitmap.array[i * pix_byte], n);
+            pixmap_native_store((uint8_t*)buf + i * SGL_PIXMAP_NATIVE_ALPHA_BYTES, color, alpha, n);
+        }
+    }
+
+    dst->width = src->width;
+    dst->height = src->height;
+    dst->format = has_alpha ? SGL_PIXMAP_FMT_NATIVE_ALPHA : SGL_PIXMAP_FMT_NONE;
+    dst->bitmap.array = (const uint8_t*)buf;
+    return 0;
+}
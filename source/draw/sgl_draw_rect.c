@@ -51,6 +51,45 @@ void sgl_draw_wireframe(sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *rect, in
 }
 
 
+/**
+ * @brief get the pixels of a part of left corner and right corner in a corner row
+ * @param clip clip area of rectangle
+ * @param cx1 center x of left corners
+ * @param cx2 center x of right corners
+ * @param dx1 first pixel of the part, it is the distance to the center column of corner
+ * @param dx2 last pixel of the part
+ * @param part [out] x range of the part in left corner and right corner, a range is empty if x1 > x2
+ * @return none
+ * @note the pixel that is less than cx1 belongs to left corner, so the two corners do not overlap
+ *       even if the rectangle is narrower than two radius
+ */
+static inline void draw_corner_part(sgl_area_t *clip, int cx1, int cx2, int dx1, int dx2, sgl_area_t part[2])
+{
+    part[0].x1 = sgl_max(cx1 - dx2, clip->x1);
+    part[0].x2 = sgl_min(cx1 - dx1, clip->x2);
+    part[1].x1 = sgl_max(sgl_max(cx2 + dx1, cx1), clip->x1);
+    part[1].x2 = sgl_min(cx2 + dx2, clip->x2);
+}
+
+
+/**
+ * @brief get the solid span of a corner row, that is the middle of row and the same part of both corners
+ * @param clip clip area of rectangle
+ * @param y row
+ * @param cx1 center x of left corners
+ * @param cx2 center x of right corners
+ * @param count pixels of the part in one corner
+ * @param span [out] the span, it is empty if x1 > x2
+ * @return none
+ */
+static inline void draw_corner_span(sgl_area_t *clip, int y, int cx1, int cx2, int count, sgl_area_t *span)
+{
+    span->x1 = sgl_max(cx1 - count, clip->x1);
+    span->x2 = sgl_min(sgl_max(cx1 - 1, cx2 + count), clip->x2);
+    span->y1 = span->y2 = y;
+}
+
+
 /**
  * @brief fill a round rectangle with alpha
  * @param surf point to surface
@@ -65,85 +104,62 @@ void sgl_draw_fill_rect(sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *rect, in
 {
     sgl_area_t clip = SGL_AREA_INVALID;
     sgl_color_t *buf = NULL, *blend = NULL;
-    uint8_t solid_alpha = (alpha == SGL_ALPHA_MAX);
+
+#if (CONFIG_SGL_DISPLAY_LIST)
+    if (unlikely(sgl_dlist_is_recording(surf))) {
+        sgl_dlist_fill_rect(area, rect, radius, color, alpha);
+        return;
+    }
+#endif
 
     sgl_surf_clip_area_return(surf, area, &clip);
     if (!sgl_area_selfclip(&clip, rect)) return;
 
-    int pixel_count = clip.x2 - clip.x1 + 1;
-    buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
-
     if (radius <= 0) {
-        for (int y = clip.y1; y <= clip.y2; y++) {
-            blend = buf;
-            if (solid_alpha) {
-                for (int i = 0; i < pixel_count; i++) {
-                    blend[i] = color;
-                }
-            }
-            else {
-                for (int i = 0; i < pixel_count; i++) {
-                    blend[i] = sgl_color_mixer(color, blend[i], alpha);
-                }
-            }
-            buf += surf->w;
-        }
+        sgl_draw_ops_surf_area(surf, &clip, color, alpha);
         return;
     }
 
+    const int pixel_count = clip.x2 - clip.x1 + 1;
+    buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
+
     const int cx1 = rect->x1 + radius;
     const int cx2 = rect->x2 - radius;
     const int cy1 = rect->y1 + radius;
     const int cy2 = rect->y2 - radius;
 
-    const int r2 = sgl_pow2(radius);
-    const int r2_max = sgl_pow2(radius + 1);
-    const int r2_diff = sgl_max(r2_max - r2, 1);
-    const int r2_fix_diff = (SGL_ALPHA_MAX << SGL_FIXED_SHIFT) / r2_diff;
-
-    int cy_tmp, cx_tmp;
-    int dy2, real_r2;
+    sgl_draw_corner_t corner;
+    sgl_draw_corner_row_t row;
+    sgl_area_t span, part[2];
+    const uint8_t *cover;
     uint8_t edge_alpha;
+    int dx;
+
+    sgl_draw_corner_init(&corner, radius, -1);
 
     for (int y = clip.y1; y <= clip.y2; y++) {
-        blend = buf;
         if (y >= cy1 && y <= cy2) {
-            pixel_count = clip.x2 - clip.x1 + 1;
-            solid_alpha = (alpha == SGL_ALPHA_MAX);
-
-            if (solid_alpha) {
-                for (int i = 0; i < pixel_count; i++) {
-                    blend[i] = color;
-                }
-            } else {
-                for (int i = 0; i < pixel_count; i++) {
-                    blend[i] = sgl_color_mixer(color, blend[i], alpha);
-                }
-            }
+            /* all of the rows between corners are one block */
+            const int rows = sgl_min(cy2, clip.y2) - y + 1;
+            sgl_draw_ops_area(buf, surf->w, pixel_count, rows, color, alpha);
+            y += rows - 1;
+            buf += (rows - 1) * surf->w;
         }
         else {
-            cy_tmp = (y < cy1) ? cy1 : cy2;
-            dy2 = sgl_pow2(y - cy_tmp);
-
-            for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-                if (x >= cx1 && x <= cx2) {
-                    *blend = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha));
-                }
-                else {
-                    cx_tmp = (x < cx1) ? cx1 : cx2;
-                    real_r2 = sgl_pow2(x - cx_tmp) + dy2;
-
-                    if (real_r2 >= r2_max) {
-                        if(x > cx_tmp) break; else continue;
-                    }
-                    else if (real_r2 >= r2) {
-                        edge_alpha = ((r2_max - real_r2) * r2_fix_diff) >> SGL_FIXED_SHIFT;
-                        *blend = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(color, *blend, edge_alpha) : 
-                                 sgl_color_mixer(sgl_color_mixer(color, *blend, edge_alpha), *blend, alpha));
-                    }
-                    else {
-                        *blend = (alpha == SGL_ALPHA_MAX) ? color : sgl_color_mixer(color, *blend, alpha);
-                    }
+            cover = sgl_draw_corner_get_row(&corner, (y < cy1) ? cy1 - y : y - cy2, &row);
+
+            /* the inside of both corners and the middle of row are one span */
+            draw_corner_span(&clip, y, cx1, cx2, row.inside, &span);
+            sgl_draw_ops_surf_area(surf, &span, color, alpha);
+
+            draw_corner_part(&clip, cx1, cx2, row.inside + 1, row.inside + row.out_edge, part);
+            for (int i = 0; i < 2; i++) {
+                for (int x = part[i].x1; x <= part[i].x2; x++) {
+                    dx = (x < cx1) ? cx1 - x : x - cx2;
+                    edge_alpha = cover[dx - row.inside - 1];
+                    blend = &buf[x - clip.x1];
+                    *blend = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(color, *blend, edge_alpha) :
+                             sgl_color_mixer(sgl_color_mixer(color, *blend, edge_alpha), *blend, alpha));
                 }
             }
         }
@@ -152,6 +168,37 @@ void sgl_draw_fill_rect(sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *rect, in
 }
 
 
+/**
+ * @brief fill rows of a rectangle that are made of left border, inside and right border
+ * @param surf point to surface
+ * @param clip clip area of rectangle
+ * @param y1 first row
+ * @param y2 last row
+ * @param x1i left x of inside
+ * @param x2i right x of inside
+ * @param color color of inside
+ * @param border_color color of border
+ * @param alpha alpha of inside
+ * @param border_alpha alpha of border
+ * @return none
+ */
+static void draw_rect_border_rows(sgl_surf_t *surf, sgl_area_t *clip, int16_t y1, int16_t y2, int16_t x1i, int16_t x2i,
+                                  sgl_color_t color, sgl_color_t border_color, uint8_t alpha, uint8_t border_alpha)
+{
+    sgl_area_t part = { .x1 = clip->x1, .x2 = sgl_min(x1i - 1, clip->x2), .y1 = y1, .y2 = y2 };
+    sgl_draw_ops_surf_area(surf, &part, border_color, border_alpha);
+
+    part.x1 = sgl_max(x1i, clip->x1);
+    part.x2 = sgl_min(x2i, clip->x2);
+    sgl_draw_ops_surf_area(surf, &part, color, alpha);
+
+    /* the inside is empty if the border is too wide, do not draw left border twice */
+    part.x1 = sgl_max(sgl_max(x2i + 1, x1i), clip->x1);
+    part.x2 = clip->x2;
+    sgl_draw_ops_surf_area(surf, &part, border_color, border_alpha);
+}
+
+
 /**
  * @brief fill a round rectangle with alpha and border
  * @param surf point to surface
@@ -180,17 +227,17 @@ void sgl_draw_fill_rect_with_border(sgl_surf_t *surf, sgl_area_t *area, sgl_area
     const int cyi2 = rect->y2 - border_width;
 
     if (radius == 0) {
-        for (int y = clip.y1; y <= clip.y2; y++) {
-            blend = buf;
-            for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-                if (x >= cx1i && x <= cx2i && y >= cyi1 && y <= cyi2) {
-                    *blend = (alpha == SGL_ALPHA_MAX) ? color : sgl_color_mixer(color, *blend, alpha);
-                } else {
-                    *blend = (border_alpha == SGL_ALPHA_MAX) ? border_color : sgl_color_mixer(border_color, *blend, border_alpha);
-                }
-            }
-            buf += surf->w;
-        }
+        sgl_area_t part = clip;
+
+        /* top border, then bottom border that is not drawn by top border */
+        part.y2 = sgl_min(cyi1 - 1, clip.y2);
+        sgl_draw_ops_surf_area(surf, &part, border_color, border_alpha);
+        part.y1 = sgl_max(sgl_max(cyi2 + 1, cyi1), clip.y1);
+        part.y2 = clip.y2;
+        sgl_draw_ops_surf_area(surf, &part, border_color, border_alpha);
+
+        draw_rect_border_rows(surf, &clip, sgl_max(cyi1, clip.y1), sgl_min(cyi2, clip.y2), cx1i, cx2i,
+                              color, border_color, alpha, border_alpha);
         return;
     }
 
@@ -199,171 +246,199 @@ void sgl_draw_fill_rect_with_border(sgl_surf_t *surf, sgl_area_t *area, sgl_area
     const int cy1 = rect->y1 + radius;
     const int cy2 = rect->y2 - radius;
 
-    const int radius_in = sgl_max(radius - border_width, 0);
-    const int out_r2 = sgl_pow2(radius);
-    const int out_r2_max = sgl_pow2(radius + 1);
-    const int in_r2 = sgl_pow2(radius_in);
-    const int in_r2_max = sgl_pow2(radius_in + 1);
-
-    const int out_r2_diff = sgl_max(out_r2_max - out_r2, 1);
-    const int out_fix_diff = (SGL_ALPHA_MAX << SGL_FIXED_SHIFT) / out_r2_diff;
-    const int in_r2_diff = sgl_max(in_r2_max - in_r2, 1);
-    const int in_fix_diff = (SGL_ALPHA_MAX << SGL_FIXED_SHIFT) / in_r2_diff;
-
-    int cy_tmp, cx_tmp;
-    int dy2, real_r2;
+    sgl_draw_corner_t corner;
+    sgl_draw_corner_row_t row;
+    sgl_area_t span, part[2];
+    const uint8_t *cover;
     uint8_t edge_alpha;
     sgl_color_t edge_c;
+    int dx, edge_dx;
 
-    for (int y = clip.y1; y <= clip.y2; y++) {
-        blend = buf;
+    sgl_draw_corner_init(&corner, radius, border_width);
 
+    for (int y = clip.y1; y <= clip.y2; y++) {
         if (y >= cy1 && y <= cy2) {
-            for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-                if (x < cx1i || x > cx2i) {
-                    *blend = (border_alpha == SGL_ALPHA_MAX) ? border_color : sgl_color_mixer(border_color, *blend, border_alpha);
-                } else {
-                    *blend = (alpha == SGL_ALPHA_MAX) ? color : sgl_color_mixer(color, *blend, alpha);
-                }
-            }
+            /* all of the rows between corners are one block */
+            const int rows = sgl_min(cy2, clip.y2) - y + 1;
+            draw_rect_border_rows(surf, &clip, y, y + rows - 1, cx1i, cx2i, color, border_color, alpha, border_alpha);
+            y += rows - 1;
+            buf += rows * surf->w;
+            continue;
+        }
+
+        cover = sgl_draw_corner_get_row(&corner, (y < cy1) ? cy1 - y : y - cy2, &row);
+
+        if ((y < cyi1 || y > cyi2) && row.inside + row.in_edge == 0) {
+            /* the middle of row and the corners of this row are border */
+            draw_corner_span(&clip, y, cx1, cx2, row.border, &span);
+            sgl_draw_ops_surf_area(surf, &span, border_color, border_alpha);
         }
         else {
-            cy_tmp = (y < cy1) ? cy1 : cy2;
-            dy2 = sgl_pow2(y - cy_tmp);
-
-            for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-                if (x >= cx1 && x <= cx2) {
-                    if (y < cyi1 || y > cyi2) {
-                        *blend = (border_alpha == SGL_ALPHA_MAX) ? border_color : sgl_color_mixer(border_color, *blend, border_alpha);
-                    } else {
-                        *blend = (alpha == SGL_ALPHA_MAX) ? color : sgl_color_mixer(color, *blend, alpha);
-                    }
+            if (y < cyi1 || y > cyi2) {
+                /* the middle of row is border, but the corners have inside if the rectangle is lower than two radius */
+                span.x1 = sgl_max(cx1, clip.x1);
+                span.x2 = sgl_min(cx2, clip.x2);
+                span.y1 = span.y2 = y;
+                sgl_draw_ops_surf_area(surf, &span, border_color, border_alpha);
+
+                draw_corner_part(&clip, cx1, cx2, 1, row.inside, part);
+                for (int i = 0; i < 2; i++) {
+                    part[i].y1 = part[i].y2 = y;
+                    sgl_draw_ops_surf_area(surf, &part[i], color, alpha);
                 }
-                else {
-                    cx_tmp = (x < cx1) ? cx1 : cx2;
-                    real_r2 = sgl_pow2(x - cx_tmp) + dy2;
-
-                    if (real_r2 >= out_r2_max) {
-                        if(x > cx_tmp) break; else continue;
-                    }
-                    else if (real_r2 < in_r2) {
-                        *blend = (alpha == SGL_ALPHA_MAX) ? color : sgl_color_mixer(color, *blend, alpha);
-                    }
-                    else if (real_r2 < in_r2_max) {
-                        edge_alpha = ((in_r2_max - real_r2) * in_fix_diff) >> SGL_FIXED_SHIFT;
-                        edge_c = sgl_color_mixer(sgl_color_mixer(color, *blend, alpha), border_color, edge_alpha);
-                        *blend = (border_alpha == SGL_ALPHA_MAX) ? edge_c : sgl_color_mixer(edge_c, *blend, border_alpha);
-                    }
-                    else if (real_r2 <= out_r2) {
-                        *blend = (border_alpha == SGL_ALPHA_MAX) ? border_color : sgl_color_mixer(border_color, *blend, border_alpha);
-                    }
-                    else {
-                        edge_alpha = ((out_r2_max - real_r2) * out_fix_diff) >> SGL_FIXED_SHIFT;
-                        edge_c = sgl_color_mixer(border_color, *blend, edge_alpha);
-                        *blend = (border_alpha == SGL_ALPHA_MAX) ? edge_c : sgl_color_mixer(edge_c, *blend, border_alpha);
-                    }
+            }
+            else {
+                draw_corner_span(&clip, y, cx1, cx2, row.inside, &span);
+                sgl_draw_ops_surf_area(surf, &span, color, alpha);
+            }
+
+            draw_corner_part(&clip, cx1, cx2, row.inside + 1, row.inside + row.in_edge, part);
+            for (int i = 0; i < 2; i++) {
+                for (int x = part[i].x1; x <= part[i].x2; x++) {
+                    dx = (x < cx1) ? cx1 - x : x - cx2;
+                    edge_alpha = cover[dx - row.inside - 1];
+                    blend = &buf[x - clip.x1];
+                    edge_c = sgl_color_mixer(sgl_color_mixer(color, *blend, alpha), border_color, edge_alpha);
+                    *blend = (border_alpha == SGL_ALPHA_MAX) ? edge_c : sgl_color_mixer(edge_c, *blend, border_alpha);
                 }
             }
+
+            draw_corner_part(&clip, cx1, cx2, row.inside + row.in_edge + 1, row.inside + row.in_edge + row.border, part);
+            for (int i = 0; i < 2; i++) {
+                part[i].y1 = part[i].y2 = y;
+                sgl_draw_ops_surf_area(surf, &part[i], border_color, border_alpha);
+            }
+        }
+
+        /* the coverage of outer edge follows the coverage of inner edge */
+        edge_dx = row.inside + row.in_edge + row.border;
+        draw_corner_part(&clip, cx1, cx2, edge_dx + 1, edge_dx + row.out_edge, part);
+        for (int i = 0; i < 2; i++) {
+            for (int x = part[i].x1; x <= part[i].x2; x++) {
+                dx = (x < cx1) ? cx1 - x : x - cx2;
+                edge_alpha = cover[row.in_edge + dx - edge_dx - 1];
+                blend = &buf[x - clip.x1];
+                edge_c = sgl_color_mixer(border_color, *blend, edge_alpha);
+                *blend = (border_alpha == SGL_ALPHA_MAX) ? edge_c : sgl_color_mixer(edge_c, *blend, border_alpha);
+            }
         }
         buf += surf->w;
     }
 }
 
 
+/**
+ * @brief sample the color of pixmap
+ * @param pixmap pixmap
+ * @param fx x of pixmap in fixed point
+ * @param fy y of pixmap in fixed point
+ * @return color of pixmap
+ */
+static inline sgl_color_t draw_pixmap_sample(const sgl_pixmap_t *pixmap, int32_t fx, int32_t fy)
+{
+#if (CONFIG_SGL_PIXMAP_BILINEAR_INTERP)
+    return sgl_draw_biln_color((const sgl_color_t *)pixmap->bitmap.array, pixmap->width, pixmap->height, fx, fy);
+#else
+    return *sgl_pixmap_get_buf(pixmap, fx >> SGL_FIXED_SHIFT, fy >> SGL_FIXED_SHIFT);
+#endif
+}
+
+
+/**
+ * @brief draw a span of pixmap
+ * @param dst destination of first pixel
+ * @param pixmap pixmap
+ * @param fx x of pixmap at first pixel in fixed point
+ * @param fy y of pixmap in fixed point
+ * @param scale_x step of pixmap x in fixed point
+ * @param len pixels of span
+ * @param alpha alpha of span
+ * @return none
+ * @note the row of pixmap is copied directly if the pixmap is not scaled in x
+ */
+static void draw_pixmap_span(sgl_color_t *dst, const sgl_pixmap_t *pixmap, int32_t fx, int32_t fy, int32_t scale_x, int len, uint8_t alpha)
+{
+    sgl_color_t color;
+
 #if (!CONFIG_SGL_PIXMAP_BILINEAR_INTERP)
+    if (scale_x == (1 << SGL_FIXED_SHIFT)) {
+        if (len > 0) {
+            sgl_draw_ops.copy(dst, sgl_pixmap_get_buf(pixmap, fx >> SGL_FIXED_SHIFT, fy >> SGL_FIXED_SHIFT), len, alpha);
+        }
+        return;
+    }
+#endif
+
+    for (int i = 0; i < len; i++, dst++, fx += scale_x) {
+        color = draw_pixmap_sample(pixmap, fx, fy);
+        *dst = (alpha == SGL_ALPHA_MAX) ? color : sgl_color_mixer(color, *dst, alpha);
+    }
+}
+
+
 /**
- * @brief fill a round rectangle pixmap with alpha
- * @param surf point to surface
- * @param area area of rectangle that you want to draw
- * @param rect point to rectangle that you want to draw
- * @param radius radius of round
- * @param pixmap pixmap of rectangle
- * @param alpha alpha of rectangle
+ * @brief draw a span of pixmap that is zoomed by integer factor
+ * @param dst destination of first pixel
+ * @param src row of pixmap
+ * @param x x of first pixel relative to the rectangle
+ * @param zoom integer zoom factor of x
+ * @param len pixels of span
+ * @param alpha alpha of span
  * @return none
+ * @note the row is copied directly if it is not zoomed, otherwise every source pixel is
+ *       filled or blended as a run of zoom pixels
  */
-void sgl_draw_fill_rect_pixmap(sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *rect, int16_t radius, const sgl_pixmap_t *pixmap, uint8_t alpha)
+static void draw_pixmap_zoom_span(sgl_color_t *dst, const sgl_color_t *src, int32_t x, int16_t zoom, int len, uint8_t alpha)
 {
-    sgl_area_t clip = SGL_AREA_INVALID;
-    sgl_color_t *buf = NULL, *blend = NULL, *pbuf = (sgl_color_t *)pixmap->bitmap.array;
-    
-    sgl_surf_clip_area_return(surf, area, &clip);
-    if (!sgl_area_selfclip(&clip, rect)) return;
+    int run;
 
-    const int32_t rect_w = rect->x2 - rect->x1 + 1;
-    const int32_t rect_h = rect->y2 - rect->y1 + 1;
-    const int32_t scale_x = ((int32_t)pixmap->width << SGL_FIXED_SHIFT) / rect_w;
-    const int32_t scale_y = ((int32_t)pixmap->height << SGL_FIXED_SHIFT) / rect_h;
-    uint32_t step_x = 0, step_y = 0;
+    if (len <= 0) {
+        return;
+    }
 
-    buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
-    if (radius == 0) {
-        for (int y = clip.y1; y <= clip.y2; y++) {
-            blend = buf;
-            step_y = (scale_y * (y - rect->y1)) >> SGL_FIXED_SHIFT;
-            for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-                step_x = (scale_x * (x - rect->x1)) >> SGL_FIXED_SHIFT;
-                pbuf = sgl_pixmap_get_buf(pixmap, step_x, step_y);
-                *blend = (alpha == SGL_ALPHA_MAX ? *pbuf : sgl_color_mixer(*pbuf, *blend, alpha));
-            }
-            buf += surf->w;
-        }
+    if (zoom == 1) {
+        sgl_draw_ops.copy(dst, &src[x], len, alpha);
         return;
     }
 
-    const int cx1 = rect->x1 + radius;
-    const int cx2 = rect->x2 - radius;
-    const int cy1 = rect->y1 + radius;
-    const int cy2 = rect->y2 - radius;
+    src += x / zoom;
+    /* the first run may start in the middle of a source pixel, the last one may be cut */
+    run = sgl_min(zoom - x % zoom, len);
 
-    const int r2 = sgl_pow2(radius);
-    const int r2_max = sgl_pow2(radius + 1);
-    const int r2_diff = sgl_max(r2_max - r2, 1);
-    const int r2_fix_diff = (SGL_ALPHA_MAX << SGL_FIXED_SHIFT) / r2_diff;
-    int dy2, real_r2, cx_tmp, cy_tmp;
-    uint8_t edge_alpha;
+    if (alpha == SGL_ALPHA_MAX) {
+        sgl_color_set(dst, *src++, run);
+        dst += run;
+        len -= run;
 
-    for (int y = clip.y1; y <= clip.y2; y++) {
-        blend = buf;
-        step_y = (scale_y * (y - rect->y1)) >> SGL_FIXED_SHIFT;
-        if (y >= cy1 && y <= cy2) {
-            for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-                step_x = (scale_x * (x - rect->x1)) >> SGL_FIXED_SHIFT;
-                pbuf = sgl_pixmap_get_buf(pixmap, step_x, step_y);
-                *blend = (alpha == SGL_ALPHA_MAX ? *pbuf : sgl_color_mixer(*pbuf, *blend, alpha));
+        if (zoom == 2) {
+            for (; len >= 2; len -= 2, dst += 2, src++) {
+                dst[0] = dst[1] = *src;
             }
         }
         else {
-            cy_tmp = (y < cy1) ? cy1 : cy2;
-            dy2 = sgl_pow2(y - cy_tmp);
+            for (; len >= zoom; len -= zoom, dst += zoom, src++) {
+                sgl_color_set(dst, *src, zoom);
+            }
+        }
 
-            for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-                step_x = (scale_x * (x - rect->x1)) >> SGL_FIXED_SHIFT;
-                pbuf = sgl_pixmap_get_buf(pixmap, step_x, step_y);
+        if (len > 0) {
+            sgl_color_set(dst, *src, len);
+        }
+        return;
+    }
 
-                if (x >= cx1 && x <= cx2) {
-                    *blend = (alpha == SGL_ALPHA_MAX ? *pbuf : sgl_color_mixer(*pbuf, *blend, alpha));
-                }
-                else {
-                    cx_tmp = (x < cx1) ? cx1 : cx2;
-                    real_r2 = sgl_pow2(x - cx_tmp) + dy2;
-                    if (real_r2 >= r2_max) {
-                        if(x > cx_tmp) break; else continue;
-                    }
-                    else if (real_r2 >= r2) {
-                        edge_alpha = ((r2_max - real_r2) * r2_fix_diff) >> SGL_FIXED_SHIFT;
-                        *blend = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(*pbuf, *blend, edge_alpha) : sgl_color_mixer(sgl_color_mixer(*pbuf, *blend, edge_alpha), *blend, alpha));
-                    }
-                    else {
-                        *blend = (alpha == SGL_ALPHA_MAX ? *pbuf : sgl_color_mixer(*pbuf, *blend, alpha));
-                    }
-                }
-            }
+    while (len > 0) {
+        for (int i = 0; i < run; i++) {
+            dst[i] = sgl_color_mixer(*src, dst[i], alpha);
         }
-        buf += surf->w;
+        dst += run;
+        len -= run;
+        src ++;
+        run = sgl_min(zoom, len);
     }
 }
 
-#else
+
 /**
  * @brief fill a round rectangle pixmap with alpha
  * @param surf point to surface
@@ -377,87 +452,108 @@ void sgl_draw_fill_rect_pixmap(sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *r
 void sgl_draw_fill_rect_pixmap(sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *rect, int16_t radius, const sgl_pixmap_t *pixmap, uint8_t alpha)
 {
     sgl_area_t clip = SGL_AREA_INVALID;
-    sgl_color_t *buf = NULL, *blend = NULL, *pbuf = (sgl_color_t *)pixmap->bitmap.array, ip_color;
-    
+    sgl_color_t *buf = NULL, *blend = NULL, color;
+
     sgl_surf_clip_area_return(surf, area, &clip);
     if (!sgl_area_selfclip(&clip, rect)) return;
 
-    int cx_tmp = 0, fx = 0;
-    int cy_tmp = 0, fy = 0;
     const int32_t rect_w = rect->x2 - rect->x1 + 1;
     const int32_t rect_h = rect->y2 - rect->y1 + 1;
     const int32_t scale_x = ((int32_t)pixmap->width << SGL_FIXED_SHIFT) / rect_w;
     const int32_t scale_y = ((int32_t)pixmap->height << SGL_FIXED_SHIFT) / rect_h;
-    buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
+    const int16_t clip_w = clip.x2 - clip.x1 + 1;
+    int32_t fy;
+
+    /* the rectangle is exactly 1:1 or an integer multiple of pixmap, the pixels are copied or replicated */
+    int16_t zoom_x = (pixmap->width && rect_w % pixmap->width == 0) ? rect_w / pixmap->width : 0;
+    int16_t zoom_y = (pixmap->height && rect_h % pixmap->height == 0) ? rect_h / pixmap->height : 0;
+#if (CONFIG_SGL_PIXMAP_BILINEAR_INTERP)
+    /* the interpolation keeps the pixels unchanged only at 1:1 */
+    if (zoom_x != 1 || zoom_y != 1) {
+        zoom_x = zoom_y = 0;
+    }
+#endif
+    const bool zoom = (zoom_x != 0 && zoom_y != 0);
+    const sgl_color_t *src = NULL;
+    int32_t sy;
 
-    if (radius == 0) {
+    buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
+    if (radius == 0 && zoom) {
         for (int y = clip.y1; y <= clip.y2; y++) {
-            blend = buf;
-            fy = (int32_t)(y - rect->y1) * scale_y;
-            for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-                fx = (int32_t)(x - rect->x1) * scale_x;
-                ip_color = sgl_draw_biln_color(pbuf, pixmap->width, pixmap->height, fx, fy);
-                *blend = (alpha == SGL_ALPHA_MAX) ? ip_color : sgl_color_mixer(ip_color, *blend, alpha);
+            sy = (y - rect->y1) / zoom_y;
+            /* the opaque row repeats the row above if both are from the same pixmap row */
+            if (alpha == SGL_ALPHA_MAX && y != clip.y1 && (y - rect->y1) % zoom_y != 0) {
+                sgl_draw_ops.copy(buf, buf - surf->w, clip_w, alpha);
+            }
+            else {
+                src = sgl_pixmap_get_buf(pixmap, 0, sy);
+                draw_pixmap_zoom_span(buf, src, clip.x1 - rect->x1, zoom_x, clip_w, alpha);
             }
             buf += surf->w;
         }
         return;
     }
+    else if (radius == 0) {
+        for (int y = clip.y1; y <= clip.y2; y++) {
+            fy = scale_y * (y - rect->y1);
+            draw_pixmap_span(buf, pixmap, scale_x * (clip.x1 - rect->x1), fy, scale_x, clip_w, alpha);
+            buf += surf->w;
+        }
+        return;
+    }
 
     const int cx1 = rect->x1 + radius;
     const int cx2 = rect->x2 - radius;
     const int cy1 = rect->y1 + radius;
     const int cy2 = rect->y2 - radius;
 
-    const int r2 = sgl_pow2(radius);
-    const int r2_max = sgl_pow2(radius + 1);
-    const int r2_diff = sgl_max(r2_max - r2, 1);
-    const int r2_fix_diff = (SGL_ALPHA_MAX << SGL_FIXED_SHIFT) / r2_diff;
-    int dy2, real_r2;
+    sgl_draw_corner_t corner;
+    sgl_draw_corner_row_t row;
+    sgl_area_t span, part[2];
+    const uint8_t *cover;
     uint8_t edge_alpha;
+    int dx;
+
+    sgl_draw_corner_init(&corner, radius, -1);
 
     for (int y = clip.y1; y <= clip.y2; y++) {
-        blend = buf;
-        fy = (int32_t)(y - rect->y1) * scale_y;
+        fy = scale_y * (y - rect->y1);
+        sy = zoom ? (y - rect->y1) / zoom_y : 0;
+        src = sgl_pixmap_get_buf(pixmap, 0, sy);
         if (y >= cy1 && y <= cy2) {
-            for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-                fx = (int32_t)(x - rect->x1) * scale_x;
-                ip_color = sgl_draw_biln_color(pbuf, pixmap->width, pixmap->height, fx, fy);
-                *blend = (alpha == SGL_ALPHA_MAX) ? ip_color : sgl_color_mixer(ip_color, *blend, alpha);
+            if (zoom) {
+                draw_pixmap_zoom_span(buf, src, clip.x1 - rect->x1, zoom_x, clip_w, alpha);
+            }
+            else {
+                draw_pixmap_span(buf, pixmap, scale_x * (clip.x1 - rect->x1), fy, scale_x, clip_w, alpha);
             }
         }
         else {
-            cy_tmp = (y < cy1) ? cy1 : cy2;
-            dy2 = sgl_pow2(y - cy_tmp);
+            cover = sgl_draw_corner_get_row(&corner, (y < cy1) ? cy1 - y : y - cy2, &row);
 
-            for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-                fx = (int32_t)(x - rect->x1) * scale_x;
-                ip_color = sgl_draw_biln_color(pbuf, pixmap->width, pixmap->height, fx, fy);
+            draw_corner_span(&clip, y, cx1, cx2, row.inside, &span);
+            if (zoom) {
+                draw_pixmap_zoom_span(&buf[span.x1 - clip.x1], src, span.x1 - rect->x1, zoom_x, span.x2 - span.x1 + 1, alpha);
+            }
+            else {
+                draw_pixmap_span(&buf[span.x1 - clip.x1], pixmap, scale_x * (span.x1 - rect->x1), fy, scale_x, span.x2 - span.x1 + 1, alpha);
+            }
 
-                if (x >= cx1 && x <= cx2) {
-                    *blend = (alpha == SGL_ALPHA_MAX) ? ip_color : sgl_color_mixer(ip_color, *blend, alpha);
-                }
-                else {
-                    cx_tmp = (x < cx1) ? cx1 : cx2;
-                    real_r2 = sgl_pow2(x - cx_tmp) + dy2;
-                    if (real_r2 >= r2_max) {
-                        if(x > cx_tmp) break; else continue;
-                    }
-                    else if (real_r2 >= r2) {
-                        edge_alpha = ((r2_max - real_r2) * r2_fix_diff) >> SGL_FIXED_SHIFT;
-                        *blend = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(ip_color, *blend, edge_alpha) : 
-                                 sgl_color_mixer(sgl_color_mixer(ip_color, *blend, edge_alpha), *blend, alpha));
-                    }
-                    else {
-                        *blend = (alpha == SGL_ALPHA_MAX) ? ip_color : sgl_color_mixer(ip_color, *blend, alpha);
-                    }
+            draw_corner_part(&clip, cx1, cx2, row.inside + 1, row.inside + row.out_edge, part);
+            for (int i = 0; i < 2; i++) {
+                for (int x = part[i].x1; x <= part[i].x2; x++) {
+                    dx = (x < cx1) ? cx1 - x : x - cx2;
+                    edge_alpha = cover[dx - row.inside - 1];
+                    color = zoom ? src[(x - rect->x1) / zoom_x] : draw_pixmap_sample(pixmap, scale_x * (x - rect->x1), fy);
+                    blend = &buf[x - clip.x1];
+                    *blend = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(color, *blend, edge_alpha) :
+                             sgl_color_mixer(sgl_color_mixer(color, *blend, edge_alpha), *blend, alpha));
                 }
             }
         }
         buf += surf->w;
     }
 }
-#endif
 
 
 /**
@@ -470,6 +566,13 @@ void sgl_draw_fill_rect_pixmap(sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *r
  */
 void sgl_draw_rect(sgl_surf_t *surf, sgl_area_t *area, sgl_rect_t *rect, sgl_draw_rect_t *desc)
 {
+#if (CONFIG_SGL_DISPLAY_LIST)
+    if (unlikely(sgl_dlist_is_recording(surf))) {
+        sgl_dlist_rect(area, rect, desc);
+        return;
+    }
+#endif
+
     if (desc->pixmap == NULL) {
         if (desc->border == 0) {
             sgl_draw_fill_rect(surf, area, rect, desc->radius, desc->color, desc->alpha);
@@ -42,6 +42,14 @@
 void sgl_draw_fill_ring(sgl_surf_t *surf, sgl_area_t *area, int16_t cx, int16_t cy, int16_t radius_in, int16_t radius_out, sgl_color_t color, uint8_t alpha)
 {
     sgl_area_t clip = SGL_AREA_MAX;
+
+#if (CONFIG_SGL_DISPLAY_LIST)
+    if (unlikely(sgl_dlist_is_recording(surf))) {
+        sgl_dlist_fill_ring(area, cx, cy, radius_in, radius_out, color, alpha);
+        return;
+    }
+#endif
+
     sgl_surf_clip_area_return(surf, area, &clip);
     if (unlikely(alpha == SGL_ALPHA_MIN)) return;
 
@@ -64,41 +72,56 @@ void sgl_draw_fill_ring(sgl_surf_t *surf, sgl_area_t *area, int16_t cx, int16_t
     sgl_color_t edge_c;
     sgl_color_t *blend, *buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
     int dx2, dy2;
+    int16_t hole = -1, in_edge = -1, solid = -1, out = -1;
+    int16_t j_hole, j_in_edge, j_solid;
+    sgl_area_t part[2];
 
-    for (int y = clip.y1; y <= clip.y2; y++) {
-        blend = buf;
+    for (int y = clip.y1; y <= clip.y2; y++, buf += surf->w) {
         dy2 = sgl_pow2(2 * y - cy2);
+        out = sgl_draw_circle_half(out, out_r2_max, dy2);
+        if (out == 0) {
+            continue;
+        }
 
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            dx2 = sgl_pow2(2 * x - cx2) + dy2;
-            if (dx2 >= out_r2_max) {
-                if (x > cx) break;
-                continue;
-            }
-
-            if (dx2 <= in_r2) {
-                if (x < cx) {
-                    int skip = cx - x;
-                    blend += skip;
-                    x += skip;
-                }
-                continue;
-            }
+        /* the parts are hole, inner edge, solid and outer edge, from the center to outside */
+        hole = sgl_draw_circle_half(hole, in_r2 + 1, dy2);
+        in_edge = sgl_draw_circle_half(in_edge, in_r2_max + 1, dy2);
+        solid = sgl_draw_circle_half(solid, out_r2 + 1, dy2);
+        j_hole = sgl_min(hole, out);
+        j_in_edge = sgl_min(sgl_max(in_edge, j_hole), out);
+        j_solid = sgl_min(sgl_max(solid, j_in_edge), out);
 
-            if (dx2 <= in_r2_max) {
+        sgl_draw_circle_part(&clip, cx, j_hole + 1, j_in_edge, part);
+        for (int i = 0; i < 2; i++) {
+            blend = &buf[part[i].x1 - clip.x1];
+            for (int x = part[i].x1; x <= part[i].x2; x++, blend++) {
+                dx2 = sgl_pow2(2 * x - cx2) + dy2;
                 edge_alpha = ((dx2 - in_r2) * in_fix) >> SGL_FIXED_SHIFT;
                 edge_c = sgl_color_mixer(color, *blend, edge_alpha);
                 *blend = use_alpha ? sgl_color_mixer(edge_c, *blend, alpha) : edge_c;
             }
-            else if (dx2 <= out_r2) {
-                *blend = use_alpha ? sgl_color_mixer(color, *blend, alpha) : color;
-            }
-            else {
+        }
+
+        sgl_draw_circle_part(&clip, cx, j_in_edge + 1, j_solid, part);
+        if (j_in_edge == 0) {
+            /* there is no hole in this row, the solid part of both halves is one span */
+            part[0].x2 = part[1].x2;
+            part[1].x1 = part[1].x2 + 1;
+        }
+        for (int i = 0; i < 2; i++) {
+            part[i].y1 = part[i].y2 = y;
+            sgl_draw_ops_surf_area(surf, &part[i], color, alpha);
+        }
+
+        sgl_draw_circle_part(&clip, cx, j_solid + 1, out, part);
+        for (int i = 0; i < 2; i++) {
+            blend = &buf[part[i].x1 - clip.x1];
+            for (int x = part[i].x1; x <= part[i].x2; x++, blend++) {
+                dx2 = sgl_pow2(2 * x - cx2) + dy2;
                 edge_alpha = ((out_r2_max - dx2) * out_fix) >> SGL_FIXED_SHIFT;
                 edge_c = sgl_color_mixer(color, *blend, edge_alpha);
                 *blend = use_alpha ? sgl_color_mixer(edge_c, *blend, alpha) : edge_c;
             }
         }
-        buf += surf->w;
     }
 }
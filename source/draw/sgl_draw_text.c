@@ -26,6 +26,8 @@
 #include <sgl_log.h>
 #include <sgl_draw.h>
 #include <sgl_math.h>
+#include <sgl_mm.h>
+#include <string.h>
 
 
 #if (CONFIG_SGL_FONT_COMPRESSED)
@@ -50,7 +52,7 @@ typedef struct {
     sgl_font_rle_state_t state;
 } sgl_font_rle_t;
 
-static sgl_font_rle_t font_rle = {
+static sgl_thread_local sgl_font_rle_t font_rle = {
     .rdp = 0,
     .in = NULL,
     .bpp = 0,
@@ -177,6 +179,135 @@ static inline void font_rle_init(const uint8_t * in, uint8_t bpp)
     font_rle.prev_v = 0;
     font_rle.count = 0;
 }
+
+
+/**
+ * @brief Convert the decompressed values of a line to coverage, then it is an A8 mask
+ * @param cover the decompressed values, they are replaced by coverage
+ * @param len the number of values
+ * @param bpp bits per pixel of font
+ * @return none
+ */
+static inline void font_cover_line(uint8_t *cover, int32_t len, uint8_t bpp)
+{
+    const uint8_t *opa_table = (bpp == 4) ? sgl_opa4_table : (bpp == 2) ? sgl_opa2_table : NULL;
+
+    if (opa_table != NULL) {
+        for (int32_t i = 0; i < len; i++) {
+            cover[i] = opa_table[cover[i]];
+        }
+    }
+    else if (bpp == 1) {
+        for (int32_t i = 0; i < len; i++) {
+            cover[i] = cover[i] ? SGL_ALPHA_MAX : SGL_ALPHA_MIN;
+        }
+    }
+}
+
+
+#if (CONFIG_SGL_FONT_GLYPH_CACHE_SIZE > 0)
+/* number of glyphs that can be cached, the memory of them is limited by CONFIG_SGL_FONT_GLYPH_CACHE_SIZE */
+#define  SGL_FONT_GLYPH_ENTRY_NUM           (64)
+
+/**
+ * @brief cached glyph, the decompressed coverage of whole glyph box
+ * @font: font of glyph
+ * @ch_index: index of the character in the font table
+ * @stamp: last used stamp, the entry of the smallest stamp is evicted first
+ * @size: bytes of coverage
+ * @cover: A8 coverage, box_w * box_h bytes
+ */
+typedef struct font_glyph_entry {
+    const sgl_font_t    *font;
+    uint32_t            ch_index;
+    uint32_t            stamp;
+    uint32_t            size;
+    uint8_t             *cover;
+} font_glyph_entry_t;
+
+
+/**
+ * @brief glyph cache, every draw thread has its own cache, so it is not locked
+ * @entry: cached glyphs
+ * @stamp: use counter
+ * @size: bytes of all of cached glyphs
+ */
+static sgl_thread_local struct {
+    font_glyph_entry_t  entry[SGL_FONT_GLYPH_ENTRY_NUM];
+    uint32_t            stamp;
+    uint32_t            size;
+} glyph_cache;
+
+
+/**
+ * @brief find or decompress the cached coverage of glyph
+ * @param font Pointer to the font structure containing character data
+ * @param ch_index Index of the character in the font table
+ * @return coverage of whole glyph box, NULL if the glyph is larger than cache or memory is not enough
+ * @note the font is the key of cache, so it must not be freed while it is used
+ */
+static const uint8_t* font_glyph_cache_get(const sgl_font_t *font, uint32_t ch_index)
+{
+    const uint8_t font_w = font->table[ch_index].box_w;
+    const uint8_t font_h = font->table[ch_index].box_h;
+    const uint32_t size = (uint32_t)font_w * font_h;
+    font_glyph_entry_t *entry = NULL, *lru = NULL;
+
+    glyph_cache.stamp ++;
+
+    for (int i = 0; i < SGL_FONT_GLYPH_ENTRY_NUM; i++) {
+        entry = &glyph_cache.entry[i];
+        if (entry->cover != NULL && entry->ch_index == ch_index && entry->font == font) {
+            entry->stamp = glyph_cache.stamp;
+            return entry->cover;
+        }
+    }
+
+    if (size > CONFIG_SGL_FONT_GLYPH_CACHE_SIZE) {
+        return NULL;
+    }
+
+    /* evict the least recently used glyphs until there are a free entry and enough budget */
+    while (1) {
+        entry = NULL;
+        lru = NULL;
+        for (int i = 0; i < SGL_FONT_GLYPH_ENTRY_NUM; i++) {
+            if (glyph_cache.entry[i].cover == NULL) {
+                entry = &glyph_cache.entry[i];
+            }
+            else if (lru == NULL || glyph_cache.entry[i].stamp < lru->stamp) {
+                lru = &glyph_cache.entry[i];
+            }
+        }
+
+        if (entry != NULL && glyph_cache.size + size <= CONFIG_SGL_FONT_GLYPH_CACHE_SIZE) {
+            break;
+        }
+
+        glyph_cache.size -= lru->size;
+        sgl_free(lru->cover);
+        lru->cover = NULL;
+    }
+
+    entry->cover = sgl_malloc(size);
+    if (entry->cover == NULL) {
+        return NULL;
+    }
+
+    font_rle_init(&font->bitmap[font->table[ch_index].bitmap_index], font->bpp);
+    for (int y = 0; y < font_h; y++) {
+        decompress_line(&entry->cover[y * font_w], font_w);
+    }
+    font_cover_line(entry->cover, size, font->bpp);
+
+    entry->font = font;
+    entry->ch_index = ch_index;
+    entry->stamp = glyph_cache.stamp;
+    entry->size = size;
+    glyph_cache.size += size;
+    return entry->cover;
+}
+#endif // !CONFIG_SGL_FONT_GLYPH_CACHE_SIZE
 #endif // (!CONFIG_SGL_FONT_COMPRESSED)
 
 
@@ -200,10 +331,7 @@ void sgl_draw_character(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y
     const uint8_t font_w = font->table[ch_index].box_w;
     const uint8_t font_h = font->table[ch_index].box_h;
 
-    uint8_t shift = 0;
-    uint32_t pixel_index, rel_x, rel_y;
-    uint16_t byte_index, alpha_dot = 0;
-    sgl_color_t color_mix, *buf = NULL, *blend = NULL;
+    sgl_color_t *buf = NULL;
     sgl_area_t clip;
 
     sgl_area_t text_rect = {
@@ -221,43 +349,31 @@ void sgl_draw_character(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y
         return;
     }
 
+    const int16_t len = clip.x2 - clip.x1 + 1;
     buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
 #if (CONFIG_SGL_FONT_COMPRESSED)
     if (font->compress == 0) {
 #endif // (!CONFIG_SGL_FONT_COMPRESSED == 0)
         for (int y = clip.y1; y <= clip.y2; y++) {
-            blend = buf;
-            rel_y = y - text_rect.y1;
-
-            for (int x = clip.x1; x <= clip.x2; x++) {
-                rel_x = x - text_rect.x1;
-                pixel_index = rel_y * font_w + rel_x;
-
-                if  (font->bpp == 4) {
-                    byte_index = pixel_index >> 1;
-                    alpha_dot = sgl_opa4_table[(pixel_index & 1) ? (dot[byte_index] & 0x0F) : (dot[byte_index] >> 4)];
-                }
-                else if (font->bpp == 2) {
-                    byte_index = pixel_index >> 2;
-                    shift = (3 - (pixel_index & 0x3)) * 2;
-                    alpha_dot = sgl_opa2_table[(dot[byte_index] >> shift) & 0x03];
-                }
-                else if (font->bpp == 1) {
-                    byte_index = pixel_index >> 3;
-                    shift = 7 - (pixel_index & 0x7);
-                    alpha_dot = ((dot[byte_index] >> shift) & 0x01) ? SGL_ALPHA_MAX : SGL_ALPHA_MIN;
-                }
-
-                color_mix = sgl_color_mixer(color, *blend, alpha_dot);
-                *blend = sgl_color_mixer(color_mix, *blend, alpha);
-                blend++;
-            }
+            sgl_draw_ops.mask(buf, dot, (y - text_rect.y1) * font_w + (clip.x1 - text_rect.x1), len, font->bpp, color, alpha);
             buf += surf->w;
         }
 #if (CONFIG_SGL_FONT_COMPRESSED)
     }  /* support compressed font */
     else {
+#if (CONFIG_SGL_FONT_GLYPH_CACHE_SIZE > 0)
+        /* the glyph is decompressed once, then every band blits its rows from cache */
+        const uint8_t *glyph = font_glyph_cache_get(font, ch_index);
+        if (glyph != NULL) {
+            for (int y = clip.y1; y <= clip.y2; y++) {
+                sgl_draw_ops.mask(buf, glyph, (y - text_rect.y1) * font_w + (clip.x1 - text_rect.x1), len, 8, color, alpha);
+                buf += surf->w;
+            }
+            return;
+        }
+#endif
         uint8_t line_buf[128] = {0};
+        uint8_t *cover = &line_buf[clip.x1 - text_rect.x1];
         font_rle_init(dot, font->bpp);
 
         for (int y = text_rect.y1; y < clip.y1; y++) {
@@ -265,22 +381,11 @@ void sgl_draw_character(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y
         }
 
         for (int y = clip.y1; y <= clip.y2; y++) {
-            blend = buf;
             decompress_line(line_buf, font_w);
 
-            for (int x = clip.x1; x <= clip.x2; x++) {
-                if (font->bpp == 4) {
-                    color_mix = sgl_color_mixer(color, *blend, sgl_opa4_table[line_buf[x - text_rect.x1]]);
-                }
-                else if (font->bpp == 2) {
-                    color_mix = sgl_color_mixer(color, *blend, sgl_opa2_table[line_buf[x - text_rect.x1]]);
-                }
-                else if (font->bpp == 1) {
-                    color_mix = sgl_color_mixer(color, *blend, line_buf[x - text_rect.x1] ? SGL_ALPHA_MAX : SGL_ALPHA_MIN);
-                }
-                *blend = sgl_color_mixer(color_mix, *blend, alpha);
-                blend++;
-            }
+            font_cover_line(cover, len, font->bpp);
+
+            sgl_draw_ops.mask(buf, cover, 0, len, 8, color, alpha);
             buf += surf->w;
         }
     }
@@ -288,6 +393,27 @@ void sgl_draw_character(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y
 }
 
 
+/**
+ * @brief free the decompressed glyphs that are cached by the calling thread
+ * @param none
+ * @return none
+ * @note every draw thread has its own cache, so it is called by each of them before it exits
+ */
+void sgl_font_glyph_cache_free(void)
+{
+#if (CONFIG_SGL_FONT_COMPRESSED) && (CONFIG_SGL_FONT_GLYPH_CACHE_SIZE > 0)
+    for (int i = 0; i < SGL_FONT_GLYPH_ENTRY_NUM; i++) {
+        if (glyph_cache.entry[i].cover != NULL) {
+            sgl_free(glyph_cache.entry[i].cover);
+            glyph_cache.entry[i].cover = NULL;
+        }
+    }
+
+    glyph_cache.size = 0;
+#endif
+}
+
+
 /**
  * @brief Draw a string on the surface with alpha blending
  * @param surf Pointer to the surface where the string will be drawn
@@ -305,6 +431,13 @@ void sgl_draw_string(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, c
     uint32_t ch_index;
     uint32_t unicode = 0;
 
+#if (CONFIG_SGL_DISPLAY_LIST)
+    if (unlikely(sgl_dlist_is_recording(surf))) {
+        sgl_dlist_string(area, x, y, str, color, alpha, font);
+        return;
+    }
+#endif
+
     while (*str) {
         str += sgl_utf8_to_unicode(str, &unicode);
         ch_index = sgl_search_unicode_ch_index(font, unicode);
@@ -357,6 +490,245 @@ void sgl_draw_string_mult_line(sgl_surf_t *surf, sgl_area_t *area, int16_t x, in
 }
 
 
+/**
+ * @brief decode a character of text layout
+ * @param str Pointer to the string
+ * @param unicode [out] unicode of character
+ * @return bytes of character, the invalid byte is skipped as one character
+ */
+static inline uint32_t text_layout_next(const char *str, uint32_t *unicode)
+{
+    uint32_t len = 1;
+
+    if (*str == '\n') {
+        *unicode = '\n';
+    }
+    else {
+        len = sgl_utf8_to_unicode(str, unicode);
+    }
+
+    return len ? len : 1;
+}
+
+
+/**
+ * @brief update the layout of text
+ * @param layout Pointer to the layout
+ * @param str Pointer to the string
+ * @param font Pointer to the font structure containing character data
+ * @return int, 0 if success, -1 if failed, the layout is invalid then
+ * @note it allocates memory, so it should be called by the owner object out of drawing, such as SGL_EVENT_DRAW_INIT
+ */
+int sgl_text_layout_update(sgl_text_layout_t *layout, const char *str, const sgl_font_t *font)
+{
+    uint32_t count = 0, unicode = 0, ch_index;
+    const char *s = str;
+
+    layout->font = NULL;
+
+    while (*s) {
+        s += text_layout_next(s, &unicode);
+        count ++;
+    }
+
+    if (count >= SGL_TEXT_LAYOUT_NEWLINE) {
+        SGL_LOG_ERROR("sgl_text_layout_update: text is too long");
+        return -1;
+    }
+
+    /* the empty text has one glyph of memory, so that the valid layout always has buffer */
+    if (layout->glyph == NULL || layout->capacity < count) {
+        const uint32_t capacity = count ? count : 1;
+        uint16_t *glyph = sgl_realloc(layout->glyph, capacity * sizeof(uint16_t));
+        if (glyph == NULL) {
+            SGL_LOG_ERROR("sgl_text_layout_update: alloc failed");
+            sgl_text_layout_free(layout);
+            return -1;
+        }
+        layout->glyph = glyph;
+        layout->capacity = capacity;
+    }
+
+    layout->width = 0;
+    for (s = str, count = 0; *s; count++) {
+        s += text_layout_next(s, &unicode);
+        ch_index = sgl_search_unicode_ch_index(font, unicode);
+        layout->glyph[count] = (unicode == '\n') ? SGL_TEXT_LAYOUT_NEWLINE : ch_index;
+        layout->width += (font->table[ch_index].adv_w >> 4);
+    }
+
+    layout->count = count;
+    layout->text = str;
+    layout->font = font;
+    return 0;
+}
+
+
+/**
+ * @brief free the layout of text
+ * @param layout Pointer to the layout
+ * @return none
+ */
+void sgl_text_layout_free(sgl_text_layout_t *layout)
+{
+    if (layout->glyph != NULL) {
+        sgl_free(layout->glyph);
+    }
+
+    memset(layout, 0, sizeof(sgl_text_layout_t));
+}
+
+
+/**
+ * @brief check whether the layout is built from the string and font and is not invalidated
+ * @param layout Pointer to the layout
+ * @param str Pointer to the string
+ * @param font Pointer to the font structure containing character data
+ * @return true if the layout can be drawn instead of the string
+ * @note it is called by every band, so the string is not scanned, the owner invalidates the layout
+ *       by sgl_text_layout_invalidate() when the string is changed
+ */
+bool sgl_text_layout_is_valid(const sgl_text_layout_t *layout, const char *str, const sgl_font_t *font)
+{
+    return layout->font != NULL && layout->font == font && layout->text == str;
+}
+
+
+/**
+ * @brief get the glyph index of layout
+ * @param layout Pointer to the layout
+ * @param i index of glyph
+ * @return Index of the character in the font table
+ */
+static inline uint32_t text_layout_glyph(const sgl_text_layout_t *layout, uint16_t i)
+{
+    if (unlikely(layout->glyph[i] == SGL_TEXT_LAYOUT_NEWLINE)) {
+        return sgl_search_unicode_ch_index(layout->font, '\n');
+    }
+
+    return layout->glyph[i];
+}
+
+
+/**
+ * @brief get the height of layout which is wrapped in width, the same as sgl_font_get_string_height()
+ * @param layout Pointer to the layout
+ * @param width width of the rect area
+ * @param line_space peer line space
+ * @return height of text
+ */
+int32_t sgl_text_layout_get_height(const sgl_text_layout_t *layout, int16_t width, uint8_t line_space)
+{
+    const sgl_font_t *font = layout->font;
+    int16_t offset_x = 0, ch_width, lines = 1;
+
+    for (uint16_t i = 0; i < layout->count; i++) {
+        if (layout->glyph[i] == SGL_TEXT_LAYOUT_NEWLINE) {
+            lines ++;
+            offset_x = 0;
+            continue;
+        }
+
+        ch_width = (font->table[layout->glyph[i]].adv_w >> 4);
+
+        if ((offset_x + ch_width) >= width) {
+            offset_x = 0;
+            lines ++;
+        }
+
+        offset_x += ch_width;
+    }
+
+    return lines * (font->font_height + line_space);
+}
+
+
+/**
+ * @brief Draw a text layout on the surface with alpha blending, the same as sgl_draw_string()
+ * @param surf Pointer to the surface where the text will be drawn
+ * @param area Pointer to the area where the text will be drawn
+ * @param x X coordinate of the top-left corner of the text
+ * @param y Y coordinate of the top-left corner of the text
+ * @param layout Pointer to the valid layout of text
+ * @param color Foreground color of the text
+ * @param alpha Alpha value for blending
+ * @return none
+ */
+void sgl_draw_text_layout(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, const sgl_text_layout_t *layout, sgl_color_t color, uint8_t alpha)
+{
+    const sgl_font_t *font = layout->font;
+    const sgl_font_table_t *glyph;
+    uint32_t ch_index;
+
+#if (CONFIG_SGL_DISPLAY_LIST)
+    if (unlikely(sgl_dlist_is_recording(surf))) {
+        sgl_dlist_text_layout(area, x, y, layout, color, alpha);
+        return;
+    }
+#endif
+
+    const int16_t x1 = sgl_max(area->x1, surf->x1), x2 = sgl_min(area->x2, surf->x2);
+
+    if (y > surf->y2 || y + font->font_height - 1 < surf->y1) {
+        return;
+    }
+
+    /* the glyphs out of surface are skipped without calling sgl_draw_character() */
+    for (uint16_t i = 0; i < layout->count; i++) {
+        ch_index = text_layout_glyph(layout, i);
+        glyph = &font->table[ch_index];
+
+        if (x + glyph->ofs_x <= x2 && x + glyph->ofs_x + glyph->box_w - 1 >= x1) {
+            sgl_draw_character(surf, area, x, y, ch_index, color, alpha, font);
+        }
+        x += (glyph->adv_w >> 4);
+    }
+}
+
+
+/**
+ * @brief Draw a text layout on the surface with multiple lines, the same as sgl_draw_string_mult_line()
+ * @param surf Pointer to the surface where the text will be drawn
+ * @param area Pointer to the area where the text will be drawn
+ * @param x X coordinate of the top-left corner of the text
+ * @param y Y coordinate of the top-left corner of the text
+ * @param layout Pointer to the valid layout of text
+ * @param color Foreground color of the text
+ * @param alpha Alpha value for blending
+ * @param line_margin Margin between lines
+ * @return none
+ * @note the lines out of surface are skipped without drawing
+ */
+void sgl_draw_text_layout_mult_line(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, const sgl_text_layout_t *layout, sgl_color_t color, uint8_t alpha, uint8_t line_margin)
+{
+    const sgl_font_t *font = layout->font;
+    const int16_t x2 = sgl_min(area->x2, surf->x2);
+    int16_t ch_width, x_off = x;
+    uint16_t ch_index;
+
+    for (uint16_t i = 0; i < layout->count && y <= surf->y2; i++) {
+        if (layout->glyph[i] == SGL_TEXT_LAYOUT_NEWLINE) {
+            x_off = x;
+            y += (font->font_height + line_margin);
+            continue;
+        }
+
+        ch_index = layout->glyph[i];
+        ch_width = (font->table[ch_index].adv_w >> 4);
+
+        if ((x_off + ch_width) > area->x2) {
+            x_off = x;
+            y += (font->font_height + line_margin);
+        }
+
+        if (y + font->font_height - 1 >= surf->y1 && x_off + font->table[ch_index].ofs_x <= x2) {
+            sgl_draw_character(surf, area, x_off, y, ch_index, color, alpha, font);
+        }
+        x_off += ch_width;
+    }
+}
+
+
 /**
  * @brief generate mask for an character
  * @param mask Pointer to the mask buffer
@@ -81,77 +81,201 @@ sgl_color_t sgl_draw_biln_color(const sgl_color_t *buffer, int16_t w, int16_t h,
 
 
 /**
- * @brief transform a surface
- * @param dst destination surface
- * @param src source surface
- * @param area area of surface
- * @param x x coordinate of surface
- * @param y y coordinate of surface
- * @param rotation rotation angle
+ * @brief floor division of 64-bit value by a positive divisor
+ */
+static inline int64_t xform_floor_div(int64_t a, int64_t b)
+{
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+
+/**
+ * @brief narrow the step range [k1, k2] to the steps that keep u0 + du * k inside [0, limit)
+ * @param u0 coordinate at step 0 (16.16 fixed point)
+ * @param du coordinate increment per step (16.16 fixed point)
+ * @param limit size of source in 16.16 fixed point
+ * @param k1 [in][out] first step
+ * @param k2 [in][out] last step
  * @return none
- * @note This function has implemented angle normalization to the range of 0 to 360 degrees.
+ * @note the result is exact, so the inner loop does not have to check the source bounds
  */
-void sgl_draw_xform_surf(sgl_surf_t *dst, sgl_surf_t *src, sgl_area_t *area, int16_t x, int16_t y, int16_t rotation)
+static void xform_span_clip(int64_t u0, int32_t du, int64_t limit, int32_t *k1, int32_t *k2)
 {
-    const int32_t sin_val = sgl_sin(rotation);
-    const int32_t cos_val = sgl_cos(rotation);
+    int64_t lo, hi;
 
-    const int16_t half_w = src->w / 2;
-    const int16_t half_h = src->h / 2;
+    if (du > 0) {
+        lo = -xform_floor_div(u0, du);
+        hi = xform_floor_div(limit - 1 - u0, du);
+    }
+    else if (du < 0) {
+        lo = -xform_floor_div(limit - 1 - u0, -du);
+        hi = xform_floor_div(u0, -du);
+    }
+    else {
+        if (u0 >= 0 && u0 < limit) {
+            return;
+        }
+        lo = 1;
+        hi = 0;
+    }
+
+    if (lo > *k1) {
+        *k1 = (int32_t)sgl_min(lo, (int64_t)*k2 + 1);
+    }
+    if (hi < *k2) {
+        *k2 = (int32_t)sgl_max(hi, (int64_t)*k1 - 1);
+    }
+}
 
-    const int16_t x1r = (cos_val * (-half_w) - sin_val * (-half_h)) / SGL_SIN_FIXED_ONE;
-    const int16_t y1r = (sin_val * (-half_w) + cos_val * (-half_h)) / SGL_SIN_FIXED_ONE;
 
-    const int16_t x2r = (cos_val * half_w - sin_val * (-half_h)) / SGL_SIN_FIXED_ONE;
-    const int16_t y2r = (sin_val * half_w + cos_val * (-half_h)) / SGL_SIN_FIXED_ONE;
+/**
+ * @brief get a source pixel by bilinear interpolate, the pixels out of source repeat the edge
+ * @param src source surface
+ * @param u x coordinate of sample (16.16 fixed point, pixel centers are at 0.5)
+ * @param v y coordinate of sample (16.16 fixed point, pixel centers are at 0.5)
+ * @return interpolated color
+ */
+static inline sgl_color_t xform_biln_pixel(sgl_surf_t *src, int32_t u, int32_t v)
+{
+    int32_t x0 = (u - 0x8000) >> 16, y0 = (v - 0x8000) >> 16;
+    int32_t x1 = x0 + 1, y1 = y0 + 1;
+    uint8_t fx = ((u - 0x8000) >> 8) & 0xFF;
+    uint8_t fy = ((v - 0x8000) >> 8) & 0xFF;
+    sgl_color_t top, bottom;
 
-    const int16_t x3r = (cos_val * half_w - sin_val * half_h) / SGL_SIN_FIXED_ONE;
-    const int16_t y3r = (sin_val * half_w + cos_val * half_h) / SGL_SIN_FIXED_ONE;
+    if (x0 < 0) {
+        x0 = 0;
+        fx = 0;
+    }
+    if (x1 >= src->w) {
+        x1 = src->w - 1;
+    }
+    if (y0 < 0) {
+        y0 = 0;
+        fy = 0;
+    }
+    if (y1 >= src->h) {
+        y1 = src->h - 1;
+    }
 
-    const int16_t x4r = (cos_val * (-half_w) - sin_val * half_h) / SGL_SIN_FIXED_ONE;
-    const int16_t y4r = (sin_val * (-half_w) + cos_val * half_h) / SGL_SIN_FIXED_ONE;
+    const sgl_color_t *row0 = src->buffer + y0 * src->w;
+    const sgl_color_t *row1 = src->buffer + y1 * src->w;
 
-    const int16_t min_x = sgl_min4(x1r, x2r, x3r, x4r);
-    const int16_t min_y = sgl_min4(y1r, y2r, y3r, y4r);
-    const int16_t max_x = sgl_max4(x1r, x2r, x3r, x4r);
-    const int16_t max_y = sgl_max4(y1r, y2r, y3r, y4r);
+    top = fx ? sgl_color_mixer(row0[x1], row0[x0], fx) : row0[x0];
+    if (fy == 0) {
+        return top;
+    }
 
-    const int16_t center_x = x + half_w;
-    const int16_t center_y = y + half_h;
+    bottom = fx ? sgl_color_mixer(row1[x1], row1[x0], fx) : row1[x0];
+    return sgl_color_mixer(bottom, top, fy);
+}
 
-    const int16_t buf_width = src->w > 0 ? src->w : 1;
-    const int16_t buf_height = src->h > 0 ? src->h : 1;
 
-    if (buf_width <= 0 || buf_height <= 0) {
+/**
+ * @brief transform a surface with rotation, scale and sampling quality
+ * @param dst destination surface
+ * @param src source surface
+ * @param area clip area
+ * @param x x coordinate of the untransformed source
+ * @param y y coordinate of the untransformed source
+ * @param desc transform description
+ * @return none
+ * @note every destination row is clipped to the exact span that maps into the source,
+ *       then the source coordinates are stepped incrementally along the row.
+ */
+void sgl_draw_xform(sgl_surf_t *dst, sgl_surf_t *src, sgl_area_t *area, int16_t x, int16_t y, sgl_draw_xform_t *desc)
+{
+    sgl_area_t clip;
+    const int32_t sin_val = sgl_sin(desc->rotation);
+    const int32_t cos_val = sgl_cos(desc->rotation);
+    const int32_t scale_x = desc->scale_x ? desc->scale_x : SGL_XFORM_SCALE_ONE;
+    const int32_t scale_y = desc->scale_y ? desc->scale_y : SGL_XFORM_SCALE_ONE;
+
+    if (src->w <= 0 || src->h <= 0) {
         return;
     }
 
-    for (int py = min_y; py <= max_y; py++) {
-        for (int px = min_x; px <= max_x; px++) {
-            const int dst_x = center_x + px;
-            const int dst_y = center_y + py;
-            if (dst_x < area->x1 || dst_x > area->x2 || dst_y < area->y1 || dst_y > area->y2 ||
-                dst_x < dst->x1 || dst_x > dst->x2 || dst_y < dst->y1 || dst_y > dst->y2) {
-                continue;
-            }
+    /* inverse mapping, step of source coordinates per destination pixel (16.16 fixed point) */
+    const int32_t du_dx = (int32_t)(((int64_t)cos_val * 512) / scale_x);
+    const int32_t du_dy = (int32_t)(((int64_t)sin_val * 512) / scale_x);
+    const int32_t dv_dx = (int32_t)(((int64_t)-sin_val * 512) / scale_y);
+    const int32_t dv_dy = (int32_t)(((int64_t)cos_val * 512) / scale_y);
 
-            int32_t rel_x = px;
-            int32_t rel_y = py;
+    /* bounding box of the transformed source, the center is (x + w / 2, y + h / 2) */
+    const int32_t abs_sin = sgl_abs(sin_val), abs_cos = sgl_abs(cos_val);
+    const int64_t half_w = (int64_t)src->w * scale_x, half_h = (int64_t)src->h * scale_y;
+    const int32_t ext_x = (int32_t)((abs_cos * half_w + abs_sin * half_h) >> 24) + 1;
+    const int32_t ext_y = (int32_t)((abs_sin * half_w + abs_cos * half_h) >> 24) + 1;
+    const int32_t center_x = x + src->w / 2, center_y = y + src->h / 2;
+    sgl_area_t bound = {
+        .x1 = (int16_t)sgl_max(center_x - ext_x, SGL_POS_MIN),
+        .y1 = (int16_t)sgl_max(center_y - ext_y, SGL_POS_MIN),
+        .x2 = (int16_t)sgl_min(center_x + ext_x, SGL_POS_MAX),
+        .y2 = (int16_t)sgl_min(center_y + ext_y, SGL_POS_MAX),
+    };
 
-            int32_t orig_x_fixed = cos_val * rel_x + sin_val * rel_y;
-            int32_t orig_y_fixed = -sin_val * rel_x + cos_val * rel_y;
+    if (!sgl_surf_clip(dst, area, &clip) || !sgl_area_selfclip(&clip, &bound)) {
+        return;
+    }
+
+    const int64_t limit_u = (int64_t)src->w << 16, limit_v = (int64_t)src->h << 16;
+    /* offset of pixel center to the transform center in half pixels */
+    const int32_t off_x = 2 * clip.x1 + 1 - (2 * x + src->w);
+
+    for (int32_t row = clip.y1; row <= clip.y2; row++) {
+        const int32_t off_y = 2 * row + 1 - (2 * y + src->h);
+        const int64_t u0 = (((int64_t)du_dx * off_x + (int64_t)du_dy * off_y) >> 1) + (limit_u >> 1);
+        const int64_t v0 = (((int64_t)dv_dx * off_x + (int64_t)dv_dy * off_y) >> 1) + (limit_v >> 1);
+        int32_t k1 = 0, k2 = clip.x2 - clip.x1;
 
-            int32_t src_x = (orig_x_fixed / SGL_SIN_FIXED_ONE) + half_w;
-            int32_t src_y = (orig_y_fixed / SGL_SIN_FIXED_ONE) + half_h;
+        xform_span_clip(u0, du_dx, limit_u, &k1, &k2);
+        xform_span_clip(v0, dv_dx, limit_v, &k1, &k2);
+        if (k1 > k2) {
+            continue;
+        }
 
-            int32_t src_x_fp = src_x << SGL_FIXED_SHIFT;
-            int32_t src_y_fp = src_y << SGL_FIXED_SHIFT;
+        sgl_color_t *buf = dst->buffer + (row - dst->y1) * dst->w + (clip.x1 - dst->x1) + k1;
+        int32_t u = (int32_t)(u0 + (int64_t)du_dx * k1);
+        int32_t v = (int32_t)(v0 + (int64_t)dv_dx * k1);
 
-            if (src_x >= 0 && src_x < buf_width - 1 && src_y >= 0 && src_y < buf_height - 1) {
-                sgl_color_t color = sgl_draw_biln_color(src->buffer, buf_width, buf_height, src_x_fp, src_y_fp);
-                int dst_idx = (dst_y - dst->y1) * dst->w + (dst_x - dst->x1);
-                dst->buffer[dst_idx] = color;
+        if (desc->quality == SGL_XFORM_BILINEAR) {
+            for (int32_t k = k1; k <= k2; k++) {
+                *buf++ = xform_biln_pixel(src, u, v);
+                u += du_dx;
+                v += dv_dx;
+            }
+        }
+        else {
+            for (int32_t k = k1; k <= k2; k++) {
+                *buf++ = src->buffer[(v >> 16) * src->w + (u >> 16)];
+                u += du_dx;
+                v += dv_dx;
             }
         }
     }
 }
+
+
+/**
+ * @brief transform a surface
+ * @param dst destination surface
+ * @param src source surface
+ * @param area area of surface
+ * @param x x coordinate of surface
+ * @param y y coordinate of surface
+ * @param rotation rotation angle
+ * @return none
+ * @note This function has implemented angle normalization to the range of 0 to 360 degrees.
+ *       It is sgl_draw_xform() without scale and with nearest sampling.
+ */
+void sgl_draw_xform_surf(sgl_surf_t *dst, sgl_surf_t *src, sgl_area_t *area, int16_t x, int16_t y, int16_t rotation)
+{
+    sgl_draw_xform_t desc = {
+        .rotation = rotation,
+        .scale_x = SGL_XFORM_SCALE_ONE,
+        .scale_y = SGL_XFORM_SCALE_ONE,
+        .quality = SGL_XFORM_NEAREST,
+    };
+
+    sgl_draw_xform(dst, src, area, x, y, &desc);
+}
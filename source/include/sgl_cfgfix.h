@@ -69,10 +69,34 @@ extern "C" {
 #define CONFIG_SGL_EVENT_PHY_KAY                                   (0)  /* Physical keyboard enable */
 #endif
 
+#ifndef CONFIG_SGL_DRAW_THREADS
+#define CONFIG_SGL_DRAW_THREADS                                    (0)  /* Band render worker threads, 0 is disabled */
+#endif
+
+#if (CONFIG_SGL_DRAW_THREADS && CONFIG_SGL_USE_FBDEV_VRAM)
+#error "CONFIG_SGL_DRAW_THREADS renders into draw buffers, it can not work with CONFIG_SGL_USE_FBDEV_VRAM"
+#endif
+
+#ifndef CONFIG_SGL_OPAQUE_COVER_MAX
+#define CONFIG_SGL_OPAQUE_COVER_MAX                                (4)  /* Opaque covers per band for occlusion culling, 0 is disabled */
+#endif
+
 #ifndef CONFIG_SGL_DIRTY_AREA_NUM_MAX
 #define CONFIG_SGL_DIRTY_AREA_NUM_MAX                              (16)  /* Max dirty regions for partial refresh */
 #endif
 
+#ifndef CONFIG_SGL_DIRTY_AREA_FLUSH_COST
+#define CONFIG_SGL_DIRTY_AREA_FLUSH_COST                           (1024)  /* Cost of one flush transaction, in the unit of pixel cost */
+#endif
+
+#ifndef CONFIG_SGL_DIRTY_AREA_PIXEL_COST
+#define CONFIG_SGL_DIRTY_AREA_PIXEL_COST                           (1)  /* Cost of drawing and transferring one pixel */
+#endif
+
+#ifndef CONFIG_SGL_MOVE_AREA_NUM_MAX
+#define CONFIG_SGL_MOVE_AREA_NUM_MAX                               (4)  /* Moved objects per frame that only damage exposed regions, 0 is disabled */
+#endif
+
 #ifndef CONFIG_SGL_DIRTY_AREA_TRACE
 #define CONFIG_SGL_DIRTY_AREA_TRACE                                (0)  /* Dirty region debug trace */
 #endif
@@ -123,10 +147,38 @@ extern "C" {
 #define CONFIG_SGL_FONT_COMPRESSED                                 (0)  /* Enable font compression */
 #endif
 
+#ifndef CONFIG_SGL_FONT_GLYPH_CACHE_SIZE
+#   if (CONFIG_SGL_HEAP_MEMORY_SIZE >= 65536)
+#   define CONFIG_SGL_FONT_GLYPH_CACHE_SIZE                        (4096)  /* Bytes of decompressed glyph cache per draw thread, 0 is disabled */
+#   else
+#   define CONFIG_SGL_FONT_GLYPH_CACHE_SIZE                        (0)  /* Disabled on small heap, every draw thread has its own cache */
+#   endif
+#endif
+
+#ifndef CONFIG_SGL_FONT_LOOKUP_TABLE
+#define CONFIG_SGL_FONT_LOOKUP_TABLE                               (1)  /* Per font page table of code point to glyph, 512 bytes per used page */
+#endif
+
 #ifndef CONFIG_SGL_FONT_SMALL_TABLE
 #define CONFIG_SGL_FONT_SMALL_TABLE                                (0)  /* Use small font table */
 #endif
 
+#ifndef CONFIG_SGL_EXT_IMG_BUFFER
+#define CONFIG_SGL_EXT_IMG_BUFFER                                  (256)  /* Bytes of read buffer of every ext_img, at least 16 */
+#endif
+
+#if (CONFIG_SGL_EXT_IMG_BUFFER < 16)
+#error "CONFIG_SGL_EXT_IMG_BUFFER must hold a RLE run or a pixel, it should be at least 16 bytes"
+#endif
+
+#ifndef CONFIG_SGL_IMG_ROW_INDEX_STEP
+#define CONFIG_SGL_IMG_ROW_INDEX_STEP                              (16)  /* Rows between decoder checkpoints of RLE and unzip images, 0 is disabled */
+#endif
+
+#ifndef CONFIG_SGL_IMG_CACHE_SIZE
+#define CONFIG_SGL_IMG_CACHE_SIZE                                  (0)  /* Bytes of decoded image cache shared by ext_img and unzip_img, 0 is disabled */
+#endif
+
 #ifndef CONFIG_SGL_LABEL_ROTATION
 #define CONFIG_SGL_LABEL_ROTATION                                  (0)  /* Label text rotation support */
 #endif
@@ -157,6 +209,30 @@ extern "C" {
 #   endif
 #endif
 
+#ifndef CONFIG_SGL_PERF_COUNTER
+#define CONFIG_SGL_PERF_COUNTER                                    (0)  /* Construct and blend performance counter */
+#endif
+
+#ifndef CONFIG_SGL_DISPLAY_LIST
+#define CONFIG_SGL_DISPLAY_LIST                                    (0)  /* Record draw commands once per frame and replay them in bands */
+#endif
+
+#ifndef CONFIG_SGL_DRAW_CORNER_CACHE_SIZE
+#   if (CONFIG_SGL_HEAP_MEMORY_SIZE >= 65536)
+#   define CONFIG_SGL_DRAW_CORNER_CACHE_SIZE                       (1024)  /* Bytes of rounded corner coverage cache per draw thread, 0 is disabled */
+#   else
+#   define CONFIG_SGL_DRAW_CORNER_CACHE_SIZE                       (0)  /* Disabled on small heap, every draw thread has its own cache */
+#   endif
+#endif
+
+#ifndef CONFIG_SGL_DRAW_SIMD
+#define CONFIG_SGL_DRAW_SIMD                                       (1)  /* Use SSE2/NEON span kernels if the compiler targets them */
+#endif
+
+#ifndef CONFIG_SGL_HEADLESS
+#define CONFIG_SGL_HEADLESS                                        (0)  /* Headless host framebuffer device */
+#endif
+
 #ifndef CONFIG_SGL_BOOT_LOGO
 #define CONFIG_SGL_BOOT_LOGO                                       (1)  /* Show boot logo */
 #endif
@@ -42,6 +42,8 @@ extern "C" {
 #define  SGL_OBJ_DEPTH_MAX                 (16)
 /* the maximum number of drawing buffers */
 #define  SGL_DRAW_BUFFER_MAX               (2)
+/* the bit mask of all drawing buffers */
+#define  SGL_DRAW_BUFFER_MASK              ((1 << SGL_DRAW_BUFFER_MAX) - 1)
 /* define default animation tick ms */
 #define  SGL_SYSTEM_TICK_MS                CONFIG_SGL_SYSTICK_MS
 /* define dirty area trace color */
@@ -388,6 +390,8 @@ typedef struct sgl_font {
  * @child: Pointer to the first child in the list of children.
  * @sibling: Pointer to the next sibling under the same parent.
  * @area: The logical size (width, height) of the object, used for layout and measurement.
+ * @bounds: Union of the area of the object and all of its visible descendants, updated in each harvest,
+ *          the draw task skips the whole subtree if bounds does not overlap the band.
  * @coords: The current screen position (x, y) and dimensions after layout calculation.
  * @event_fn: Callback function invoked when an event (e.g., touch, click) targets this object.
  * @event_data: User-defined context data passed to the event callback.
@@ -409,6 +413,14 @@ typedef struct sgl_font {
  * @pressed: (1 bit) Tracks whether the object is currently being pressed.
  * @page: (1 bit) Reserved for page/view switching logic (e.g., in tabbed interfaces).
  * @radius: (12 bits) Corner radius in pixels for rounded rectangle rendering (max 4095).
+ * @opaque: (1 bit) Set to 1 if the object fills its coords inset by radius and border with solid color,
+ *          the objects below it are not drawn where they are completely covered.
+ * @serial: (1 bit) [Optional] Set to 1 if the construct function keeps state from band to band,
+ *          the dirty area that contains it is never rendered by worker threads.
+ *          Only present if CONFIG_SGL_DRAW_THREADS is not 0.
+ * @dlist: (1 bit) [Optional] Set to 1 if the construct function only uses the draw functions that can be
+ *         recorded, it runs once per frame and every band replays the recorded commands.
+ *         Only present if CONFIG_SGL_DISPLAY_LIST is enabled.
  * @name: [Optional] Null-terminated string identifier for debugging or lookup.
  *        Only present if CONFIG_SGL_OBJ_USE_NAME is defined.
  */
@@ -417,6 +429,7 @@ typedef struct sgl_obj {
     struct sgl_obj  *child;
     struct sgl_obj  *sibling;
     sgl_area_t      area;
+    sgl_area_t      bounds;
     sgl_area_t      coords;
     void            (*event_fn)(sgl_event_t *e);
     void            *event_data;
@@ -434,6 +447,13 @@ typedef struct sgl_obj {
     uint16_t        pressed : 1;
     uint16_t        page : 1;
     uint16_t        radius : 12;
+    uint8_t         opaque : 1;
+#if (CONFIG_SGL_DRAW_THREADS)
+    uint8_t         serial : 1;
+#endif
+#if (CONFIG_SGL_DISPLAY_LIST)
+    uint8_t         dlist : 1;
+#endif
 #if CONFIG_SGL_OBJ_USE_NAME
     const char      *name;
 #endif
@@ -470,6 +490,12 @@ typedef struct sgl_page {
  * @xres: x resolution
  * @yres: y resolution
  * @flush_area: flush area callback function pointer, return the finished flag
+ * @flush_wait: [optional] called repeatedly while the draw task waits for a flush in flight,
+ *              for example yield, WFI or take a semaphore that is given after sgl_fbdev_flush_ready(),
+ *              NULL means busy wait
+ * @copy_area: [optional] copy the pixels of src area on screen to dst area of the same size, the areas
+ *             may overlap, it must be finished when it returns. If it is set, an opaque object that is
+ *             moved is copied on screen and only the rest of its area is drawn, NULL means always draw
  */
 typedef struct sgl_fbinfo {
     void      *buffer[SGL_DRAW_BUFFER_MAX];
@@ -477,9 +503,39 @@ typedef struct sgl_fbinfo {
     int16_t    xres;
     int16_t    yres;
     void       (*flush_area)(sgl_area_t *area, sgl_color_t *src);
+    void       (*flush_wait)(void);
+    void       (*copy_area)(sgl_area_t *dst, sgl_area_t *src);
 } sgl_fbinfo_t;
 
 
+#if (CONFIG_SGL_MOVE_AREA_NUM_MAX)
+/**
+ * @brief pending move of an object, it is resolved in next harvest
+ * @obj: object that is moved, it is not dirty for other reason
+ * @dx: x offset since last harvest
+ * @dy: y offset since last harvest
+ */
+typedef struct sgl_move {
+    sgl_obj_t         *obj;
+    int16_t           dx;
+    int16_t           dy;
+} sgl_move_t;
+
+
+/**
+ * @brief screen copy that is done before drawing dirty areas
+ * @dst: destination area
+ * @dx: x offset from source area to destination area
+ * @dy: y offset from source area to destination area
+ */
+typedef struct sgl_copy {
+    sgl_area_t        dst;
+    int16_t           dx;
+    int16_t           dy;
+} sgl_copy_t;
+#endif
+
+
 /**
  * @brief sgl framebuffer device struct
  * @fbinfo: framebuffer information, that specify the memory address of the framebuffer and resolution
@@ -487,10 +543,14 @@ typedef struct sgl_fbinfo {
  * @dirty_num: dirty area number
  * @update_flag: update to widget flag
  * @full_dirty: full dirty flag
- * @fb_swap: framebuffer swap flag
- * @fb_status: framebuffer status flag
+ * @fb_swap: index of the draw buffer that the next band is rendered into
+ * @fb_status: bit mask of the draw buffer that is being flushed, only one flush is in flight
  * @dirty: dirty area pool
  * @page: current page
+ * @move: [optional] pending moves, only present if CONFIG_SGL_MOVE_AREA_NUM_MAX is not 0
+ * @move_num: pending move number
+ * @copy: [optional] screen copies of this frame, only present if CONFIG_SGL_MOVE_AREA_NUM_MAX is not 0
+ * @copy_num: screen copy number
  */
 typedef struct sgl_fbdev {
     sgl_fbinfo_t      fbinfo;
@@ -501,6 +561,12 @@ typedef struct sgl_fbdev {
     volatile uint8_t  fb_status;
     sgl_area_t        dirty[SGL_DIRTY_AREA_NUM_MAX];
     sgl_obj_t         *active;
+#if (CONFIG_SGL_MOVE_AREA_NUM_MAX)
+    sgl_move_t        move[CONFIG_SGL_MOVE_AREA_NUM_MAX];
+    uint8_t           move_num;
+    sgl_copy_t        copy[CONFIG_SGL_MOVE_AREA_NUM_MAX];
+    uint8_t           copy_num;
+#endif
 #if (CONFIG_SGL_DIRTY_AREA_TRACE)
     sgl_area_t        trace_dirty[SGL_DIRTY_AREA_NUM_MAX];
     uint8_t           trace_dirty_num;
@@ -509,6 +575,34 @@ typedef struct sgl_fbdev {
 } sgl_fbdev_t;
 
 
+#if (CONFIG_SGL_PERF_COUNTER)
+/**
+ * @brief sgl performance counter struct, only for measurement
+ * @construct: number of construct_fn calls for SGL_EVENT_DRAW_MAIN
+ * @blend: number of pixels blended by sgl_color_mixer()
+ * @dirty_area: number of dirty areas that are drawn, every one is at least one flush transaction
+ * @dirty_pixel: number of pixels of dirty areas that are drawn
+ * @redundant: number of pixels that are added into dirty areas by merging, no object asked to redraw them
+ */
+typedef struct sgl_perf {
+    uint32_t          construct;
+    uint32_t          blend;
+    uint32_t          dirty_area;
+    uint32_t          dirty_pixel;
+    uint32_t          redundant;
+} sgl_perf_t;
+
+#if (CONFIG_SGL_DRAW_THREADS)
+#define  SGL_PERF_ADD(counter, n)                           __atomic_fetch_add(&sgl_system.perf.counter, (n), __ATOMIC_RELAXED)
+#else
+#define  SGL_PERF_ADD(counter, n)                           (sgl_system.perf.counter += (n))
+#endif
+#else
+/* the amount is still consumed, so the variables that only count it are not unused */
+#define  SGL_PERF_ADD(counter, n)                           ((void)(n))
+#endif
+
+
 /**
  * @brief sgl log print device struct
  * @logdev: log print callback function pointer
@@ -518,6 +612,7 @@ typedef struct sgl_fbdev {
  * @font: system default font
  * @rotation: buffer only for rotation
  * @angle: angle value only for rotation
+ * @perf: performance counter
  */
 typedef struct sgl_system {
     void               (*logdev)(const char *str);
@@ -531,6 +626,9 @@ typedef struct sgl_system {
     sgl_color_t        *rotation;
     uint16_t            angle;
 #endif
+#if (CONFIG_SGL_PERF_COUNTER)
+    sgl_perf_t          perf;
+#endif
 } sgl_system_t;
 
 
@@ -638,12 +736,8 @@ int sgl_fbdev_register_dev(sgl_color_t *buffer0, sgl_color_t *buffer1, uint32_t
  */
 static inline void sgl_fbdev_flush_ready(void)
 {
-    sgl_system.fbdev.fb_status |= (1 << sgl_system.fbdev.fb_swap);
-
-    /* change to next framebuffer */
-    if (sgl_system.fbdev.fbinfo.buffer[1] != NULL) {
-        sgl_system.fbdev.surf.buffer = (sgl_color_t *)sgl_system.fbdev.fbinfo.buffer[sgl_system.fbdev.fb_swap ^= 1];
-    }
+    /* the buffer in flight is free, the draw task has already switched to the other buffer */
+    sgl_system.fbdev.fb_status = 0;
 }
 
 
@@ -654,7 +748,7 @@ static inline void sgl_fbdev_flush_ready(void)
  */
 static inline bool sgl_fbdev_flush_wait_ready(sgl_fbdev_t *fbdev)
 {
-    return (fbdev->fb_status & (1 << sgl_system.fbdev.fb_swap)) == 0;
+    return (fbdev->fb_status & (1 << fbdev->fb_swap)) != 0;
 }
 
 
@@ -1158,6 +1252,69 @@ static inline bool sgl_obj_is_hidden(sgl_obj_t *obj)
 }
 
 
+/**
+ * @brief set object opaque flag
+ * @param obj point to object
+ * @param opaque true if the object fills its coords inset by radius and border with solid color
+ * @return none
+ * @note the widget should update the flag when its color alpha or pixmap is changed
+ */
+static inline void sgl_obj_set_opaque(sgl_obj_t *obj, bool opaque)
+{
+    SGL_ASSERT(obj != NULL);
+    obj->opaque = opaque ? 1 : 0;
+}
+
+
+/**
+ * @brief check object is opaque
+ * @param obj point to object
+ * @return true if object is opaque, otherwise false
+ */
+static inline bool sgl_obj_is_opaque(sgl_obj_t *obj)
+{
+    SGL_ASSERT(obj != NULL);
+    return obj->opaque == 1;
+}
+
+
+/**
+ * @brief set object to serial draw, that is the object must be drawn band by band in order
+ * @param obj point to object
+ * @return none
+ * @note it is only meaningful when CONFIG_SGL_DRAW_THREADS is enabled, otherwise it does nothing
+ */
+static inline void sgl_obj_set_serial_draw(sgl_obj_t *obj)
+{
+    SGL_ASSERT(obj != NULL);
+#if (CONFIG_SGL_DRAW_THREADS)
+    obj->serial = 1;
+#else
+    SGL_UNUSED(obj);
+#endif
+}
+
+
+/**
+ * @brief set object to be drawn by display list, the construct function runs once per frame
+ * @param obj point to object
+ * @param enable true if the construct function only uses sgl_draw_rect, sgl_draw_fill_rect,
+ *        sgl_draw_string, sgl_draw_circle, sgl_draw_fill_ring and sgl_draw_fill_arc
+ * @return none
+ * @note it is only meaningful when CONFIG_SGL_DISPLAY_LIST is enabled, otherwise it does nothing
+ */
+static inline void sgl_obj_set_display_list(sgl_obj_t *obj, bool enable)
+{
+    SGL_ASSERT(obj != NULL);
+#if (CONFIG_SGL_DISPLAY_LIST)
+    obj->dlist = enable ? 1 : 0;
+#else
+    SGL_UNUSED(obj);
+    SGL_UNUSED(enable);
+#endif
+}
+
+
 /**
  * @brief set object to clickable
  * @param obj point to object
@@ -1693,6 +1850,30 @@ static inline sgl_obj_t* sgl_screen_act(void)
 }
 
 
+#if (CONFIG_SGL_PERF_COUNTER)
+/**
+ * @brief get performance counter
+ * @param none
+ * @return pointer to performance counter
+ */
+static inline sgl_perf_t* sgl_perf_get(void)
+{
+    return &sgl_system.perf;
+}
+
+
+/**
+ * @brief reset performance counter
+ * @param none
+ * @return none
+ */
+static inline void sgl_perf_reset(void)
+{
+    sgl_system.perf = (sgl_perf_t){ .construct = 0, .blend = 0, .dirty_area = 0, .dirty_pixel = 0, .redundant = 0 };
+}
+#endif
+
+
 /**
  * @brief sgl task handler function with sync mode
  * @param none
@@ -1759,6 +1940,7 @@ void sgl_obj_delete_sync(sgl_obj_t *obj);
 static inline sgl_color_t sgl_color_mixer(sgl_color_t fg_color, sgl_color_t bg_color, uint8_t factor)
 {
     sgl_color_t ret;
+    SGL_PERF_ADD(blend, 1);
 #if (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_RGB332)
 
     ret.ch.red   = bg_color.ch.red + ((fg_color.ch.red - bg_color.ch.red) * (factor >> 5) >> 3);
@@ -1959,6 +2141,16 @@ static inline void sgl_area_selfmerge(sgl_area_t *merge, sgl_area_t *area)
 int sgl_init(void);
 
 
+/**
+ * @brief sgl global deinitialization
+ * @param none
+ * @return none
+ * @note It stops the draw worker threads, and frees their draw buffers and the draw caches of every thread.
+ *       The objects are not freed, sgl_init() initializes the memory pool again if sgl is used again.
+ */
+void sgl_deinit(void);
+
+
 /**
  * @brief initialize object
  * @param obj object
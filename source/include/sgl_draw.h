@@ -39,6 +39,10 @@ extern "C" {
 #define  SGL_ARC_MODE_NORMAL_SMOOTH                         (2)
 #define  SGL_ARC_MODE_RING_SMOOTH                           (3)
 
+#define  SGL_XFORM_SCALE_ONE                                (256)
+#define  SGL_XFORM_NEAREST                                  (0)
+#define  SGL_XFORM_BILINEAR                                 (1)
+
 
 /**
  * @brief rect description
@@ -145,6 +149,126 @@ typedef struct sgl_draw_icon {
 } sgl_draw_icon_t;
 
 
+/**
+ * @brief surface transform description, the source is rotated and scaled around its center
+ * @rotation: rotation angle in degree, clockwise
+ * @scale_x: horizontal scale, SGL_XFORM_SCALE_ONE means 1.0, 0 is treated as 1.0
+ * @scale_y: vertical scale, SGL_XFORM_SCALE_ONE means 1.0, 0 is treated as 1.0
+ * @quality: SGL_XFORM_NEAREST or SGL_XFORM_BILINEAR
+ */
+typedef struct sgl_draw_xform {
+    int16_t          rotation;
+    uint16_t         scale_x;
+    uint16_t         scale_y;
+    uint8_t          quality;
+} sgl_draw_xform_t;
+
+
+/**
+ * @brief decoded image in image cache
+ * @next: next entry, the entries are linked from the most recently used one
+ * @src: pixmap identity, such as the address of pixmap description, NULL if the entry is dropped
+ * @frame: frame index of pixmap, such as the index of a pixmap sequence
+ * @size: bytes of entry, it is counted in the budget of cache
+ * @width: width of image
+ * @height: height of image
+ * @refs: number of users, the entry is not evicted while it is used
+ * @color: width * height native colors
+ * @alpha: width * height pixel alpha, NULL if the image is opaque
+ */
+typedef struct sgl_img_cache_entry {
+    struct sgl_img_cache_entry *next;
+    const void       *src;
+    uint32_t         frame;
+    uint32_t         size;
+    uint16_t         width;
+    uint16_t         height;
+    uint16_t         refs;
+    sgl_color_t      *color;
+    uint8_t          *alpha;
+} sgl_img_cache_entry_t;
+
+
+/**
+ * @brief image cache statistics
+ * @hits: lookups that found the image
+ * @misses: lookups that did not find the image
+ * @evictions: entries that are evicted to make room for other images
+ * @entries: number of entries in cache
+ * @size: bytes of entries in cache
+ */
+typedef struct sgl_img_cache_stats {
+    uint32_t         hits;
+    uint32_t         misses;
+    uint32_t         evictions;
+    uint32_t         entries;
+    uint32_t         size;
+} sgl_img_cache_stats_t;
+
+
+/**
+ * @brief convert a row of pixmap pixels to framebuffer native colors
+ * @param color [out] native colors, it can be the destination surface
+ * @param alpha [out] alpha of pixels, SGL_ALPHA_MAX for the format without alpha, NULL to skip it
+ * @param src bytes of pixels
+ * @param len number of pixels
+ * @return none
+ */
+typedef void (*sgl_pixmap_row_cvt_t)(sgl_color_t *color, uint8_t *alpha, const uint8_t *src, uint32_t len);
+
+
+/* bytes of a pixel of SGL_PIXMAP_FMT_NATIVE_ALPHA pixmap */
+#define  SGL_PIXMAP_NATIVE_ALPHA_BYTES      (sizeof(sgl_color_t) + 1)
+
+
+/**
+ * @brief check if the pixels of a pixel format have alpha
+ * @param format pixel format of pixmap
+ * @return true if the pixels have alpha
+ */
+static inline bool sgl_pixmap_format_has_alpha(uint8_t format)
+{
+    return format == SGL_PIXMAP_FMT_ARGB2222 || format == SGL_PIXMAP_FMT_ARGB4444 || format == SGL_PIXMAP_FMT_ARGB8888 ||
+           format == SGL_PIXMAP_FMT_RLE_ARGB2222 || format == SGL_PIXMAP_FMT_RLE_ARGB4444 || format == SGL_PIXMAP_FMT_RLE_ARGB8888 ||
+           format == SGL_PIXMAP_FMT_TILE_ARGB8888 || format == SGL_PIXMAP_FMT_NATIVE_ALPHA;
+}
+
+
+/**
+ * tiled pixmap, SGL_PIXMAP_FMT_TILE_RGB888 and SGL_PIXMAP_FMT_TILE_ARGB8888:
+ *      [tile width: u16][tile height: u16][offset of tile: u32 x (tiles + 1)][tiles]
+ *      all of the numbers are little endian, the offsets are from the start of bitmap, tile i
+ *      is the bytes from offset i to offset i + 1. the tiles are in row order, the tiles at
+ *      the right and the bottom edge are clipped by the pixmap. every tile is compressed alone
+ *      by the QOI operations, so a tile is decoded without the others:
+ *          0b00iiiiii              pixel of index i
+ *          0b01rrggbb              the differences to the previous pixel are r - 2, g - 2, b - 2
+ *          0b10gggggg 0brrrrbbbb   the green difference is g - 32, the red and blue differences
+ *                                  are r - 8 and b - 8 plus the green difference
+ *          0b11nnnnnn              the previous pixel is repeated n + 1 times, n < 62
+ *          0xfe r g b              pixel with the alpha of previous pixel
+ *          0xff r g b a            pixel
+ *      the previous pixel starts from opaque black and the index starts from zero in every tile,
+ *      index of pixel is (r * 3 + g * 5 + b * 7 + a * 11) % 64, it is updated by every operation.
+ *      tools/tile_encoder converts an image to it.
+ */
+#define  SGL_PIXMAP_TILE_HEAD_SIZE                          (4)
+#define  SGL_PIXMAP_TILE_OP_MAX                             (5)
+
+
+/**
+ * @brief decoder state of a tile of tiled pixmap
+ * @px: previous pixel, ARGB8888
+ * @run: pixels left in current operation
+ * @index: previous pixels by the index of pixel
+ */
+typedef struct sgl_pixmap_tile_dec {
+    uint32_t         px;
+    uint32_t         run;
+    uint32_t         index[64];
+} sgl_pixmap_tile_dec_t;
+
+
 /** 
  * @brief clip area width of surface
  * @note if you want to check the area is overlap with surface, you can use this macro
@@ -237,6 +361,196 @@ static inline void sgl_surf_vline(sgl_surf_t *surf, int16_t x, int16_t y1, int16
 }
 
 
+/**
+ * @brief draw operations, the draw functions send solid spans, pixmap rows and glyph masks to it,
+ *        so that a port can offload them to 2D accelerator, such as DMA2D
+ * @fill: fill w * h pixels with color, stride is pixels of a row of destination
+ * @blend: blend color into w * h pixels with alpha
+ * @copy: copy a row of pixmap, the row is blended with alpha if alpha is not SGL_ALPHA_MAX
+ * @mask: blend color into a row by coverage of A1/A2/A4/A8 mask, index is the mask index of first pixel
+ */
+typedef struct sgl_draw_ops {
+    void (*fill)(sgl_color_t *dst, int16_t stride, int16_t w, int16_t h, sgl_color_t color);
+    void (*blend)(sgl_color_t *dst, int16_t stride, int16_t w, int16_t h, sgl_color_t color, uint8_t alpha);
+    void (*copy)(sgl_color_t *dst, const sgl_color_t *src, int16_t len, uint8_t alpha);
+    void (*mask)(sgl_color_t *dst, const uint8_t *mask, uint32_t index, int16_t len, uint8_t bpp, sgl_color_t color, uint8_t alpha);
+} sgl_draw_ops_t;
+
+
+/* the current draw operations, use sgl_draw_ops_register() to change it */
+extern sgl_draw_ops_t sgl_draw_ops;
+
+
+/**
+ * @brief register draw operations, such as a 2D accelerator of port
+ * @param ops draw operations, the NULL entry keeps software implementation,
+ *            NULL restores all of the software implementations
+ * @return none
+ * @note the operations are called by draw threads at the same time if CONFIG_SGL_DRAW_THREADS is set,
+ *       and the pixels must be written when the operation returns. register it before sgl_init()
+ *       or between frames, the table is copied, so it can be a local variable
+ */
+void sgl_draw_ops_register(const sgl_draw_ops_t *ops);
+
+
+/* software implementations of draw operations, a port can call them for the spans that are too small to offload */
+void sgl_draw_soft_fill(sgl_color_t *dst, int16_t stride, int16_t w, int16_t h, sgl_color_t color);
+void sgl_draw_soft_blend(sgl_color_t *dst, int16_t stride, int16_t w, int16_t h, sgl_color_t color, uint8_t alpha);
+void sgl_draw_soft_copy(sgl_color_t *dst, const sgl_color_t *src, int16_t len, uint8_t alpha);
+void sgl_draw_soft_mask(sgl_color_t *dst, const uint8_t *mask, uint32_t index, int16_t len, uint8_t bpp, sgl_color_t color, uint8_t alpha);
+
+
+/**
+ * @brief fill or blend color into w * h pixels by draw operations
+ * @param dst start of destination
+ * @param stride pixels of a row of destination
+ * @param w width of pixels
+ * @param h height of pixels
+ * @param color color
+ * @param alpha alpha of color, the pixels are filled if it is SGL_ALPHA_MAX
+ * @return none
+ */
+static inline void sgl_draw_ops_area(sgl_color_t *dst, int16_t stride, int16_t w, int16_t h, sgl_color_t color, uint8_t alpha)
+{
+    if (alpha == SGL_ALPHA_MAX) {
+        sgl_draw_ops.fill(dst, stride, w, h, color);
+    }
+    else {
+        sgl_draw_ops.blend(dst, stride, w, h, color, alpha);
+    }
+}
+
+
+/**
+ * @brief fill or blend color into an area of surface by draw operations
+ * @param surf point to surface
+ * @param area area to fill, it must be inside the surface, nothing is drawn if it is empty
+ * @param color color
+ * @param alpha alpha of color
+ * @return none
+ */
+static inline void sgl_draw_ops_surf_area(sgl_surf_t *surf, sgl_area_t *area, sgl_color_t color, uint8_t alpha)
+{
+    if (area->x1 > area->x2 || area->y1 > area->y2) {
+        return;
+    }
+
+    sgl_draw_ops_area(sgl_surf_get_buf(surf, area->x1 - surf->x1, area->y1 - surf->y1), surf->w,
+                      area->x2 - area->x1 + 1, area->y2 - area->y1 + 1, color, alpha);
+}
+
+
+/**
+ * @brief a row of rounded corner, the parts are from the center column of corner to outside
+ * @inside: pixels of inside color
+ * @in_edge: anti-aliasing pixels between inside and border
+ * @border: pixels of border color
+ * @out_edge: anti-aliasing pixels between border, or inside if there is no border, and outside
+ * @cover: offset of the coverage of edge pixels in table
+ */
+typedef struct sgl_draw_corner_row {
+    uint16_t         inside;
+    uint16_t         in_edge;
+    uint16_t         border;
+    uint16_t         out_edge;
+    uint16_t         cover;
+} sgl_draw_corner_row_t;
+
+
+/**
+ * @brief coverage of a quarter circle corner, the four corners of rectangle share it
+ * @radius: radius of corner
+ * @border: border width, -1 is a corner without border
+ * @row: rows of corner, row[dy - 1] is the row that is dy away from the center row, NULL if it is not cached
+ * @cover: coverage of edge pixels of all rows
+ */
+typedef struct sgl_draw_corner {
+    int16_t                     radius;
+    int16_t                     border;
+    const sgl_draw_corner_row_t *row;
+    const uint8_t               *cover;
+} sgl_draw_corner_t;
+
+
+/**
+ * @brief prepare the coverage of a corner of rounded rectangle
+ * @param corner [out] corner
+ * @param radius radius of corner
+ * @param border border width, -1 is a corner without border
+ * @return none
+ * @note the table of corner is cached by radius and border if it is not larger than CONFIG_SGL_DRAW_CORNER_CACHE_SIZE,
+ *       otherwise the rows are computed by sgl_draw_corner_get_row(), the corner is valid until next call in same thread
+ */
+void sgl_draw_corner_init(sgl_draw_corner_t *corner, int16_t radius, int16_t border);
+
+
+/**
+ * @brief get a row of corner
+ * @param corner corner that is prepared by sgl_draw_corner_init()
+ * @param dy distance to the center row of corner, 1 ~ radius
+ * @param row [out] pixel count of every part, from the center column of corner to outside
+ * @return coverage of edge pixels, inner edge first, then outer edge
+ */
+const uint8_t* sgl_draw_corner_get_row(const sgl_draw_corner_t *corner, int16_t dy, sgl_draw_corner_row_t *row);
+
+
+/**
+ * @brief free the cached corner tables of the calling thread
+ * @param none
+ * @return none
+ * @note every draw thread has its own cache, so it is called by each of them before it exits
+ */
+void sgl_draw_corner_cache_free(void);
+
+
+/**
+ * @brief get the pixels in one half of a circle row whose squared distance is less than limit
+ * @param prev result of the previous row, -1 if it is unknown
+ * @param limit squared distance in doubled coordinate
+ * @param dy2 squared distance of the row in doubled coordinate
+ * @return pixel count from the center column to outside
+ * @note the center of circle is between cx and cx + 1, so the pixel j away from it has the distance 2 * j - 1
+ *       in doubled coordinate, use limit + 1 if the pixels whose distance is equal to limit are counted.
+ *       the count of neighbouring rows is close, so the previous result is moved pixel by pixel instead
+ *       of computing the square root
+ */
+static inline int16_t sgl_draw_circle_half(int16_t prev, int32_t limit, int32_t dy2)
+{
+    int16_t j = prev;
+
+    if (j < 0) {
+        limit -= dy2;
+        return limit > 0 ? (sgl_sqrt(limit - 1) + 1) >> 1 : 0;
+    }
+
+    while (j > 0 && sgl_pow2(2 * j - 1) + dy2 >= limit) {
+        j --;
+    }
+    while (sgl_pow2(2 * j + 1) + dy2 < limit) {
+        j ++;
+    }
+    return j;
+}
+
+
+/**
+ * @brief get the pixels of a circle row that are from j1 to j2 away from the center, in left half and right half
+ * @param clip clip area
+ * @param cx center x of circle, the center is between cx and cx + 1
+ * @param j1 first pixel, 1 is the pixel next to the center
+ * @param j2 last pixel
+ * @param part [out] x range in left half and right half, a range is empty if x1 > x2
+ * @return none
+ */
+static inline void sgl_draw_circle_part(const sgl_area_t *clip, int16_t cx, int16_t j1, int16_t j2, sgl_area_t part[2])
+{
+    part[0].x1 = sgl_max(cx + 1 - j2, clip->x1);
+    part[0].x2 = sgl_min(cx + 1 - j1, clip->x2);
+    part[1].x1 = sgl_max(cx + j1, clip->x1);
+    part[1].x2 = sgl_min(cx + j2, clip->x2);
+}
+
+
 /**
  * @brief draw a wireframe rectangle with alpha
  * @param surf point to surface
@@ -385,6 +699,15 @@ void sgl_draw_icon( sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, sg
 void sgl_draw_character( sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, uint32_t ch_index, sgl_color_t color, uint8_t alpha, const sgl_font_t *font);
 
 
+/**
+ * @brief free the decompressed glyphs that are cached by the calling thread
+ * @param none
+ * @return none
+ * @note every draw thread has its own cache, so it is called by each of them before it exits
+ */
+void sgl_font_glyph_cache_free(void);
+
+
 /**
  * @brief Draw a string on the surface with alpha blending
  * @param surf Pointer to the surface where the string will be drawn
@@ -416,6 +739,111 @@ void sgl_draw_string(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, c
 void sgl_draw_string_mult_line(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, const char *str, sgl_color_t color, uint8_t alpha, const sgl_font_t *font, uint8_t line_margin);
 
 
+/* glyph of line break in text layout */
+#define  SGL_TEXT_LAYOUT_NEWLINE            (0xFFFF)
+
+/**
+ * @brief cached layout of text, the UTF-8 decoding and glyph lookup are done once when text or font is changed
+ * @glyph: glyph index of every character, SGL_TEXT_LAYOUT_NEWLINE is the '\n'
+ * @count: number of glyphs
+ * @capacity: capacity of glyph buffer
+ * @width: width of the text in one line, the same as sgl_font_get_string_width()
+ * @text: string of layout
+ * @font: font of layout, NULL if the layout is invalid
+ * @note the owner invalidates the layout by sgl_text_layout_invalidate() when its text or font is changed,
+ *       also when the text is changed in its buffer, then it updates the layout in SGL_EVENT_DRAW_INIT
+ */
+typedef struct sgl_text_layout {
+    uint16_t           *glyph;
+    uint16_t           count;
+    uint16_t           capacity;
+    int32_t            width;
+    const char         *text;
+    const sgl_font_t   *font;
+} sgl_text_layout_t;
+
+
+/**
+ * @brief update the layout of text
+ * @param layout Pointer to the layout
+ * @param str Pointer to the string
+ * @param font Pointer to the font structure containing character data
+ * @return int, 0 if success, -1 if failed, the layout is invalid then
+ * @note it allocates memory, so it should be called by the owner object out of drawing, such as SGL_EVENT_DRAW_INIT
+ */
+int sgl_text_layout_update(sgl_text_layout_t *layout, const char *str, const sgl_font_t *font);
+
+
+/**
+ * @brief free the layout of text
+ * @param layout Pointer to the layout
+ * @return none
+ */
+void sgl_text_layout_free(sgl_text_layout_t *layout);
+
+
+/**
+ * @brief invalidate the layout of text, the memory of layout is kept for next update
+ * @param layout Pointer to the layout
+ * @return none
+ * @note it should be called by the setters of owner object when text or font is changed
+ */
+static inline void sgl_text_layout_invalidate(sgl_text_layout_t *layout)
+{
+    layout->font = NULL;
+}
+
+
+/**
+ * @brief check whether the layout is built from the string and font and is not invalidated
+ * @param layout Pointer to the layout
+ * @param str Pointer to the string
+ * @param font Pointer to the font structure containing character data
+ * @return true if the layout can be drawn instead of the string
+ */
+bool sgl_text_layout_is_valid(const sgl_text_layout_t *layout, const char *str, const sgl_font_t *font);
+
+
+/**
+ * @brief get the height of layout which is wrapped in width, the same as sgl_font_get_string_height()
+ * @param layout Pointer to the layout
+ * @param width width of the rect area
+ * @param line_space peer line space
+ * @return height of text
+ */
+int32_t sgl_text_layout_get_height(const sgl_text_layout_t *layout, int16_t width, uint8_t line_space);
+
+
+/**
+ * @brief Draw a text layout on the surface with alpha blending, the same as sgl_draw_string()
+ * @param surf Pointer to the surface where the text will be drawn
+ * @param area Pointer to the area where the text will be drawn
+ * @param x X coordinate of the top-left corner of the text
+ * @param y Y coordinate of the top-left corner of the text
+ * @param layout Pointer to the valid layout of text
+ * @param color Foreground color of the text
+ * @param alpha Alpha value for blending
+ * @return none
+ */
+void sgl_draw_text_layout(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, const sgl_text_layout_t *layout, sgl_color_t color, uint8_t alpha);
+
+
+/**
+ * @brief Draw a text layout on the surface with multiple lines, the same as sgl_draw_string_mult_line()
+ * @param surf Pointer to the surface where the text will be drawn
+ * @param area Pointer to the area where the text will be drawn
+ * @param x X coordinate of the top-left corner of the text
+ * @param y Y coordinate of the top-left corner of the text
+ * @param layout Pointer to the valid layout of text
+ * @param color Foreground color of the text
+ * @param alpha Alpha value for blending
+ * @param line_margin Margin between lines
+ * @return none
+ * @note the lines out of surface are skipped without drawing
+ */
+void sgl_draw_text_layout_mult_line(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, const sgl_text_layout_t *layout, sgl_color_t color, uint8_t alpha, uint8_t line_margin);
+
+
 /**
  * @brief draw a ring on surface with alpha
  * @param surf: pointer of surface
@@ -554,6 +982,192 @@ sgl_color_t sgl_draw_biln_color(const sgl_color_t *buffer, int16_t w, int16_t h,
 void sgl_draw_xform_surf(sgl_surf_t *dst, sgl_surf_t *src, sgl_area_t *area, int16_t x, int16_t y, int16_t rotation);
 
 
+/**
+ * @brief transform a surface with rotation, scale and sampling quality
+ * @param dst destination surface
+ * @param src source surface
+ * @param area clip area
+ * @param x x coordinate of the untransformed source
+ * @param y y coordinate of the untransformed source
+ * @param desc transform description
+ * @return none
+ * @note the source pixels are copied opaquely, pixels that fall outside of the source are not touched.
+ *       The center of every destination pixel is mapped into the source, so the edges of a rotated
+ *       source are covered by the pixels whose centers fall inside it.
+ */
+void sgl_draw_xform(sgl_surf_t *dst, sgl_surf_t *src, sgl_area_t *area, int16_t x, int16_t y, sgl_draw_xform_t *desc);
+
+
+/**
+ * @brief get the row converter of a pixel format
+ * @param format pixel format of pixmap
+ * @return row converter, NULL if the format is RLE compressed or invalid
+ * @note look it up once per draw, then the rows are converted without a per pixel switch
+ */
+sgl_pixmap_row_cvt_t sgl_pixmap_get_row_cvt(uint8_t format);
+
+
+/**
+ * @brief get the bytes of pixmap that is converted by sgl_pixmap_to_native()
+ * @param src pixmap in memory
+ * @return bytes of native pixmap, 0 if the pixmap can not be converted
+ */
+uint32_t sgl_pixmap_native_size(const sgl_pixmap_t *src);
+
+
+/**
+ * @brief convert a pixmap to framebuffer native format
+ * @param dst [out] native pixmap, its bitmap points to buf
+ * @param buf [out] sgl_pixmap_native_size() bytes, it must be aligned for sgl_color_t
+ * @param src pixmap in memory, it must not be RLE compressed, the tiled pixmap is decoded
+ * @return int, 0 if success, -1 if failed
+ * @note the memory is owned by caller, convert it at load time, then draw dst by ext_img.
+ *       the source without alpha is converted to SGL_PIXMAP_FMT_NONE, the source with alpha
+ *       is converted to SGL_PIXMAP_FMT_NATIVE_ALPHA that keeps the alpha of every pixel.
+ */
+int sgl_pixmap_to_native(sgl_pixmap_t *dst, void *buf, const sgl_pixmap_t *src);
+
+
+/**
+ * @brief start to decode a tile of tiled pixmap
+ * @param dec decoder state
+ * @return none
+ */
+void sgl_pixmap_tile_dec_init(sgl_pixmap_tile_dec_t *dec);
+
+
+/**
+ * @brief decode the next pixels of a tile
+ * @param dec decoder state
+ * @param color [out] native colors, NULL to skip the pixels
+ * @param alpha [out] alpha of pixels, NULL if the alpha is not needed
+ * @param src [in/out] bytes of tile, it is moved after the decoded operations
+ * @param len bytes that are valid from src
+ * @param n number of pixels
+ * @return number of decoded pixels, it is less than n if the next operation is not in len bytes
+ * @note an operation is never split, so len of SGL_PIXMAP_TILE_OP_MAX bytes always decodes a pixel
+ */
+uint32_t sgl_pixmap_tile_decode(sgl_pixmap_tile_dec_t *dec, sgl_color_t *color, uint8_t *alpha, const uint8_t **src, uint32_t len, uint32_t n);
+
+
+#if (CONFIG_SGL_IMG_CACHE_SIZE > 0)
+/**
+ * @brief find a decoded image in image cache and use it
+ * @param src pixmap identity
+ * @param frame frame index of pixmap
+ * @return entry of image, NULL if it is not cached
+ * @note the cache is not locked, it must be used out of draw threads, such as in SGL_EVENT_DRAW_INIT,
+ *       the found entry must be released by sgl_img_cache_release()
+ */
+sgl_img_cache_entry_t* sgl_img_cache_find(const void *src, uint32_t frame);
+
+
+/**
+ * @brief allocate an entry for a decoded image and use it
+ * @param src pixmap identity
+ * @param frame frame index of pixmap
+ * @param width width of image
+ * @param height height of image
+ * @param alpha true if the image has pixel alpha
+ * @return entry of image, the caller decodes the image into it, NULL if the image is larger than
+ *         cache, the images in use fill the cache or memory is not enough
+ * @note the least recently used images that are not in use are evicted until the image fits in
+ *       CONFIG_SGL_IMG_CACHE_SIZE, the entry must be released by sgl_img_cache_release()
+ */
+sgl_img_cache_entry_t* sgl_img_cache_alloc(const void *src, uint32_t frame, uint16_t width, uint16_t height, bool alpha);
+
+
+/**
+ * @brief stop using an entry of image cache
+ * @param entry entry of image
+ * @return none
+ * @note the entry stays in cache until it is evicted, so the image can be found again
+ */
+void sgl_img_cache_release(sgl_img_cache_entry_t *entry);
+
+
+/**
+ * @brief drop the images of a pixmap from image cache, for example its data is rewritten
+ * @param src pixmap identity, NULL drops all of the images
+ * @return none
+ * @note the entry in use is not found any more, it is freed when it is released
+ */
+void sgl_img_cache_drop(const void *src);
+
+
+/**
+ * @brief get the statistics of image cache
+ * @param stats [out] statistics
+ * @return none
+ */
+void sgl_img_cache_get_stats(sgl_img_cache_stats_t *stats);
+
+
+/**
+ * @brief reset the hit, miss and eviction counters of image cache
+ * @param none
+ * @return none
+ */
+void sgl_img_cache_reset_stats(void);
+#endif // !CONFIG_SGL_IMG_CACHE_SIZE
+
+
+#if (CONFIG_SGL_DISPLAY_LIST)
+/* the recording surface of display list, do not draw into it directly */
+extern sgl_surf_t sgl_dlist_surf;
+
+/**
+ * @brief check if surface is the recording surface of display list
+ * @param surf point to surface
+ * @return true if the draw function should record a command instead of drawing
+ */
+static inline bool sgl_dlist_is_recording(sgl_surf_t *surf)
+{
+    return surf == &sgl_dlist_surf;
+}
+
+
+/**
+ * @brief reset display list, all of the commands of last frame are dropped
+ * @param none
+ * @return none
+ * @note the memory is kept for next frame
+ */
+void sgl_dlist_reset(void);
+
+
+/**
+ * @brief start to record the commands of an object
+ * @param obj object
+ * @return the recording surface, it should be passed to construct function of object,
+ *         NULL if memory is not enough
+ * @note only sgl_draw_rect, sgl_draw_fill_rect, sgl_draw_string, sgl_draw_circle,
+ *       sgl_draw_fill_ring and sgl_draw_fill_arc can be recorded
+ */
+sgl_surf_t* sgl_dlist_record(sgl_obj_t *obj);
+
+
+/**
+ * @brief replay the commands of an object into a band
+ * @param obj object
+ * @param surf surface of band
+ * @param cursor [in][out] the entry that the search starts from, entries are recorded in draw order
+ * @return true if the object is drawn, false if it is not recorded and should be drawn directly
+ */
+bool sgl_dlist_replay(sgl_obj_t *obj, sgl_surf_t *surf, uint32_t *cursor);
+
+
+/* record the draw functions, they are called by the draw functions with recording surface */
+void sgl_dlist_rect(sgl_area_t *area, sgl_rect_t *rect, sgl_draw_rect_t *desc);
+void sgl_dlist_fill_rect(sgl_area_t *area, sgl_area_t *rect, int16_t radius, sgl_color_t color, uint8_t alpha);
+void sgl_dlist_string(sgl_area_t *area, int16_t x, int16_t y, const char *str, sgl_color_t color, uint8_t alpha, const sgl_font_t *font);
+void sgl_dlist_text_layout(sgl_area_t *area, int16_t x, int16_t y, const sgl_text_layout_t *layout, sgl_color_t color, uint8_t alpha);
+void sgl_dlist_circle(sgl_area_t *area, sgl_draw_circle_t *desc);
+void sgl_dlist_fill_ring(sgl_area_t *area, int16_t cx, int16_t cy, int16_t radius_in, int16_t radius_out, sgl_color_t color, uint8_t alpha);
+void sgl_dlist_fill_arc(sgl_area_t *area, sgl_draw_arc_t *desc);
+#endif // !CONFIG_SGL_DISPLAY_LIST
+
+
 #ifdef __cplusplus
 } /*extern "C"*/
 #endif
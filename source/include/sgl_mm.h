@@ -50,6 +50,18 @@ typedef struct sgl_mm_monitor {
 } sgl_mm_monitor_t;
 
 
+#if (CONFIG_SGL_DRAW_THREADS)
+/**
+ * @brief  lock and unlock memory pool, the draw worker threads may alloc memory in construct function
+ */
+void sgl_mm_lock(void);
+void sgl_mm_unlock(void);
+#else
+#define sgl_mm_lock()                   do {} while (0)
+#define sgl_mm_unlock()                 do {} while (0)
+#endif
+
+
 /**
  * @brief  initialize memory pool
  * @param  mem_start  start address of memory pool
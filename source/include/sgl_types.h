@@ -119,7 +119,11 @@ extern "C" {
 #define  SGL_PIXMAP_FMT_RLE_ARGB4444            (10)
 #define  SGL_PIXMAP_FMT_RLE_RGB888              (11)
 #define  SGL_PIXMAP_FMT_RLE_ARGB8888            (12)
-#define  SGL_PIXMAP_FMT_MAX                     (13)
+#define  SGL_PIXMAP_FMT_TILE_RGB888             (13)
+#define  SGL_PIXMAP_FMT_TILE_ARGB8888           (14)
+/* a sgl_color_t and then an alpha byte per pixel, it is made by sgl_pixmap_to_native() */
+#define  SGL_PIXMAP_FMT_NATIVE_ALPHA            (15)
+#define  SGL_PIXMAP_FMT_MAX                     (16)
 
 
 #ifdef __GNUC__            /* gcc compiler   */
@@ -177,6 +181,17 @@ extern "C" {
 #endif
 
 
+/**
+ * @brief thread local storage for the state that is used while drawing,
+ *        only needed when bands are rendered by worker threads
+ */
+#if (CONFIG_SGL_DRAW_THREADS)
+#define  sgl_thread_local                       _Thread_local
+#else
+#define  sgl_thread_local
+#endif
+
+
 #define  sgl_check_ptr_break(ptr)               if (unlikely((ptr) == NULL)) { SGL_LOG_ERROR("Function: %s, Line: %d, "#ptr" is NULL", __func__, __LINE__); return;}
 #define  sgl_check_ptr_return(ptr, r)           if (unlikely((ptr) == NULL)) { SGL_LOG_ERROR("Function: %s, Line: %d, "#ptr" is NULL", __func__, __LINE__); return (r);}
 
@@ -82,7 +82,9 @@ void* sgl_malloc(size_t size)
 {
     uint8_t *ptr = (uint8_t*)bump_mem_start;
 
+    sgl_mm_lock();
     if (size == 0 || (bump_mem_offset + size) > mem.total_size) {
+        sgl_mm_unlock();
         return NULL;
     }
 
@@ -90,6 +92,7 @@ void* sgl_malloc(size_t size)
     bump_mem_offset += size;
     mem.used_size += size;
     mem.free_size -= size;
+    sgl_mm_unlock();
 
     return (void*)ptr;
 }
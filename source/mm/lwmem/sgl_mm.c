@@ -58,7 +58,9 @@ void sgl_mm_add_pool(void *mem_start, size_t len)
 
 void* sgl_malloc(size_t size)
 {
+    sgl_mm_lock();
     void *p = lwmem_malloc(size);
+    sgl_mm_unlock();
     if (!p)
         SGL_LOG_ERROR("out of memory");
     return p;
@@ -66,7 +68,9 @@ void* sgl_malloc(size_t size)
 
 void* sgl_realloc(void *p, size_t size)
 {
+    sgl_mm_lock();
     void *np = lwmem_realloc(p, size);
+    sgl_mm_unlock();
     if (!np)
         SGL_LOG_ERROR("out of memory");
     return np;
@@ -75,7 +79,9 @@ void* sgl_realloc(void *p, size_t size)
 void sgl_free(void *p)
 {
     if (p) {
+        sgl_mm_lock();
         lwmem_free(p);
+        sgl_mm_unlock();
     }
 }
 
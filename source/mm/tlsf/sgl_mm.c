@@ -67,7 +67,9 @@ void sgl_mm_add_pool(void *mem_start, size_t len)
 
 void* sgl_malloc(size_t size)
 {
+    sgl_mm_lock();
     void *ret = tlsf_malloc(mem_tlsf, size);
+    sgl_mm_unlock();
     if(ret == NULL) {
         SGL_LOG_ERROR("out of memory");
     }
@@ -76,7 +78,9 @@ void* sgl_malloc(size_t size)
 
 void* sgl_realloc(void *p, size_t size)
 {
+    sgl_mm_lock();
     void *ret = tlsf_realloc(mem_tlsf, p, size);
+    sgl_mm_unlock();
     if(ret == NULL) {
         SGL_LOG_ERROR("out of memory");
     }
@@ -85,7 +89,9 @@ void* sgl_realloc(void *p, size_t size)
 
 void sgl_free(void *p)
 {
+    sgl_mm_lock();
     tlsf_free(mem_tlsf, p);
+    sgl_mm_unlock();
 }
 
 sgl_mm_monitor_t sgl_mm_get_monitor(void)
@@ -65,5 +65,6 @@
 #include "widgets/textlist/sgl_textlist.h"
 #include "widgets/qrcode/sgl_qrcode.h"
 #include "components/timer/sgl_timer.h"
+#include "components/headless/sgl_headless.h"
 
 #endif // __SGL_H__
@@ -54,32 +54,37 @@ static void sgl_2dball_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
         const int r2 = sgl_max(sgl_pow2(diameter - 3), 0); 
         const int r2_fix_diff = (SGL_ALPHA_MAX  << SGL_FIXED_SHIFT) / sgl_max(r2_max - r2, 1);
         int ds_alpha = SGL_ALPHA_MIN;
+        int16_t j_in = -1, j_out = -1;
+        sgl_area_t part[2];
         sgl_color_t *blend, *buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
 
-        buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
-        for (int y = clip.y1; y <= clip.y2; y++) {
-            blend = buf;
+        for (int y = clip.y1; y <= clip.y2; y++, buf += surf->w) {
             dy2 = sgl_pow2(2 * y - cy2);
+            j_out = sgl_draw_circle_half(j_out, r2_max, dy2);
+            if (j_out == 0) {
+                continue;
+            }
+            j_in = sgl_draw_circle_half(j_in, r2, dy2);
 
-            for (int x = clip.x1; x <= clip.x2; x++, blend++) {
+            /* inside, the color is a gradient from the center, so only the edge test is skipped */
+            sgl_draw_circle_part(&clip, cx, 1, j_in, part);
+            blend = &buf[part[0].x1 - clip.x1];
+            for (int x = part[0].x1; x <= part[1].x2; x++, blend++) {
                 dx2 = sgl_pow2(2 * x - cx2) + dy2;
                 ds_alpha = dx2 * SGL_ALPHA_NUM / r2;
+                *blend = sgl_color_mixer(sgl_color_mixer(ball->bg_color, ball->color, ds_alpha), *blend, ball->alpha);
+            }
 
-                if (dx2 >= r2_max) {
-                    if(x > cx)
-                        break;
-                    continue;
-                }
-                else if (dx2 >= r2) {
+            sgl_draw_circle_part(&clip, cx, j_in + 1, j_out, part);
+            for (int i = 0; i < 2; i++) {
+                blend = &buf[part[i].x1 - clip.x1];
+                for (int x = part[i].x1; x <= part[i].x2; x++, blend++) {
+                    dx2 = sgl_pow2(2 * x - cx2) + dy2;
                     edge_alpha = ((r2_max - dx2) * r2_fix_diff) >> SGL_FIXED_SHIFT;
                     sgl_color_t color_mix = sgl_color_mixer(ball->bg_color, *blend, edge_alpha);
                     *blend = sgl_color_mixer(color_mix, *blend, ball->alpha);
                 }
-                else {
-                    *blend = sgl_color_mixer(sgl_color_mixer(ball->bg_color, ball->color, ds_alpha), *blend, ball->alpha);
-                }
             }
-            buf += surf->w;
         }
     }
 }
@@ -36,23 +36,27 @@
 static void sgl_arc_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *evt)
 {
     sgl_arc_t *arc = sgl_container_of(obj, sgl_arc_t, obj);
+    int16_t cx = (obj->coords.x2 + obj->coords.x1) / 2;
+    int16_t cy = (obj->coords.y2 + obj->coords.y1) / 2;
     int16_t tb_angle = 0;
 
     if(evt->type == SGL_EVENT_DRAW_MAIN) {
-        arc->desc.cx = (obj->coords.x2 + obj->coords.x1) / 2;
-        arc->desc.cy = (obj->coords.y2 + obj->coords.y1) / 2;
+        /* the object is not modified while drawing, the center is set in a copy */
+        sgl_draw_arc_t desc = arc->desc;
+        desc.cx = cx;
+        desc.cy = cy;
 
-        if(arc->desc.start_angle == 0 && arc->desc.end_angle == 360) {
-            sgl_draw_fill_ring(surf, &obj->area, arc->desc.cx, arc->desc.cy, arc->desc.radius_in, arc->desc.radius_out, arc->desc.color, arc->desc.alpha);
+        if(desc.start_angle == 0 && desc.end_angle == 360) {
+            sgl_draw_fill_ring(surf, &obj->area, desc.cx, desc.cy, desc.radius_in, desc.radius_out, desc.color, desc.alpha);
         }
         else {
-            sgl_draw_fill_arc(surf, &obj->area, &arc->desc);
+            sgl_draw_fill_arc(surf, &obj->area, &desc);
         }
     }
     else if(evt->type == SGL_EVENT_PRESSED ||
         evt->type == SGL_EVENT_MOVE_DOWN || evt->type == SGL_EVENT_MOVE_UP || evt->type == SGL_EVENT_MOVE_LEFT || evt->type == SGL_EVENT_MOVE_RIGHT
     ) {
-        tb_angle = sgl_atan2_angle(evt->pos.x - arc->desc.cx, evt->pos.y - arc->desc.cy);
+        tb_angle = sgl_atan2_angle(evt->pos.x - cx, evt->pos.y - cy);
         tb_angle = 360 - tb_angle;
         if ((tb_angle != arc->desc.end_angle) && tb_angle >= 0 && tb_angle <= 360) {
             arc->desc.end_angle = tb_angle;
@@ -60,7 +64,7 @@ static void sgl_arc_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *
 
         sgl_obj_set_dirty(obj);
     }
-    else if(SGL_EVENT_DRAW_INIT) {
+    else if(evt->type == SGL_EVENT_DRAW_INIT) {
         if(arc->desc.radius_out < 0) {
             arc->desc.radius_out = (obj->coords.x2 - obj->coords.x1) / 2;
         }
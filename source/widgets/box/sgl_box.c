@@ -34,6 +34,17 @@
 
 #define  SGL_BOX_SCROLL_WIDTH                  (4)
 
+/**
+ * @brief update box opaque flag, it is opaque if the background is solid color
+ * @param box box
+ * @return none
+ */
+static inline void sgl_box_update_opaque(sgl_box_t *box)
+{
+    sgl_obj_set_opaque(&box->obj, box->bg.alpha == SGL_ALPHA_MAX && box->bg.pixmap == NULL);
+}
+
+
 static void sgl_box_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *evt)
 {
     sgl_box_t *box = sgl_container_of(obj, sgl_box_t, obj);
@@ -231,6 +242,7 @@ sgl_obj_t* sgl_box_create(sgl_obj_t* parent)
     sgl_obj_set_border_width(obj, 1);
     box->bg.border_color = SGL_THEME_BORDER_COLOR;
     box->scroll_color = SGL_THEME_SCROLL_FG_COLOR;
+    sgl_box_update_opaque(box);
 
     box->x_offset = 0;
     box->y_offset = 0;
@@ -311,6 +323,7 @@ void sgl_box_set_pixmap(sgl_obj_t *obj, const sgl_pixmap_t *pixmap)
 {
     sgl_box_t *box = sgl_container_of(obj, sgl_box_t, obj);
     box->bg.pixmap = pixmap;
+    sgl_box_update_opaque(box);
     sgl_obj_set_dirty(obj);
 }
 
@@ -352,6 +365,7 @@ void sgl_box_set_alpha(sgl_obj_t *obj, uint8_t alpha)
 {
     sgl_box_t *box = sgl_container_of(obj, sgl_box_t, obj);
     box->bg.alpha = alpha;
+    sgl_box_update_opaque(box);
     sgl_obj_set_dirty(obj);
 }
 
@@ -105,6 +105,7 @@ sgl_obj_t* sgl_button_create(sgl_obj_t* parent)
     sgl_obj_set_radius(obj, SGL_THEME_RADIUS);
 
     obj->construct_fn = sgl_button_construct_cb;
+    sgl_obj_set_display_list(obj, true);
 
     button->alpha = SGL_THEME_ALPHA;
     button->color = SGL_THEME_COLOR;
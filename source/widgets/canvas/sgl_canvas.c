@@ -62,6 +62,8 @@ sgl_obj_t* sgl_canvas_create(sgl_obj_t* parent)
     sgl_obj_t *obj = &canvas->obj;
     sgl_obj_init(&canvas->obj, parent);
     obj->construct_fn = sgl_canvas_construct_cb;
+    /* the painter is user code that may keep state, so it is called on the main thread */
+    sgl_obj_set_serial_draw(obj);
 
     return obj;
 }
@@ -46,6 +46,8 @@
  *        sgl_obj_set_size(canvas, 800, 600);
  *        sgl_obj_set_pos_align(canvas, SGL_ALIGN_CENTER);
  *        sgl_canvas_set_painter_cb(canvas, painter_func);
+ *
+ *        The painter is called once per band, always on the main thread.
  */
 
 typedef void (*sgl_painter_cb_t)(sgl_surf_t *surf, sgl_area_t *area, sgl_obj_t* obj); 
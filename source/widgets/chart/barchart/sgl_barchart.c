@@ -56,6 +56,7 @@ sgl_obj_t *sgl_barchart_create(sgl_obj_t *parent)
     sgl_obj_init(obj, parent);
     obj->construct_fn = sgl_barchart_construct_cb;
     sgl_obj_set_border_width(obj, SGL_THEME_BORDER_WIDTH);
+    sgl_obj_needinit(obj);
 
     chart->alpha = SGL_ALPHA_MAX;
     chart->bg_color = SGL_THEME_BG_COLOR;
@@ -116,6 +117,7 @@ void sgl_barchart_set_series_count(sgl_obj_t *obj, uint8_t count)
     }
 
     if (count == 0) {
+        sgl_obj_needinit(obj);
         sgl_obj_set_dirty(obj);
         return;
     }
@@ -123,6 +125,7 @@ void sgl_barchart_set_series_count(sgl_obj_t *obj, uint8_t count)
     chart->series = sgl_malloc(sizeof(sgl_barchart_series_t) * count);
     if (chart->series == NULL) {
         SGL_LOG_ERROR("sgl_barchart_set_series_count: malloc failed");
+        sgl_obj_needinit(obj);
         sgl_obj_set_dirty(obj);
         return;
     }
@@ -134,6 +137,7 @@ void sgl_barchart_set_series_count(sgl_obj_t *obj, uint8_t count)
     }
 
     chart->series_count = count;
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
 
@@ -150,6 +154,7 @@ void sgl_barchart_set_series_y_array(sgl_obj_t *obj, uint8_t index,
 
     chart->series[index].y_data = y_data;
     chart->series[index].point_count = point_count;
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
 
@@ -165,6 +170,7 @@ void sgl_barchart_set_x_labels(sgl_obj_t *obj, const char **labels, uint8_t coun
 void sgl_barchart_update(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
 
@@ -182,6 +188,7 @@ void sgl_barchart_update_value(sgl_obj_t *obj, uint8_t series_index, uint16_t po
         return;
     }
 
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
 
@@ -569,6 +576,10 @@ static void sgl_barchart_draw_series(sgl_surf_t *surf, sgl_obj_t *obj,
 static void sgl_barchart_construct_cb(sgl_surf_t *surf, sgl_obj_t *obj, sgl_event_t *evt)
 {
     sgl_barchart_t *chart = sgl_container_of(obj, sgl_barchart_t, obj);
+    if (evt->type == SGL_EVENT_DRAW_INIT) {
+        sgl_barchart_update_axis_auto(chart);
+        return;
+    }
     if (evt->type != SGL_EVENT_DRAW_MAIN) return;
     if (obj->area.x2 < surf->x1 || obj->area.x1 > surf->x2 || obj->area.y2 < surf->y1 || obj->area.y1 > surf->y2) return;
 
@@ -585,8 +596,6 @@ static void sgl_barchart_construct_cb(sgl_surf_t *surf, sgl_obj_t *obj, sgl_even
     };
     sgl_draw_rect(surf, &obj->area, &obj->coords, &bg_desc);
 
-    sgl_barchart_update_axis_auto(chart);
-
     sgl_area_t plot_rect;
     if (!sgl_barchart_calc_plot_rect(obj, chart, &full_rect, &plot_rect)) return;
 
@@ -603,6 +612,10 @@ static void sgl_barchart_construct_cb(sgl_surf_t *surf, sgl_obj_t *obj, sgl_even
             chart->option_bits.open_anim_enable = 0U;
             chart->option_bits.open_anim_playing = 0U;
             anim_active = false;
+#if (CONFIG_SGL_DRAW_THREADS)
+            /* the animation is done, the chart can be drawn by band render threads again */
+            obj->serial = 0;
+#endif
         } else {
             int32_t extent;
 #if (CONFIG_SGL_ANIMATION)
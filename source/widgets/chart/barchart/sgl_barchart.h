@@ -159,6 +159,8 @@ void sgl_barchart_set_x_labels(sgl_obj_t *obj, const char **labels, uint8_t coun
 /**
  * @brief Request chart redraw with current data
  * @param obj barchart object
+ * @note call it after the data arrays are modified in-place, the auto scaled axis range is
+ *       computed again before the next draw, sgl_obj_set_dirty() alone keeps the old range
  */
 void sgl_barchart_update(sgl_obj_t *obj);
 
@@ -201,6 +203,7 @@ static inline void sgl_barchart_enable_axis_auto_scale(sgl_obj_t *obj, sgl_barch
     SGL_ASSERT(obj != NULL);
     sgl_barchart_t *chart = sgl_container_of(obj, sgl_barchart_t, obj);
     sgl_barchart_get_axis(chart, axis)->flag_bits.auto_scale = enable ? 1U : 0U;
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
 
@@ -480,6 +483,10 @@ static inline void sgl_barchart_enable_open_anim(sgl_obj_t *obj, bool enable)
     sgl_barchart_t *chart = sgl_container_of(obj, sgl_barchart_t, obj);
     chart->option_bits.open_anim_enable = enable ? 1U : 0U;
     chart->option_bits.open_anim_playing = 0U;
+    /* the animation state is updated by the draw callback, so it is drawn on the main thread */
+    if (enable) {
+        sgl_obj_set_serial_draw(obj);
+    }
     sgl_obj_set_dirty(obj);
 }
 
@@ -88,6 +88,7 @@ sgl_obj_t* sgl_linechart_create(sgl_obj_t *parent)
     sgl_obj_init(obj, parent);
     obj->construct_fn = sgl_linechart_construct_cb;
     sgl_obj_set_border_width(obj, SGL_THEME_BORDER_WIDTH);
+    sgl_obj_needinit(obj);
 
     chart->alpha = SGL_ALPHA_MAX;
     chart->bg_color = SGL_THEME_BG_COLOR;
@@ -156,6 +157,7 @@ void sgl_linechart_set_series_count(sgl_obj_t *obj, uint8_t count)
     }
 
     if (count == 0) {
+        sgl_obj_needinit(obj);
         sgl_obj_set_dirty(obj);
         return;
     }
@@ -163,6 +165,7 @@ void sgl_linechart_set_series_count(sgl_obj_t *obj, uint8_t count)
     sgl_linechart_series_t *series = sgl_malloc(sizeof(sgl_linechart_series_t) * count);
     if (series == NULL) {
         SGL_LOG_ERROR("sgl_linechart_set_series_count: malloc failed");
+        sgl_obj_needinit(obj);
         sgl_obj_set_dirty(obj);
         return;
     }
@@ -188,6 +191,7 @@ void sgl_linechart_set_series_count(sgl_obj_t *obj, uint8_t count)
 
     chart->series = series;
     chart->series_count = count;
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
 
@@ -213,6 +217,7 @@ void sgl_linechart_set_series_data(sgl_obj_t *obj, uint8_t index,
     s->y_data = y_data;
     s->point_count = point_count;
  
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
  
@@ -254,6 +259,7 @@ void sgl_linechart_update_value(sgl_obj_t *obj, uint8_t series_index, uint16_t p
         return;
     }
 
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
  
@@ -504,8 +510,19 @@ static int32_t sgl_linechart_get_effective_step(const sgl_linechart_axis_t *axis
 }
 
 
+/**
+ * @brief Set axis range
+ */
+static inline void sgl_linechart_axis_set_range(sgl_linechart_axis_t *axis, int32_t min, int32_t max)
+{
+    axis->min = min;
+    axis->max = max;
+}
+
+
 /**
  * @brief Update axis min/max when auto-scale is enabled
+ * @note it is called by SGL_EVENT_DRAW_INIT on the main thread, the draw callback only reads the axis
  */
 static void sgl_linechart_update_axis_auto(sgl_linechart_t *chart)
 {
@@ -534,41 +551,35 @@ static void sgl_linechart_update_axis_auto(sgl_linechart_t *chart)
     if (data_min_x == INT32_MAX || data_min_y == INT32_MAX) {
         /* No data, keep previous or set default ranges */
         if (chart->x_axis.flag_bits.auto_scale) {
-            chart->x_axis.min = 0;
-            chart->x_axis.max = 10;
+            sgl_linechart_axis_set_range(&chart->x_axis, 0, 10);
         }
         if (chart->y_axis.flag_bits.auto_scale) {
-            chart->y_axis.min = 0;
-            chart->y_axis.max = 10;
+            sgl_linechart_axis_set_range(&chart->y_axis, 0, 10);
         }
         return;
     }
 
     if (chart->x_axis.flag_bits.auto_scale) {
         if (data_min_x == data_max_x) {
-            chart->x_axis.min = data_min_x - 1;
-            chart->x_axis.max = data_max_x + 1;
+            sgl_linechart_axis_set_range(&chart->x_axis, data_min_x - 1, data_max_x + 1);
         }
         else {
             int32_t range = data_max_x - data_min_x;
             int32_t margin = range / 10;
             if (margin <= 0) margin = 1;
-            chart->x_axis.min = data_min_x - margin;
-            chart->x_axis.max = data_max_x + margin;
+            sgl_linechart_axis_set_range(&chart->x_axis, data_min_x - margin, data_max_x + margin);
         }
     }
 
     if (chart->y_axis.flag_bits.auto_scale) {
         if (data_min_y == data_max_y) {
-            chart->y_axis.min = data_min_y - 1;
-            chart->y_axis.max = data_max_y + 1;
+            sgl_linechart_axis_set_range(&chart->y_axis, data_min_y - 1, data_max_y + 1);
         }
         else {
             int32_t range = data_max_y - data_min_y;
             int32_t margin = range / 10;
             if (margin <= 0) margin = 1;
-            chart->y_axis.min = data_min_y - margin;
-            chart->y_axis.max = data_max_y + margin;
+            sgl_linechart_axis_set_range(&chart->y_axis, data_min_y - margin, data_max_y + margin);
         }
     }
 }
@@ -906,7 +917,11 @@ static void sgl_linechart_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_eve
 {
     sgl_linechart_t *chart = sgl_container_of(obj, sgl_linechart_t, obj);
 
-    if (evt->type != SGL_EVENT_DRAW_MAIN) {
+    if (evt->type == SGL_EVENT_DRAW_INIT) {
+        sgl_linechart_update_axis_auto(chart);
+        return;
+    }
+    else if (evt->type != SGL_EVENT_DRAW_MAIN) {
         return;
     }
 
@@ -975,8 +990,6 @@ static void sgl_linechart_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_eve
     }
 
     /* Update auto-scale axes based on series data */
-    sgl_linechart_update_axis_auto(chart);
-
     /* Handle open animation (clip visible plot area) */
     sgl_area_t plot_clip = plot_rect;
 
@@ -995,6 +1008,10 @@ static void sgl_linechart_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_eve
             chart->option_bits.open_anim_enable = 0U;
             chart->option_bits.open_anim_playing = 0U;
             anim_active              = false;
+#if (CONFIG_SGL_DRAW_THREADS)
+            /* the animation is done, the chart can be drawn by band render threads again */
+            obj->serial = 0;
+#endif
         }
         else {
             int32_t extent;
@@ -261,16 +261,27 @@ void sgl_linechart_set_series_y_array(sgl_obj_t *obj, uint8_t index,
  * @param count  number of labels
  */
 void sgl_linechart_set_x_labels(sgl_obj_t *obj, const char **labels, uint8_t count);
+
+
+/**
+ * @brief Request redraw after one value is modified in-place, the axis range is computed again
+ * @param obj          linechart object
+ * @param series_index series index
+ * @param point_index  point index inside the series
+ */
 void sgl_linechart_update_value(sgl_obj_t *obj, uint8_t series_index, uint16_t point_index);
  
  
 /**
  * @brief Request chart to redraw with latest data.
  *        Use this if you modify data in-place without re-binding arrays.
+ * @note the auto scaled axis range is computed again before the next draw,
+ *       sgl_obj_set_dirty() alone redraws the new data with the old range
  */
 static inline void sgl_linechart_update(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
  
@@ -308,6 +319,7 @@ static inline void sgl_linechart_enable_axis_auto_scale(sgl_obj_t *obj, sgl_line
     sgl_linechart_t *chart = sgl_container_of(obj, sgl_linechart_t, obj);
     sgl_linechart_axis_t *a = sgl_linechart_get_axis(chart, axis);
     a->flag_bits.auto_scale = enable ? 1U : 0U;
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
 
@@ -715,6 +727,10 @@ static inline void sgl_linechart_enable_open_anim(sgl_obj_t *obj, bool enable)
     sgl_linechart_t *chart = sgl_container_of(obj, sgl_linechart_t, obj);
     chart->option_bits.open_anim_enable = enable ? 1U : 0U;
     chart->option_bits.open_anim_playing = 0U;
+    /* the animation state is updated by the draw callback, so it is drawn on the main thread */
+    if (enable) {
+        sgl_obj_set_serial_draw(obj);
+    }
     sgl_obj_set_dirty(obj);
 }
 
@@ -480,6 +480,10 @@ static void sgl_piechart_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
                         pie->option_bits.open_anim_playing = 0U;
                         anim_active            = false;
                         reveal_end_angle       = base_angle + 360;
+#if (CONFIG_SGL_DRAW_THREADS)
+                        /* the animation is done, the chart can be drawn by band render threads again */
+                        obj->serial = 0;
+#endif
                     }
                     else {
                         int32_t angle_step;
@@ -354,6 +354,10 @@ static inline void sgl_piechart_enable_open_anim(sgl_obj_t *obj, bool enable)
     sgl_piechart_t *pie = sgl_container_of(obj, sgl_piechart_t, obj);
     pie->option_bits.open_anim_enable = enable ? 1U : 0U;
     pie->option_bits.open_anim_playing = 0U; /* reset state so next draw will restart animation */
+    /* the animation state is updated by the draw callback, so it is drawn on the main thread */
+    if (enable) {
+        sgl_obj_set_serial_draw(obj);
+    }
     sgl_obj_set_dirty(obj);
 }
 
@@ -117,28 +117,20 @@ static void sgl_checkbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
     SGL_ASSERT(checkbox->font != NULL);
 
     if(evt->type == SGL_EVENT_DRAW_MAIN) {
-        if(checkbox->status) {
-            checkbox->icon = &checked_icon;
-        }
-        else {
-            checkbox->icon = &unchecked_icon;
-        }
-
-        if (checkbox->icon) {
-            text_x = checkbox->icon->width + 2;
-        }
+        /* the object is not modified while drawing, the icon follows the status */
+        const sgl_icon_pixmap_t *icon = checkbox->status ? &checked_icon : &unchecked_icon;
 
+        text_x = icon->width + 2;
         align_pos = sgl_get_text_pos(&obj->coords, checkbox->font, checkbox->text, text_x, SGL_ALIGN_CENTER);
 
-        if (checkbox->icon) {
-            icon_y = ((obj->coords.y2 - obj->coords.y1) - (checkbox->icon->height)) / 2 + 1;
-            sgl_draw_icon(surf, &obj->area, align_pos.x, obj->coords.y1 + icon_y, checkbox->color, checkbox->alpha, checkbox->icon);
-        }
+        icon_y = ((obj->coords.y2 - obj->coords.y1) - (icon->height)) / 2 + 1;
+        sgl_draw_icon(surf, &obj->area, align_pos.x, obj->coords.y1 + icon_y, checkbox->color, checkbox->alpha, icon);
 
         sgl_draw_string(surf, &obj->area, align_pos.x + text_x, align_pos.y, checkbox->text, checkbox->color, checkbox->alpha, checkbox->font);
     }
     else if(evt->type == SGL_EVENT_PRESSED) {
         checkbox->status = !checkbox->status;
+        checkbox->icon = checkbox->status ? &checked_icon : &unchecked_icon;
         sgl_obj_set_dirty(obj);
     }
     else if(evt->type == SGL_EVENT_DRAW_INIT) {
@@ -250,6 +242,7 @@ void sgl_checkbox_set_status(sgl_obj_t *obj, bool status)
 {
     sgl_checkbox_t *checkbox = sgl_container_of(obj, sgl_checkbox_t, obj);
     checkbox->status = status;
+    checkbox->icon = status ? &checked_icon : &unchecked_icon;
     sgl_obj_set_dirty(obj);
 }
 
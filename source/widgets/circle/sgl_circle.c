@@ -45,10 +45,12 @@ static void sgl_circle_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
     sgl_circle_t *circle = sgl_container_of(obj, sgl_circle_t, obj);
     
     if(evt->type == SGL_EVENT_DRAW_MAIN) {
-        circle->desc.cx = (circle->obj.coords.x1 + circle->obj.coords.x2) / 2;
-        circle->desc.cy = (circle->obj.coords.y1 + circle->obj.coords.y2) / 2;
+        /* the object is not modified while drawing, the center is set in a copy */
+        sgl_draw_circle_t desc = circle->desc;
+        desc.cx = (obj->coords.x1 + obj->coords.x2) / 2;
+        desc.cy = (obj->coords.y1 + obj->coords.y2) / 2;
 
-        sgl_draw_circle(surf, &obj->area, &circle->desc);
+        sgl_draw_circle(surf, &obj->area, &desc);
     }
 }
 
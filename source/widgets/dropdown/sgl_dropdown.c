@@ -71,9 +71,10 @@ static void sgl_dropdown_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
     const int item_height = sgl_font_get_height(dropdown->font) + 2 * SGL_DROPDOWN_OPTION_SPACE;
     const int item_pad = sgl_max(obj->radius, obj->border + SGL_DROPDOWN_OPTION_PAD);
 
-    if (dropdown->option_h == 0) {
+    /* the closed height is taken by the first event that is not a draw, DRAW_INIT comes before any draw */
+    if (dropdown->option_h == 0 && evt->type != SGL_EVENT_DRAW_MAIN) {
         dropdown->option_h = sgl_obj_get_height(obj);
-    };
+    }
     const int list_h = dropdown->option_h * dropdown->max_visible_item;
     sgl_dropdown_item_t *item = dropdown->head;
 
@@ -245,6 +246,7 @@ sgl_obj_t* sgl_dropdown_create(sgl_obj_t* parent)
     sgl_obj_t *obj = &dropdown->obj;
     sgl_obj_init(&dropdown->obj, parent);
     obj->construct_fn = sgl_dropdown_construct_cb;
+    obj->needinit = 1;
     sgl_obj_set_border_width(obj, 1);
     sgl_obj_set_clickable(obj);
     sgl_obj_set_movable(obj);
@@ -32,6 +32,9 @@
 #include <string.h>
 #include "sgl_ext_img.h"
 
+/* pixels of raw pixmap that are converted on the stack before they are blended */
+#define SGL_EXT_IMG_SPAN_SIZE     (32)
+
 static inline void ext_img_rle_init(sgl_ext_img_t *img)
 {
     SGL_ASSERT(img != NULL);
@@ -39,90 +42,672 @@ static inline void ext_img_rle_init(sgl_ext_img_t *img)
     img->remainder = 0;
 }
 
-static inline void rle_decompress_line(sgl_ext_img_t *img, sgl_area_t *coords, sgl_area_t *area, sgl_color_t *out)
+/**
+ * @brief get the bytes of pixmap at address
+ * @param img ext_img object
+ * @param addr address of bytes
+ * @param end end address of the bytes that will be used, the read buffer does not read after it
+ * @param len [in] bytes that must be valid, [out] bytes that are valid from the returned pointer
+ * @return pointer to the bytes
+ * @note the pixmap in memory is returned directly, the external one is served from the read buffer,
+ *       a miss refills the buffer from addr by one read() call
+ */
+static inline const uint8_t* ext_img_fetch(sgl_ext_img_t *img, uintptr_t addr, uintptr_t end, uint32_t *len)
+{
+    uint32_t size;
+
+    if (img->read == NULL) {
+        *len = UINT32_MAX;
+        return (const uint8_t*)addr;
+    }
+
+    if (addr < img->buffer_addr || addr + *len > img->buffer_addr + img->buffer_len) {
+        size = (end - addr < SGL_EXT_IMG_BUFFER_SIZE) ? (uint32_t)(end - addr) : SGL_EXT_IMG_BUFFER_SIZE;
+        size = sgl_max(size, *len);
+        img->read(addr, img->flash_buffer, size);
+        img->buffer_addr = addr;
+        img->buffer_len = size;
+    }
+
+    *len = img->buffer_addr + img->buffer_len - addr;
+    return &img->flash_buffer[addr - img->buffer_addr];
+}
+
+/**
+ * @brief check if pixmap of pixel format is tiled
+ * @param format pixel format
+ * @return true if the pixmap is tiled
+ */
+static inline bool ext_img_format_is_tile(uint8_t format)
 {
-    uint8_t tmp_buf[8];
-    uint8_t* read_ptr = NULL;
-    uint8_t* start_ptr = (uint8_t*)img->pixmap[img->pixmap_idx].bitmap.array;
-    uintptr_t start_addr = img->pixmap[img->pixmap_idx].bitmap.addr;
-    uint8_t format = img->pixmap->format;
+    return format == SGL_PIXMAP_FMT_TILE_RGB888 || format == SGL_PIXMAP_FMT_TILE_ARGB8888;
+}
+
+/**
+ * @brief blend a piece of converted pixels into destination
+ * @param img ext_img object
+ * @param dst destination
+ * @param color native colors of pixels
+ * @param alpha alpha of pixels, NULL if the pixels are opaque
+ * @param len number of pixels
+ * @return none
+ */
+static inline void ext_img_blend_span(sgl_ext_img_t *img, sgl_color_t *dst, const sgl_color_t *color, const uint8_t *alpha, int len)
+{
+    sgl_color_t tmp_color;
+
+    if (alpha == NULL) {
+        sgl_draw_ops.copy(dst, color, len, img->alpha);
+        return;
+    }
+
+    for (int i = 0; i < len; i++) {
+        tmp_color = alpha[i] == SGL_ALPHA_MAX ? color[i] : sgl_color_mixer(color[i], dst[i], alpha[i]);
+        dst[i] = img->alpha == SGL_ALPHA_MAX ? tmp_color : sgl_color_mixer(tmp_color, dst[i], img->alpha);
+    }
+}
+
+/**
+ * @brief draw a piece of a row of raw pixmap
+ * @param img ext_img object
+ * @param cvt row converter of pixel format
+ * @param has_alpha true if the pixel format has alpha
+ * @param dst destination
+ * @param src bytes of pixels
+ * @param pix_byte bytes of a pixel
+ * @param len number of pixels
+ * @return none
+ * @note the opaque pixels are converted into destination directly, the others are converted
+ *       on the stack by SGL_EXT_IMG_SPAN_SIZE pixels and then blended
+ */
+static inline void ext_img_raw_span(sgl_ext_img_t *img, sgl_pixmap_row_cvt_t cvt, bool has_alpha, sgl_color_t *dst, const uint8_t *src, uint8_t pix_byte, int len)
+{
+    sgl_color_t color[SGL_EXT_IMG_SPAN_SIZE];
+    uint8_t alpha[SGL_EXT_IMG_SPAN_SIZE];
+    int n;
+
+    if (!has_alpha && img->alpha == SGL_ALPHA_MAX) {
+        cvt(dst, NULL, src, len);
+        return;
+    }
+
+    for (; len > 0; len -= n) {
+        n = sgl_min(len, SGL_EXT_IMG_SPAN_SIZE);
+        cvt(color, has_alpha ? alpha : NULL, src, n);
+        ext_img_blend_span(img, dst, color, has_alpha ? alpha : NULL, n);
+        dst += n;
+        src += n * pix_byte;
+    }
+}
+
+/**
+ * @brief read the next run of RLE pixmap into the decoder
+ * @param img ext_img object
+ * @param pixmap current pixmap
+ * @return none
+ */
+static inline void ext_img_rle_run(sgl_ext_img_t *img, const sgl_pixmap_t *pixmap)
+{
+    /* a run is the count and one pixel */
+    uint32_t len = 1 + sgl_pixmal_get_pixel_bytes(pixmap);
+    const uint8_t *read_ptr = ext_img_fetch(img, pixmap->bitmap.addr + img->index, UINTPTR_MAX, &len);
     uint32_t pix_value;
 
+    img->index ++;
+    img->remainder = read_ptr[0];
+
+    switch (pixmap->format) {
+    case SGL_PIXMAP_FMT_RLE_RGB332:
+        pix_value = read_ptr[1];
+        img->color = sgl_rgb332_to_color(pix_value);
+        img->pix_alpha = SGL_ALPHA_MAX;
+        img->index ++;
+        break;
+    case SGL_PIXMAP_FMT_RLE_ARGB2222:
+        pix_value = read_ptr[1];
+        img->color = sgl_rgb222_to_color(pix_value);
+        img->pix_alpha = sgl_opa2_table[pix_value >> 6];
+        img->index ++;
+        break;
+    case SGL_PIXMAP_FMT_RLE_RGB565:
+        pix_value = read_ptr[1] | (read_ptr[2] << 8);
+        img->color = sgl_rgb565_to_color(pix_value);
+        img->pix_alpha = SGL_ALPHA_MAX;
+        img->index += 2;
+        break;
+    case SGL_PIXMAP_FMT_RLE_ARGB4444:
+        pix_value = read_ptr[1] | (read_ptr[2] << 8);
+        img->color = sgl_rgb444_to_color(pix_value);
+        img->pix_alpha = sgl_opa4_table[pix_value >> 12];
+        img->index += 2;
+        break;
+    case SGL_PIXMAP_FMT_RLE_RGB888:
+        pix_value = read_ptr[1] | (read_ptr[2] << 8) | (read_ptr[3] << 16);
+        img->color = sgl_rgb888_to_color(pix_value);
+        img->pix_alpha = SGL_ALPHA_MAX;
+        img->index += 3;
+        break;
+    case SGL_PIXMAP_FMT_RLE_ARGB8888:
+        pix_value = read_ptr[1] | (read_ptr[2] << 8) | (read_ptr[3] << 16);
+        img->color = sgl_rgb888_to_color(pix_value);
+        img->pix_alpha = read_ptr[4];
+        img->index += 4;
+        break;
+    default:
+        break;
+    }
+}
+
+static inline void rle_decompress_line(sgl_ext_img_t *img, sgl_area_t *coords, sgl_area_t *area, sgl_color_t *out)
+{
+    const sgl_pixmap_t *pixmap = &img->pixmap[img->pixmap_idx];
+    sgl_color_t color;
+
     for (int i = coords->x1; i <= coords->x2; i++) {
         if (img->remainder == 0) {
-            if (img->read != NULL) {
-                read_ptr = tmp_buf;
-                img->read(start_addr + img->index, tmp_buf, sizeof(tmp_buf));
-            }
-            else {
-                read_ptr = start_ptr + img->index;
-            }
-
-            img->index ++;
-            img->remainder = read_ptr[0];
-
-            switch (format) {
-            case SGL_PIXMAP_FMT_RLE_RGB332:
-                pix_value = read_ptr[1];
-                img->color = sgl_rgb332_to_color(pix_value);
-                img->pix_alpha = SGL_ALPHA_MAX;
-                img->index ++;
-                break;
-            case SGL_PIXMAP_FMT_RLE_ARGB2222:
-                pix_value = read_ptr[1];
-                img->color = sgl_rgb222_to_color(pix_value);
-                img->pix_alpha = sgl_opa2_table[pix_value >> 6];
-                img->index ++;
-                break;
-            case SGL_PIXMAP_FMT_RLE_RGB565:
-                pix_value = read_ptr[1] | (read_ptr[2] << 8);
-                img->color = sgl_rgb565_to_color(pix_value);
-                img->pix_alpha = SGL_ALPHA_MAX;
-                img->index += 2;
-                break;
-            case SGL_PIXMAP_FMT_RLE_ARGB4444:
-                pix_value = read_ptr[1] | (read_ptr[2] << 8);
-                img->color = sgl_rgb444_to_color(pix_value);
-                img->pix_alpha = sgl_opa4_table[pix_value >> 12];
-                img->index += 2;
-                break;
-            case SGL_PIXMAP_FMT_RLE_RGB888:
-                pix_value = read_ptr[1] | (read_ptr[2] << 8) | (read_ptr[3] << 16);
-                img->color = sgl_rgb888_to_color(pix_value);
-                img->pix_alpha = SGL_ALPHA_MAX;
-                img->index += 3;
-                break;
-            case SGL_PIXMAP_FMT_RLE_ARGB8888:
-                pix_value = read_ptr[1] | (read_ptr[2] << 8) | (read_ptr[3] << 16);
-                img->color = sgl_rgb888_to_color(pix_value);
-                img->pix_alpha = read_ptr[4];
-                img->index += 4;
-                break;
-            default:
-                break;
-            }
+            ext_img_rle_run(img, pixmap);
         }
 
         if (out != NULL && i >= area->x1 && i <= area->x2) {
-            img->color = (img->pix_alpha == SGL_ALPHA_MAX ? img->color : sgl_color_mixer(img->color, *out, img->pix_alpha));
-            *out = (img->alpha == SGL_ALPHA_MAX ? img->color : sgl_color_mixer(img->color, *out, img->alpha));
+            /* the color of run is kept, the other pixels of the run blend it too */
+            color = (img->pix_alpha == SGL_ALPHA_MAX ? img->color : sgl_color_mixer(img->color, *out, img->pix_alpha));
+            *out = (img->alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *out, img->alpha));
             out ++;
         }
         img->remainder --;
     };
 }
 
+/**
+ * @brief allocate the RLE row seek index for the rows of current pixmap
+ * @param img ext_img object
+ * @return none
+ * @note it is called by SGL_EVENT_DRAW_INIT, the checkpoints are recorded while the rows are decoded
+ */
+static void ext_img_rle_index_init(sgl_ext_img_t *img)
+{
+    uint32_t num = 0;
+
+    img->rle_pixmap = NULL;
+#if (CONFIG_SGL_IMG_ROW_INDEX_STEP)
+    const sgl_pixmap_t *pixmap = &img->pixmap[img->pixmap_idx];
+
+    if (pixmap->format >= SGL_PIXMAP_FMT_RLE_RGB332 && pixmap->format <= SGL_PIXMAP_FMT_RLE_ARGB8888) {
+        num = (pixmap->height + CONFIG_SGL_IMG_ROW_INDEX_STEP - 1) / CONFIG_SGL_IMG_ROW_INDEX_STEP;
+    }
+#endif
+    if (num <= img->rle_index_cap) {
+        return;
+    }
+
+    if (img->rle_index != NULL) {
+        sgl_free(img->rle_index);
+    }
+    img->rle_index_cap = 0;
+    img->rle_index = (sgl_ext_img_ckpt_t*)sgl_malloc(num * sizeof(sgl_ext_img_ckpt_t));
+    if (img->rle_index == NULL) {
+        SGL_LOG_WARN("ext_img_rle_index_init: out of memory, decode RLE from the top");
+        return;
+    }
+    img->rle_index_cap = (uint16_t)num;
+}
+
+/**
+ * @brief decode a row of RLE pixmap and record the checkpoint of the row
+ * @param img ext_img object
+ * @param coords area of pixmap
+ * @param area clip area
+ * @param out output buffer, NULL to skip the row
+ * @return none
+ */
+static inline void ext_img_rle_line(sgl_ext_img_t *img, sgl_area_t *coords, sgl_area_t *area, sgl_color_t *out)
+{
+#if (CONFIG_SGL_IMG_ROW_INDEX_STEP)
+    uint32_t k = img->rle_row / CONFIG_SGL_IMG_ROW_INDEX_STEP;
+
+    if (img->rle_row % CONFIG_SGL_IMG_ROW_INDEX_STEP == 0 && k == img->rle_index_num && k < img->rle_index_cap) {
+        img->rle_index[k].index = img->index;
+        img->rle_index[k].color = img->color;
+        img->rle_index[k].remainder = img->remainder;
+        img->rle_index[k].pix_alpha = img->pix_alpha;
+        img->rle_index_num ++;
+    }
+#endif
+    rle_decompress_line(img, coords, area, out);
+    img->rle_row ++;
+}
+
+/**
+ * @brief move the RLE decoder to the start of a row
+ * @param img ext_img object
+ * @param pixmap current pixmap
+ * @param coords area of pixmap
+ * @param area clip area
+ * @param row row of pixmap
+ * @return none
+ * @note the decoder continues if it is already at the row, otherwise it restarts from the
+ *       nearest checkpoint at or before the row, and from the top if there is no checkpoint
+ */
+static void ext_img_rle_seek(sgl_ext_img_t *img, const sgl_pixmap_t *pixmap, sgl_area_t *coords, sgl_area_t *area, int32_t row)
+{
+    if (img->rle_pixmap != pixmap) {
+        img->rle_pixmap = pixmap;
+        img->rle_index_num = 0;
+        img->rle_row = -1;
+    }
+
+    if (row < img->rle_row || img->rle_row < 0) {
+        ext_img_rle_init(img);
+        img->rle_row = 0;
+    }
+
+#if (CONFIG_SGL_IMG_ROW_INDEX_STEP)
+    int32_t k = sgl_min(row / CONFIG_SGL_IMG_ROW_INDEX_STEP, (int32_t)img->rle_index_num - 1);
+    if (k >= 0 && k * CONFIG_SGL_IMG_ROW_INDEX_STEP > img->rle_row) {
+        img->index = img->rle_index[k].index;
+        img->color = img->rle_index[k].color;
+        img->remainder = img->rle_index[k].remainder;
+        img->pix_alpha = img->rle_index[k].pix_alpha;
+        img->rle_row = k * CONFIG_SGL_IMG_ROW_INDEX_STEP;
+    }
+#endif
+
+    while (img->rle_row < row) {
+        ext_img_rle_line(img, coords, area, NULL);
+    }
+}
+
+/**
+ * @brief get a little endian 32 bits number
+ * @param p bytes of number
+ * @return number
+ */
+static inline uint32_t ext_img_get_le32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief read the tile size and the offset table of current tiled pixmap
+ * @param img ext_img object
+ * @return none
+ * @note it is called by SGL_EVENT_DRAW_INIT, the table of pixmap in memory is used in place, the table
+ *       of external pixmap is loaded into RAM, so the read buffer is only refilled by the tiles
+ */
+static void ext_img_tile_init(sgl_ext_img_t *img)
+{
+    const sgl_pixmap_t *pixmap = &img->pixmap[img->pixmap_idx];
+    uint32_t len = SGL_PIXMAP_TILE_HEAD_SIZE, num;
+    const uint8_t *head;
+    uint8_t *bytes;
+
+    if (!ext_img_format_is_tile(pixmap->format) || img->tile_pixmap == pixmap) {
+        return;
+    }
+
+    head = ext_img_fetch(img, pixmap->bitmap.addr, pixmap->bitmap.addr + SGL_PIXMAP_TILE_HEAD_SIZE, &len);
+    img->tile_w = head[0] | (head[1] << 8);
+    img->tile_h = head[2] | (head[3] << 8);
+    img->tile_pixmap = pixmap;
+    if (img->tile_w == 0 || img->tile_h == 0) {
+        SGL_LOG_ERROR("ext_img_tile_init: tile size of pixmap is zero");
+        img->tile_w = 0;
+        return;
+    }
+
+    if (img->read == NULL) {
+        return;
+    }
+
+    num = ((pixmap->width + img->tile_w - 1) / img->tile_w) * ((pixmap->height + img->tile_h - 1) / img->tile_h) + 1;
+    if (num > img->tile_table_cap) {
+        if (img->tile_table != NULL) {
+            sgl_free(img->tile_table);
+        }
+        img->tile_table_cap = 0;
+        img->tile_table = (uint32_t*)sgl_malloc(num * sizeof(uint32_t));
+        if (img->tile_table == NULL) {
+            SGL_LOG_WARN("ext_img_tile_init: out of memory, read the offsets with the tiles");
+            return;
+        }
+        img->tile_table_cap = num;
+    }
+
+    /* the offsets are read in place, then they are put in host byte order */
+    bytes = (uint8_t*)img->tile_table;
+    img->read(pixmap->bitmap.addr + SGL_PIXMAP_TILE_HEAD_SIZE, bytes, num * sizeof(uint32_t));
+    for (uint32_t i = 0; i < num; i++) {
+        img->tile_table[i] = ext_img_get_le32(&bytes[i * 4]);
+    }
+}
+
+/**
+ * @brief get the bytes of a tile of tiled pixmap
+ * @param img ext_img object
+ * @param pixmap current pixmap
+ * @param tile index of tile
+ * @param start [out] address of the first byte of tile
+ * @param end [out] address after the last byte of tile
+ * @return none
+ */
+static inline void ext_img_tile_range(sgl_ext_img_t *img, const sgl_pixmap_t *pixmap, uint32_t tile, uintptr_t *start, uintptr_t *end)
+{
+    const uintptr_t table = pixmap->bitmap.addr + SGL_PIXMAP_TILE_HEAD_SIZE + tile * sizeof(uint32_t);
+    uint32_t len = 2 * sizeof(uint32_t);
+    const uint8_t *p;
+
+    if (img->read != NULL && img->tile_table_cap != 0) {
+        *start = pixmap->bitmap.addr + img->tile_table[tile];
+        *end = pixmap->bitmap.addr + img->tile_table[tile + 1];
+        return;
+    }
+
+    p = ext_img_fetch(img, table, table + len, &len);
+    *start = pixmap->bitmap.addr + ext_img_get_le32(p);
+    *end = pixmap->bitmap.addr + ext_img_get_le32(p + 4);
+}
+
+/**
+ * @brief decode the next pixels of a tile
+ * @param img ext_img object
+ * @param dec decoder state of tile
+ * @param addr [in/out] address of next operation of tile
+ * @param end address after the last byte of tile
+ * @param color [out] native colors, NULL to skip the pixels
+ * @param alpha [out] alpha of pixels, NULL if the alpha is not needed
+ * @param len number of pixels
+ * @return true if the pixels are decoded, false if the tile is broken
+ * @note the operations are decoded by the pieces that are valid in the read buffer
+ */
+static bool ext_img_tile_pixels(sgl_ext_img_t *img, sgl_pixmap_tile_dec_t *dec, uintptr_t *addr, uintptr_t end,
+                                sgl_color_t *color, uint8_t *alpha, uint32_t len)
+{
+    const uint8_t *src, *p;
+    uint32_t size, n;
+
+    for (uint32_t i = 0; i < len; i += n) {
+        if (*addr > end) {
+            return false;
+        }
+
+        /* the bytes after the tile are not given to decoder, the pending run needs no bytes */
+        size = (uint32_t)sgl_min(end - *addr, (uintptr_t)SGL_PIXMAP_TILE_OP_MAX);
+        src = p = NULL;
+        if (size > 0) {
+            src = p = ext_img_fetch(img, *addr, end, &size);
+            size = (uint32_t)sgl_min((uintptr_t)size, end - *addr);
+        }
+
+        n = sgl_pixmap_tile_decode(dec, color != NULL ? &color[i] : NULL, alpha != NULL ? &alpha[i] : NULL, &p, size, len - i);
+        if (n == 0) {
+            return false;
+        }
+        *addr += p - src;
+    }
+
+    return true;
+}
+
+/**
+ * @brief draw the next pixels of a tile
+ * @param img ext_img object
+ * @param dec decoder state of tile
+ * @param addr [in/out] address of next operation of tile
+ * @param end address after the last byte of tile
+ * @param has_alpha true if the pixel format has alpha
+ * @param dst destination, NULL to skip the pixels
+ * @param len number of pixels
+ * @return true if the pixels are drawn, false if the tile is broken
+ * @note the opaque pixels are decoded into destination directly, the others are decoded
+ *       on the stack by SGL_EXT_IMG_SPAN_SIZE pixels and then blended
+ */
+static bool ext_img_tile_span(sgl_ext_img_t *img, sgl_pixmap_tile_dec_t *dec, uintptr_t *addr, uintptr_t end,
+                              bool has_alpha, sgl_color_t *dst, int len)
+{
+    sgl_color_t color[SGL_EXT_IMG_SPAN_SIZE];
+    uint8_t alpha[SGL_EXT_IMG_SPAN_SIZE];
+    int n;
+
+    if (dst == NULL || (!has_alpha && img->alpha == SGL_ALPHA_MAX)) {
+        return ext_img_tile_pixels(img, dec, addr, end, dst, NULL, len);
+    }
+
+    for (; len > 0; len -= n) {
+        n = sgl_min(len, SGL_EXT_IMG_SPAN_SIZE);
+        if (!ext_img_tile_pixels(img, dec, addr, end, color, has_alpha ? alpha : NULL, n)) {
+            return false;
+        }
+        ext_img_blend_span(img, dst, color, has_alpha ? alpha : NULL, n);
+        dst += n;
+    }
+
+    return true;
+}
+
+/**
+ * @brief draw the clip area of tiled pixmap
+ * @param img ext_img object
+ * @param pixmap current pixmap
+ * @param surf surface
+ * @param area area of pixmap
+ * @param clip clip area, it is inside the area of pixmap
+ * @return none
+ * @note only the tiles in clip area are decoded, and a tile is decoded from its top down to the
+ *       last row of clip area, the pixels out of clip area are skipped without conversion
+ */
+static void ext_img_tile_draw(sgl_ext_img_t *img, const sgl_pixmap_t *pixmap, sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *clip)
+{
+    const bool has_alpha = sgl_pixmap_format_has_alpha(pixmap->format);
+    sgl_pixmap_tile_dec_t dec;
+    uintptr_t addr, end;
+    int32_t cols, x1, x2, y1, y2, cx1, cx2;
+    bool ok;
+
+    if (img->tile_pixmap != pixmap || img->tile_w == 0) {
+        return;
+    }
+
+    cols = (pixmap->width + img->tile_w - 1) / img->tile_w;
+
+    for (int32_t ty = (clip->y1 - area->y1) / img->tile_h; ty <= (clip->y2 - area->y1) / img->tile_h; ty++) {
+        y1 = area->y1 + ty * img->tile_h;
+        y2 = sgl_min(y1 + img->tile_h - 1, (int32_t)clip->y2);
+
+        for (int32_t tx = (clip->x1 - area->x1) / img->tile_w; tx <= (clip->x2 - area->x1) / img->tile_w; tx++) {
+            x1 = area->x1 + tx * img->tile_w;
+            x2 = sgl_min(x1 + img->tile_w - 1, (int32_t)area->x2);
+            cx1 = sgl_max(x1, (int32_t)clip->x1);
+            cx2 = sgl_min(x2, (int32_t)clip->x2);
+
+            ext_img_tile_range(img, pixmap, ty * cols + tx, &addr, &end);
+            sgl_pixmap_tile_dec_init(&dec);
+
+            for (int32_t y = y1; y <= y2; y++) {
+                if (y < clip->y1) {
+                    ok = ext_img_tile_span(img, &dec, &addr, end, has_alpha, NULL, x2 - x1 + 1);
+                }
+                else {
+                    /* the pixels after clip area are not decoded in the last row */
+                    ok = ext_img_tile_span(img, &dec, &addr, end, has_alpha, NULL, cx1 - x1) &&
+                         ext_img_tile_span(img, &dec, &addr, end, has_alpha, sgl_surf_get_buf(surf, cx1 - surf->x1, y - surf->y1), cx2 - cx1 + 1) &&
+                         (y == y2 || ext_img_tile_span(img, &dec, &addr, end, has_alpha, NULL, x2 - cx2));
+                }
+
+                if (!ok) {
+                    SGL_LOG_ERROR("ext_img_tile_draw: tile %d of pixmap is broken", ty * cols + tx);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+#if (CONFIG_SGL_IMG_CACHE_SIZE > 0)
+/**
+ * @brief decode the whole pixmap into an entry of image cache
+ * @param img ext_img object
+ * @param pixmap current pixmap
+ * @param entry entry of image cache
+ * @return none
+ * @note the RLE decoder is moved to the end of pixmap, so the next streamed band restarts it
+ */
+static void ext_img_cache_decode(sgl_ext_img_t *img, const sgl_pixmap_t *pixmap, sgl_img_cache_entry_t *entry)
+{
+    const uint32_t pixels = (uint32_t)pixmap->width * pixmap->height;
+    const uint8_t pix_byte = sgl_pixmal_get_pixel_bytes(pixmap);
+    const sgl_pixmap_row_cvt_t cvt = sgl_pixmap_get_row_cvt(pixmap->format);
+    const uint8_t *pixmap_buf = NULL;
+    uintptr_t read_addr = pixmap->bitmap.addr;
+    uint32_t len, n;
+
+    if (cvt != NULL) {
+        /* the pixels are converted by the pieces that are valid in the read buffer */
+        for (uint32_t i = 0; i < pixels; i += n) {
+            len = pix_byte;
+            pixmap_buf = ext_img_fetch(img, read_addr, pixmap->bitmap.addr + pixels * pix_byte, &len);
+            n = sgl_min(len / pix_byte, pixels - i);
+            read_addr += n * pix_byte;
+            cvt(&entry->color[i], entry->alpha != NULL ? &entry->alpha[i] : NULL, pixmap_buf, n);
+        }
+        return;
+    }
+
+    if (ext_img_format_is_tile(pixmap->format)) {
+        sgl_pixmap_tile_dec_t dec;
+        uintptr_t addr, end;
+        uint32_t tile = 0, offset, w, h;
+
+        /* every tile is decoded row by row into its place */
+        for (uint32_t y = 0; y < pixmap->height; y += img->tile_h) {
+            h = sgl_min((uint32_t)img->tile_h, pixmap->height - y);
+            for (uint32_t x = 0; x < pixmap->width; x += img->tile_w, tile++) {
+                w = sgl_min((uint32_t)img->tile_w, pixmap->width - x);
+                ext_img_tile_range(img, pixmap, tile, &addr, &end);
+                sgl_pixmap_tile_dec_init(&dec);
+
+                for (uint32_t row = 0; row < h; row++) {
+                    offset = (y + row) * pixmap->width + x;
+                    if (!ext_img_tile_pixels(img, &dec, &addr, end, &entry->color[offset], entry->alpha != NULL ? &entry->alpha[offset] : NULL, w)) {
+                        SGL_LOG_ERROR("ext_img_cache_decode: tile %d of pixmap is broken", tile);
+                        break;
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    ext_img_rle_init(img);
+    img->rle_pixmap = NULL;
+
+    for (uint32_t i = 0; i < pixels; i++) {
+        if (img->remainder == 0) {
+            ext_img_rle_run(img, pixmap);
+        }
+        entry->color[i] = img->color;
+        if (entry->alpha != NULL) {
+            entry->alpha[i] = img->pix_alpha;
+        }
+        img->remainder --;
+    }
+}
+
+/**
+ * @brief use the decoded current pixmap from image cache, the pixmap is decoded if it is not cached
+ * @param img ext_img object
+ * @return none
+ * @note it is called by SGL_EVENT_DRAW_INIT, the pixmap is streamed if it can not be cached
+ */
+static void ext_img_cache_load(sgl_ext_img_t *img)
+{
+    const sgl_pixmap_t *pixmap = &img->pixmap[img->pixmap_idx];
+    sgl_img_cache_entry_t *entry = img->cache;
+
+    if (entry != NULL && entry->src == img->pixmap && entry->frame == img->pixmap_idx) {
+        return;
+    }
+
+    if (entry != NULL) {
+        sgl_img_cache_release(entry);
+        img->cache = NULL;
+    }
+
+    /* the tiled pixmap of broken head is not drawn */
+    if (sgl_pixmal_get_pixel_bytes(pixmap) == 0 || (ext_img_format_is_tile(pixmap->format) && img->tile_w == 0)) {
+        return;
+    }
+
+    entry = sgl_img_cache_find(img->pixmap, img->pixmap_idx);
+    if (entry == NULL) {
+        entry = sgl_img_cache_alloc(img->pixmap, img->pixmap_idx, pixmap->width, pixmap->height,
+                                    sgl_pixmap_format_has_alpha(pixmap->format));
+        if (entry == NULL) {
+            return;
+        }
+        ext_img_cache_decode(img, pixmap, entry);
+    }
+
+    img->cache = entry;
+}
+
+/**
+ * @brief draw the clip area of current pixmap from image cache
+ * @param img ext_img object
+ * @param surf surface
+ * @param area area of pixmap
+ * @param clip clip area, it is inside the area of pixmap
+ * @return none
+ */
+static void ext_img_cache_draw(sgl_ext_img_t *img, sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *clip)
+{
+    const sgl_img_cache_entry_t *entry = img->cache;
+    sgl_color_t *buf = sgl_surf_get_buf(surf, clip->x1 - surf->x1, clip->y1 - surf->y1);
+    const int16_t len = clip->x2 - clip->x1 + 1;
+    uint32_t offset = (uint32_t)(clip->y1 - area->y1) * entry->width + (clip->x1 - area->x1);
+
+    for (int y = clip->y1; y <= clip->y2; y++) {
+        ext_img_blend_span(img, buf, &entry->color[offset], entry->alpha != NULL ? &entry->alpha[offset] : NULL, len);
+        buf += surf->w;
+        offset += entry->width;
+    }
+}
+#endif // !CONFIG_SGL_IMG_CACHE_SIZE
 
 static void sgl_ext_img_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *evt)
 {
     sgl_area_t clip = SGL_AREA_INVALID;
     sgl_ext_img_t *ext_img = sgl_container_of(obj, sgl_ext_img_t, obj);
+
+    if (evt->type == SGL_EVENT_DRAW_INIT) {
+        if (ext_img->pixmap != NULL) {
+            ext_img_rle_index_init(ext_img);
+            ext_img_tile_init(ext_img);
+#if (CONFIG_SGL_IMG_CACHE_SIZE > 0)
+            ext_img_cache_load(ext_img);
+#endif
+        }
+        return;
+    }
+    else if (evt->type == SGL_EVENT_DESTROYED) {
+        if (ext_img->rle_index != NULL) {
+            sgl_free(ext_img->rle_index);
+        }
+        if (ext_img->tile_table != NULL) {
+            sgl_free(ext_img->tile_table);
+        }
+#if (CONFIG_SGL_IMG_CACHE_SIZE > 0)
+        if (ext_img->cache != NULL) {
+            sgl_img_cache_release(ext_img->cache);
+        }
+#endif
+        return;
+    }
+
     const sgl_pixmap_t *pixmap = &ext_img->pixmap[ext_img->pixmap_idx];
     uintptr_t read_addr = pixmap->bitmap.addr;
     uint8_t pix_byte = sgl_pixmal_get_pixel_bytes(pixmap);
-    sgl_color_t tmp_color, *buf = NULL, *blend = NULL;
-    size_t pix_value = 0;
-    size_t offset = 0;
+    sgl_pixmap_row_cvt_t cvt = sgl_pixmap_get_row_cvt(pixmap->format);
+    sgl_color_t *buf = NULL;
 
     sgl_area_t area = {
         .x1 = obj->coords.x1,
@@ -136,77 +721,61 @@ static void sgl_ext_img_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
             return;
         }
 
-        if (pixmap->format < SGL_PIXMAP_FMT_RLE_RGB332) {
-            buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
+#if (CONFIG_SGL_IMG_CACHE_SIZE > 0)
+        sgl_img_cache_entry_t *entry = ext_img->cache;
+        sgl_area_t cache_clip;
+
+        /* the decoded pixmap is drawn if the cached one is current */
+        if (entry != NULL && entry->src == ext_img->pixmap && entry->frame == ext_img->pixmap_idx) {
+            if (sgl_area_clip(&clip, &area, &cache_clip)) {
+                ext_img_cache_draw(ext_img, surf, &area, &cache_clip);
+            }
+        }
+        else
+#endif
+        if (ext_img_format_is_tile(pixmap->format)) {
+            sgl_area_t tile_clip;
 
-            uint8_t *pixmap_buf = (uint8_t*)pixmap->bitmap.array;
-            if(ext_img->read != NULL){
-                pixmap_buf = (uint8_t*)sgl_malloc(pix_byte * (clip.x2 - clip.x1 + 1));
+            if (sgl_area_clip(&clip, &area, &tile_clip)) {
+                ext_img_tile_draw(ext_img, pixmap, surf, &area, &tile_clip);
             }
+        }
+        else if (cvt != NULL) {
+            const bool has_alpha = sgl_pixmap_format_has_alpha(pixmap->format);
+            const uint8_t *pixmap_buf = NULL;
+            uintptr_t read_end;
+            uint32_t len;
+            int n;
+
+            buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
 
             for (int y = clip.y1; y <= clip.y2; y++) {
-                blend = buf;
-                offset = ((((y - area.y1) * pixmap->width) + (clip.x1 - area.x1)) * pix_byte);
-                if(ext_img->read != NULL) {
-                    ext_img->read(read_addr + offset, pixmap_buf, pix_byte * (clip.x2 - clip.x1 + 1));
-                    offset = 0;
+                read_addr = pixmap->bitmap.addr + ((((y - area.y1) * pixmap->width) + (clip.x1 - area.x1)) * pix_byte);
+                /* the rows are continuous if the whole width is drawn, then they are read ahead together */
+                read_end = read_addr + (clip.x2 - clip.x1 + 1) * pix_byte;
+                if (clip.x1 == area.x1 && clip.x2 == area.x2) {
+                    read_end += (clip.y2 - y) * pixmap->width * pix_byte;
+                }
+
+                /* the row is decoded by the pieces that are valid in the read buffer */
+                for (int x = clip.x1; x <= clip.x2; x += n) {
+                    len = pix_byte;
+                    pixmap_buf = ext_img_fetch(ext_img, read_addr, read_end, &len);
+                    n = (int)sgl_min(len / pix_byte, (uint32_t)(clip.x2 - x + 1));
+                    read_addr += n * pix_byte;
+                    ext_img_raw_span(ext_img, cvt, has_alpha, buf + (x - clip.x1), pixmap_buf, pix_byte, n);
                 }
-                for (int x = clip.x1; x <= clip.x2; x++) {
-                    switch (pixmap->format) {
-                    case SGL_PIXMAP_FMT_RGB332:
-                        pix_value = pixmap_buf[offset];
-                        tmp_color = sgl_rgb332_to_color(pix_value);
-                        break;
-                    case SGL_PIXMAP_FMT_RGB565:
-                        pix_value = pixmap_buf[offset] | (pixmap_buf[offset + 1] << 8);
-                        tmp_color = sgl_rgb565_to_color(pix_value);
-                        break;
-                    case SGL_PIXMAP_FMT_ARGB2222:
-                        pix_value = pixmap_buf[offset];
-                        tmp_color = sgl_rgb222_to_color(pix_value);
-                        tmp_color = sgl_color_mixer(tmp_color, *blend, sgl_opa2_table[pix_value >> 6]);
-                        break;
-                    case SGL_PIXMAP_FMT_ARGB4444:
-                        pix_value = pixmap_buf[offset] | (pixmap_buf[offset + 1] << 8);
-                        tmp_color = sgl_rgb444_to_color(pix_value);
-                        tmp_color = sgl_color_mixer(tmp_color, *blend, sgl_opa4_table[pix_value >> 12]);
-                        break;
-                    case SGL_PIXMAP_FMT_RGB888:
-                        pix_value = pixmap_buf[offset] | (pixmap_buf[offset + 1] << 8) | (pixmap_buf[offset + 2] << 16);
-                        tmp_color = sgl_rgb888_to_color(pix_value);
-                        break;
-                    case SGL_PIXMAP_FMT_ARGB8888:
-                        pix_value = pixmap_buf[offset] | (pixmap_buf[offset + 1] << 8) | (pixmap_buf[offset + 2] << 16);
-                        tmp_color = sgl_rgb888_to_color(pix_value);
-                        tmp_color = sgl_color_mixer(tmp_color, *blend, pixmap_buf[offset + 3]);
-                        break;
-                    default:
-                        break;
-                    }
-                    *blend = ext_img->alpha == SGL_ALPHA_MAX ? tmp_color : sgl_color_mixer(tmp_color, *blend, ext_img->alpha);
-                    offset += pix_byte;
-                    blend ++;
-                };
                 buf += surf->w;
             }
-            if(ext_img->read != NULL) {
-                sgl_free(pixmap_buf);
-            }
         }
         else {
-            /* RLE pixmap support */
-            if (clip.y1 == surf->dirty->y1 || clip.y1 == obj->area.y1) {
-                ext_img->index = 0;
-                ext_img->remainder = 0;
-                for (int y = area.y1; y < clip.y1; y++) {
-                    rle_decompress_line(ext_img, &area, &clip, NULL);
-                }
-            }
+            /* RLE pixmap support, the decoder keeps its row from band to band */
+            ext_img_rle_seek(ext_img, pixmap, &area, &clip, clip.y1 - area.y1);
 
             buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, (clip.y1 - surf->y1));
 
             for (int y = clip.y1; y <= clip.y2; y++) {
-                rle_decompress_line(ext_img, &area, &clip, buf);
+                ext_img_rle_line(ext_img, &area, &clip, buf);
                 buf += surf->w;
             }
         }
@@ -214,6 +783,7 @@ static void sgl_ext_img_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
         if (ext_img->pixmap_auto && (clip.y2 == surf->dirty->y2 || clip.y2 == obj->area.y2)) {
             uint32_t pixmap_idx = ext_img->pixmap_idx + 1;
             ext_img->pixmap_idx = pixmap_idx >= ext_img->pixmap_num ? 0 : pixmap_idx;
+            sgl_obj_needinit(obj);
             sgl_obj_set_dirty(obj);
         }
     }
@@ -239,11 +809,14 @@ sgl_obj_t* sgl_ext_img_create(sgl_obj_t* parent)
     sgl_obj_t *obj = &ext_img->obj;
     sgl_obj_init(&ext_img->obj, parent);
     obj->construct_fn = sgl_ext_img_construct_cb;
+    /* RLE decoder and auto pixmap switch keep state from band to band */
+    sgl_obj_set_serial_draw(obj);
 
     ext_img->alpha = SGL_ALPHA_MAX;
     ext_img->pixmap_idx = 0;
     ext_img->pixmap_num = 1;
     ext_img->pixmap_auto = 0;
+    ext_img->rle_row = -1;
 
     return obj;
 }
@@ -257,7 +830,18 @@ sgl_obj_t* sgl_ext_img_create(sgl_obj_t* parent)
 void sgl_ext_img_set_pixmap(sgl_obj_t *obj, const sgl_pixmap_t *pixmap)
 {
     SGL_ASSERT(obj != NULL);
+#if (CONFIG_SGL_IMG_CACHE_SIZE > 0)
+    /* the same pixmap is set again after its data is rewritten in place, so its decoded images are stale */
+    if (((sgl_ext_img_t*)obj)->pixmap == pixmap && pixmap != NULL) {
+        sgl_img_cache_drop(pixmap);
+    }
+#endif
     ((sgl_ext_img_t*)obj)->pixmap = pixmap;
+    /* the pixmap data may be rewritten in place, read it again */
+    ((sgl_ext_img_t*)obj)->buffer_len = 0;
+    ((sgl_ext_img_t*)obj)->rle_pixmap = NULL;
+    ((sgl_ext_img_t*)obj)->tile_pixmap = NULL;
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
 
@@ -270,7 +854,18 @@ void sgl_ext_img_set_pixmap(sgl_obj_t *obj, const sgl_pixmap_t *pixmap)
 void sgl_ext_img_set_read_ops(sgl_obj_t *obj, void (*read)(const size_t addr, uint8_t *out, uint32_t len_bytes))
 {
     SGL_ASSERT(obj != NULL);
+#if (CONFIG_SGL_IMG_CACHE_SIZE > 0)
+    /* the images were decoded from other memory */
+    if (((sgl_ext_img_t*)obj)->pixmap != NULL) {
+        sgl_img_cache_drop(((sgl_ext_img_t*)obj)->pixmap);
+    }
+#endif
     ((sgl_ext_img_t*)obj)->read = read;
+    ((sgl_ext_img_t*)obj)->buffer_len = 0;
+    ((sgl_ext_img_t*)obj)->rle_pixmap = NULL;
+    /* the offset table of tiled pixmap is loaded from the other memory */
+    ((sgl_ext_img_t*)obj)->tile_pixmap = NULL;
+    sgl_obj_needinit(obj);
 }
 
 /**
@@ -314,6 +909,7 @@ void sgl_ext_img_set_pixmap_next(sgl_obj_t *obj)
     sgl_ext_img_t *ext_img = sgl_container_of(obj, sgl_ext_img_t, obj);
     uint32_t pixmap_idx = ext_img->pixmap_idx + 1;
     ext_img->pixmap_idx = pixmap_idx >= ext_img->pixmap_num ? 0 : pixmap_idx;
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
 
@@ -328,5 +924,6 @@ void sgl_ext_img_set_pixmap_index(sgl_obj_t *obj, uint8_t index)
     SGL_ASSERT(obj != NULL);
     sgl_ext_img_t *ext_img = sgl_container_of(obj, sgl_ext_img_t, obj);
     ext_img->pixmap_idx = sgl_min(index, ext_img->pixmap_num - 1);
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
@@ -105,11 +105,58 @@
  *          sgl_ext_img_set_pixmap(ext_img, test_pixmap);
  *          sgl_ext_img_set_pixmap_num(ext_img, 128, true);
  *          sgl_ext_img_set_read_ops(ext_img, flash_port_read_data_from_flash);
+ *
+ * 4. Decoded image cache:
+ *      if CONFIG_SGL_IMG_CACHE_SIZE is not 0, the current pixmap is decoded into the image cache
+ *      once and drawn from it until it is evicted, every frame of a pixmap sequence is cached
+ *      by its index, so the frames of auto refresh stay in cache if all of them fit.
+ *      set the same pixmap again after its data is rewritten, then the stale images are dropped.
+ *
+ * 5. Native pixmap:
+ *      the pixels of SGL_PIXMAP_FMT_NONE pixmap are sgl_color_t, they are copied without conversion,
+ *      the pixels of SGL_PIXMAP_FMT_NATIVE_ALPHA pixmap are sgl_color_t with an alpha byte, they are
+ *      blended without conversion. a pixmap in memory can be converted at load time, for example:
+ *          static sgl_pixmap_t native;
+ *          void *native_buf = sgl_malloc(sgl_pixmap_native_size(&logo));
+ *          sgl_pixmap_to_native(&native, native_buf, &logo);
+ *          sgl_ext_img_set_pixmap(ext_img, &native);
+ *
+ * 6. Tiled pixmap:
+ *      SGL_PIXMAP_FMT_TILE_RGB888 and SGL_PIXMAP_FMT_TILE_ARGB8888 pixmap is cut into tiles that are
+ *      compressed alone, only the tiles in the clip area are decoded, and a tile is decoded down to
+ *      the last row of clip area. it compresses the gradients and the photos better than RLE.
+ *      tools/tile_encoder converts a PPM or PAM image to it, for example:
+ *          sgl_tile_encoder logo.ppm logo.c 32x16
+ *          extern const sgl_pixmap_t logo;
+ *          sgl_obj_t *ext_img = sgl_ext_img_create(NULL);
+ *          sgl_obj_set_size(ext_img, logo.width, logo.height);
+ *          sgl_ext_img_set_pixmap(ext_img, &logo);
+ *      the tile height that is not more than the lines of draw buffer decodes less rows again.
  */
 
- /* TODO: add ext img buffer size config */
+/**
+ * read buffer of external pixmap:
+ *      every read() call fills the whole buffer from the requested address, the RLE runs and
+ *      the raw rows are decoded from RAM until they leave the buffer, so the decoder issues few
+ *      large sequential reads instead of one small read per run or per row.
+ *      read() may be asked for bytes after the end of a RLE pixmap, they are never used.
+ */
 #define SGL_EXT_IMG_BUFFER_SIZE   (CONFIG_SGL_EXT_IMG_BUFFER)
 
+/**
+ * @brief decoder state of RLE pixmap at the start of a row
+ * @index: byte offset of next run
+ * @color: color of current run
+ * @remainder: pixels left in current run
+ * @pix_alpha: alpha of current run
+ */
+typedef struct sgl_ext_img_ckpt {
+    uint32_t        index;
+    sgl_color_t     color;
+    uint8_t         remainder;
+    uint8_t         pix_alpha;
+} sgl_ext_img_ckpt_t;
+
 /**
  * @brief sgl ext_img struct
  * @obj: sgl general object
@@ -128,9 +175,24 @@ typedef struct sgl_ext_img {
     uint8_t         pixmap_num;
     uint8_t         remainder;
     uint8_t         pix_alpha;
-#if CONFIG_SGL_EXT_IMG_BUFFER
+    /* RLE row seek index, a checkpoint every CONFIG_SGL_IMG_ROW_INDEX_STEP rows of rle_pixmap */
+    const sgl_pixmap_t *rle_pixmap;
+    sgl_ext_img_ckpt_t *rle_index;
+    uint16_t        rle_index_cap;
+    uint16_t        rle_index_num;
+    int32_t         rle_row;
+    /* offset table of tiled tile_pixmap, it is loaded into RAM if the pixmap is read by read() */
+    const sgl_pixmap_t *tile_pixmap;
+    uint32_t        *tile_table;
+    uint32_t        tile_table_cap;
+    uint16_t        tile_w;
+    uint16_t        tile_h;
+    /* decoded current pixmap in image cache, NULL if it is streamed */
+    sgl_img_cache_entry_t *cache;
+    /* read buffer, it holds buffer_len bytes from buffer_addr */
+    uintptr_t       buffer_addr;
+    uint32_t        buffer_len;
     uint8_t         flash_buffer[SGL_EXT_IMG_BUFFER_SIZE];
-#endif
 } sgl_ext_img_t;
 
 /**
@@ -392,6 +392,9 @@ static void sgl_keyboard_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
     sgl_split_len(keybd_btn_height, KEYBOARD_BTN_LINES, body_h, keyboard->key_margin, btn_height);
 
     if(evt->type == SGL_EVENT_DRAW_MAIN) {
+        /* the object is not modified while drawing, the key color is set in a copy */
+        sgl_draw_rect_t btn_desc = keyboard->btn_desc;
+
         sgl_draw_rect(surf, &obj->area, &obj->coords, &keyboard->body_desc);
 
         btn_coords.y1 = obj->coords.y1;
@@ -412,12 +415,12 @@ static void sgl_keyboard_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
                 }
 
                 if(index == keyboard->key_index) {
-                    keyboard->btn_desc.color = sgl_color_mixer(btn_color, keyboard->text_color, 128);
+                    btn_desc.color = sgl_color_mixer(btn_color, keyboard->text_color, 128);
                 }
                 else {
-                    keyboard->btn_desc.color = btn_color;
+                    btn_desc.color = btn_color;
                 }
-                sgl_draw_rect(surf, &btn_area, &btn_coords, &keyboard->btn_desc);
+                sgl_draw_rect(surf, &btn_area, &btn_coords, &btn_desc);
 
                 text = keyindex_is_icon(keyboard->key_mode, index);
                 if (text != NULL) {
@@ -437,8 +440,6 @@ static void sgl_keyboard_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
 
             btn_coords.y1 += btn_height[i];
         }
-
-        keyboard->btn_desc.color = btn_color;
     }
     else if (evt->type == SGL_EVENT_PRESSED || evt->type == SGL_EVENT_KEY_ENTER) {
         index = keyboard_pos_to_index(evt->pos.x, evt->pos.y, keyboard, body_w, body_h, &keyboard->btn_area);
@@ -529,6 +530,7 @@ sgl_obj_t* sgl_keyboard_create(sgl_obj_t* parent)
     sgl_obj_t *obj = &keyboard->obj;
     sgl_obj_init(&keyboard->obj, parent);
     obj->construct_fn = sgl_keyboard_construct_cb;
+    sgl_obj_set_display_list(obj, true);
     sgl_obj_set_border_width(obj, SGL_THEME_BORDER_WIDTH);
 
     obj->clickable = 1;
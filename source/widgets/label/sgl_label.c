@@ -65,6 +65,7 @@ static void sgl_label_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t
 {
     sgl_label_t *label = sgl_container_of(obj, sgl_label_t, obj);
     sgl_pos_t align_pos;
+    bool layout_valid;
 
     SGL_ASSERT(label->font != NULL);
 
@@ -73,19 +74,45 @@ static void sgl_label_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t
             sgl_draw_fill_rect(surf, &obj->area, &obj->coords, obj->radius, label->bg_color, label->alpha);
         }
 
-        align_pos = sgl_get_text_pos(&obj->coords, label->font, label->text, 0, (sgl_align_type_t)label->align);
+        /* the layout is invalidated by the text and font setters, draw the text then */
+        layout_valid = sgl_text_layout_is_valid(&label->layout, label->text, label->font);
+        if (layout_valid) {
+            sgl_size_t parent_size = {
+                .w = obj->coords.x2 - obj->coords.x1 + 1,
+                .h = obj->coords.y2 - obj->coords.y1 + 1,
+            };
+            sgl_size_t text_size = {
+                .w = label->layout.width,
+                .h = sgl_font_get_height(label->font),
+            };
+
+            align_pos = sgl_get_align_pos(&parent_size, &text_size, (sgl_align_type_t)label->align);
+            align_pos.x += obj->coords.x1;
+            align_pos.y += obj->coords.y1;
+        }
+        else {
+            align_pos = sgl_get_text_pos(&obj->coords, label->font, label->text, 0, (sgl_align_type_t)label->align);
+        }
 
 #if (CONFIG_SGL_LABEL_ROTATION)
         if (label->rota == 0) {
 #endif 
-            sgl_draw_string(surf, &obj->area, align_pos.x + label->transform.offset.offset_x, 
-                                              align_pos.y + label->transform.offset.offset_y, 
-                                              label->text, label->color, label->alpha, label->font);
+            if (layout_valid) {
+                sgl_draw_text_layout(surf, &obj->area, align_pos.x + label->transform.offset.offset_x,
+                                                       align_pos.y + label->transform.offset.offset_y,
+                                                       &label->layout, label->color, label->alpha);
+            }
+            else {
+                sgl_draw_string(surf, &obj->area, align_pos.x + label->transform.offset.offset_x, 
+                                                  align_pos.y + label->transform.offset.offset_y, 
+                                                  label->text, label->color, label->alpha, label->font);
+            }
 #if (CONFIG_SGL_LABEL_ROTATION)
         }
         else {
-            const int16_t width = obj->area.x2 - obj->area.x1 + 1;
-            const int16_t height = obj->area.y2 - obj->area.y1 + 1;
+            sgl_area_t text_area = obj->coords;
+            const int16_t width = obj->coords.x2 - obj->coords.x1 + 1;
+            const int16_t height = obj->coords.y2 - obj->coords.y1 + 1;
             const uint32_t buf_size = width * height;
 
             sgl_color_t *temp_buf = sgl_malloc(buf_size * sizeof(sgl_color_t));
@@ -98,28 +125,39 @@ static void sgl_label_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t
                 temp_buf[i] = label->bg_color;
             }
 
+            /* the text is drawn unrotated into a surface that covers the label, then it is rotated around the center */
             sgl_surf_t temp_surf = {
-                .x1 = align_pos.x,
-                .y1 = align_pos.y,
-                .x2 = 0,
-                .y2 = 0,
+                .x1 = obj->coords.x1,
+                .y1 = obj->coords.y1,
+                .x2 = obj->coords.x2,
+                .y2 = obj->coords.y2,
                 .buffer = temp_buf,
+                .size = buf_size * sizeof(sgl_color_t),
                 .w = width,
                 .h = height,
-                .dirty = NULL
+                .dirty = &text_area,
             };
 
-            sgl_draw_string(&temp_surf, &obj->area, align_pos.x, align_pos.y,
-                                              label->text, label->color, label->alpha, label->font);
-            sgl_draw_xform_surf(surf, &temp_surf, &obj->parent->area, obj->coords.x1, obj->coords.y1, label->transform.rotation);
+            if (layout_valid) {
+                sgl_draw_text_layout(&temp_surf, &text_area, align_pos.x, align_pos.y,
+                                     &label->layout, label->color, label->alpha);
+            }
+            else {
+                sgl_draw_string(&temp_surf, &text_area, align_pos.x, align_pos.y,
+                                label->text, label->color, label->alpha, label->font);
+            }
+            sgl_draw_xform_surf(surf, &temp_surf, &obj->area, obj->coords.x1, obj->coords.y1, label->transform.rotation);
 
             sgl_free(temp_buf);
         }
 #endif
+    } else if (evt->type == SGL_EVENT_DRAW_INIT) {
+        sgl_text_layout_update(&label->layout, label->text, label->font);
     } else if (evt->type == SGL_EVENT_DESTROYED) {
         if (label->dynamic) {
             sgl_free((void*)label->text);
         }
+        sgl_text_layout_free(&label->layout);
     }
 }
 
@@ -143,6 +181,8 @@ sgl_obj_t* sgl_label_create(sgl_obj_t* parent)
     sgl_obj_t *obj = &label->obj;
     sgl_obj_init(&label->obj, parent);
     obj->construct_fn = sgl_label_construct_cb;
+    obj->needinit = 1;
+    sgl_obj_set_display_list(obj, true);
 
     label->alpha = SGL_ALPHA_MAX;
     label->bg_flag = 0;
@@ -175,6 +215,8 @@ void sgl_label_set_text(sgl_obj_t *obj, char *text)
         sgl_label_update_area(label, text, &area);
     }
     label->text = text;
+    sgl_text_layout_invalidate(&label->layout);
+    sgl_obj_needinit(obj);
     sgl_obj_update_area(&area);
 }
 
@@ -191,6 +233,8 @@ void sgl_label_set_text_buffer(sgl_obj_t *obj, char *buf, uint16_t buf_size)
     label->text = buf;
     label->dynamic = 0;
     label->text_capacity = buf_size;
+    sgl_text_layout_invalidate(&label->layout);
+    sgl_obj_needinit(obj);
 }
 
 /**
@@ -217,6 +261,8 @@ void sgl_label_set_text_fmt(sgl_obj_t *obj, const char *fmt, ...)
 
     sgl_label_update_area(label, label->text, &new_area);
     sgl_area_selfmerge(&area, &new_area);
+    sgl_text_layout_invalidate(&label->layout);
+    sgl_obj_needinit(obj);
     sgl_obj_update_area(&area);
 }
 
@@ -261,6 +307,8 @@ void sgl_label_set_text_fmt_dynamic(sgl_obj_t* obj, const char *fmt, ...)
 
     sgl_label_update_area(label, label->text, &new_area);
     sgl_area_selfmerge(&area, &new_area);
+    sgl_text_layout_invalidate(&label->layout);
+    sgl_obj_needinit(obj);
     sgl_obj_update_area(&area);
 }
 
@@ -268,13 +316,16 @@ void sgl_label_set_text_fmt_dynamic(sgl_obj_t* obj, const char *fmt, ...)
  * @brief update label text area
  * @param obj pointer to the label object
  * @return none
- * @note you can update your label text area when you change the text buffer content
+ * @note you can update your label text area when you change the text buffer content,
+ *       the cached layout of text is rebuilt then
  */
 void sgl_label_update_text(sgl_obj_t *obj)
 {
     sgl_label_t *label = sgl_container_of(obj, sgl_label_t, obj);
     sgl_area_t area = SGL_AREA_INVALID;
     sgl_label_update_area(label, label->text, &area);
+    sgl_text_layout_invalidate(&label->layout);
+    sgl_obj_needinit(obj);
     sgl_obj_update_area(&area);
 }
 
@@ -299,6 +350,8 @@ void sgl_label_set_font(sgl_obj_t *obj, const sgl_font_t *font)
 {
     sgl_label_t *label = sgl_container_of(obj, sgl_label_t, obj);
     label->font = font;
+    sgl_text_layout_invalidate(&label->layout);
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
 
@@ -394,5 +447,7 @@ void sgl_label_set_text_rotation(sgl_obj_t *obj, int16_t text_rotation)
     label->transform.rotation = text_rotation % 360;
     if (label->transform.rotation < 0) label->transform.rotation += 360;
     label->rota = label->transform.rotation ? 1 : 0;
+    /* the rotated text is drawn through a temporary surface, it can not be recorded */
+    sgl_obj_set_display_list(obj, label->rota == 0);
     sgl_obj_set_dirty(obj);
 }
@@ -38,11 +38,13 @@
  * @brief sgl label object
  * @obj: sgl general object
  * @desc: draw task descriptor
+ * @layout: cached layout of text, it is updated when text or font is changed
  */
 typedef struct sgl_label {
     sgl_obj_t        obj;
     const sgl_font_t *font;
     char             *text;
+    sgl_text_layout_t layout;
     uint16_t         text_capacity;
     sgl_color_t      color;
     sgl_color_t      bg_color;
@@ -106,7 +108,8 @@ void sgl_label_set_text_fmt_dynamic(sgl_obj_t* obj, const char *fmt, ...);
  * @brief update label text area
  * @param obj pointer to the label object
  * @return none
- * @note you can update your label text area when you change the text buffer content
+ * @note you can update your label text area when you change the text buffer content,
+ *       the cached layout of text is rebuilt then
  */
 void sgl_label_update_text(sgl_obj_t *obj);
 
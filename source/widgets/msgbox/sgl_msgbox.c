@@ -45,7 +45,8 @@ static void sgl_msgbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
 
     SGL_ASSERT(msgbox->font != NULL);
 
-    sgl_color_t tmp_color;
+    sgl_color_t lbtn_color = msgbox->lbtn_color;
+    sgl_color_t rbtn_color = msgbox->rbtn_color;
     sgl_area_t  button_coords = {
         .x1 = obj->coords.x1,
         .x2 = obj->coords.x2,
@@ -82,10 +83,6 @@ static void sgl_msgbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
     };
 
     if(evt->type == SGL_EVENT_DRAW_MAIN) {
-        if(msgbox->status & SGL_MSGBOX_STATUS_EXIT) {
-            sgl_obj_set_destroyed(&msgbox->obj);
-        }
-
         sgl_draw_rect(surf, &obj->area, &obj->coords, &msgbox->body_desc);
    
         msgbox_draw_text(surf, &obj->area, &title_coords, msgbox->title_text, font, msgbox->title_color, msgbox->body_desc.alpha, 0);
@@ -101,26 +98,18 @@ static void sgl_msgbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
 
         sgl_draw_string_mult_line(surf, &text_coords, text_coords.x1, text_coords.y1, msgbox->msg_text, msgbox->msg_color, msgbox->body_desc.alpha, font, msgbox->msg_line_margin);
 
+        /* the object is not modified while drawing, the pressed button color is kept in a local */
         if(msgbox->status & SGL_MSGBOX_STATUS_LEFT) {
-            tmp_color = msgbox->lbtn_color;
-            msgbox->lbtn_color = sgl_color_mixer(msgbox->lbtn_text_color, msgbox->body_desc.color, 128);
+            lbtn_color = sgl_color_mixer(msgbox->lbtn_text_color, msgbox->body_desc.color, 128);
         }
         else if(msgbox->status & SGL_MSGBOX_STATUS_RIGHT) {
-            tmp_color = msgbox->rbtn_color;
-            msgbox->rbtn_color = sgl_color_mixer(msgbox->rbtn_text_color, msgbox->body_desc.color, 128);
+            rbtn_color = sgl_color_mixer(msgbox->rbtn_text_color, msgbox->body_desc.color, 128);
         }
 
-        sgl_draw_fill_rect(surf, &button_coords, &left_coords, obj->radius, msgbox->lbtn_color, msgbox->body_desc.alpha);
-        sgl_draw_fill_rect(surf, &button_coords, &right_coords, obj->radius, msgbox->rbtn_color, msgbox->body_desc.alpha);
+        sgl_draw_fill_rect(surf, &button_coords, &left_coords, obj->radius, lbtn_color, msgbox->body_desc.alpha);
+        sgl_draw_fill_rect(surf, &button_coords, &right_coords, obj->radius, rbtn_color, msgbox->body_desc.alpha);
         msgbox_draw_text(surf, &obj->area, &left_coords, msgbox->lbtn_text, font, msgbox->lbtn_text_color, msgbox->body_desc.alpha, font_height / 2);
         msgbox_draw_text(surf, &obj->area, &right_coords, msgbox->rbtn_text, font, msgbox->rbtn_text_color, msgbox->body_desc.alpha, font_height / 2);
-    
-        if(msgbox->status & SGL_MSGBOX_STATUS_LEFT) {
-            msgbox->lbtn_color = tmp_color;
-        }
-        else if(msgbox->status & SGL_MSGBOX_STATUS_RIGHT) {
-            msgbox->rbtn_color = tmp_color;
-        }
     }
     else if(evt->type == SGL_EVENT_PRESSED) {
         if(evt->pos.y > (obj->coords.y2 - font_height - 2) && evt->pos.x < ((obj->coords.x1 + obj->coords.x2) / 2)) {
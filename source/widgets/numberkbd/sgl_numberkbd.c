@@ -132,6 +132,9 @@ static void sgl_numberkbd_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_eve
     SGL_ASSERT(numberkbd->font != NULL);
 
     if(evt->type == SGL_EVENT_DRAW_MAIN) {
+        /* the object is not modified while drawing, the pressed button color is set in a copy */
+        sgl_draw_rect_t btn_desc = numberkbd->btn_desc;
+
         sgl_draw_rect(surf, &obj->area, &obj->coords, &numberkbd->body_desc);
 
         for(; btn.y1 < (obj->coords.y2 - numberkbd->margin); btn.y1 += (box_h + numberkbd->margin), btn.y2 = (btn.y1 + box_h)) {
@@ -141,36 +144,35 @@ static void sgl_numberkbd_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_eve
 
             for(btn.x2 = (btn.x1 + box_w); btn.x1 < (obj->coords.x2 - numberkbd->margin) ; btn.x1 += (box_w + numberkbd->margin), btn.x2 = (btn.x1 + box_w)) {
                 if(numberkbd->opcode != kbd_digits[btn_row][btn_col]) {
-                    numberkbd->btn_desc.color = btn_color;
+                    btn_desc.color = btn_color;
                 }
                 else {
-                    numberkbd->btn_desc.color = sgl_color_mixer(btn_color, numberkbd->text_color, 128);
+                    btn_desc.color = sgl_color_mixer(btn_color, numberkbd->text_color, 128);
                 }
 
                 if(btn_col == 3 && btn_row > 1) {
                     if(btn_row == 2) {
-                        sgl_draw_rect(surf, &btn, &btn, &numberkbd->btn_desc);
+                        sgl_draw_rect(surf, &btn, &btn, &btn_desc);
                         text_x = btn.x1 + ((box_w -  backspace_icon.width) / 2);
                         text_y = btn.y1 + ((box_h - backspace_icon.height + 1) / 2);
-                        sgl_draw_icon(surf, &btn, text_x, text_y, numberkbd->text_color, numberkbd->btn_desc.alpha, &backspace_icon);
+                        sgl_draw_icon(surf, &btn, text_x, text_y, numberkbd->text_color, btn_desc.alpha, &backspace_icon);
                     }
                     else if (btn_row == 3) {
                         btn.y2 += (numberkbd->margin + box_h);
-                        sgl_draw_rect(surf, &btn, &btn, &numberkbd->btn_desc);
+                        sgl_draw_rect(surf, &btn, &btn, &btn_desc);
                         text_x = btn.x1 + ((box_w -  enter_icon.width) / 2);
                         text_y = btn.y1 + ((2 * box_h - enter_icon.height) / 2);
-                        sgl_draw_icon(surf, &btn, text_x, text_y, numberkbd->text_color, numberkbd->btn_desc.alpha, &enter_icon);
+                        sgl_draw_icon(surf, &btn, text_x, text_y, numberkbd->text_color, btn_desc.alpha, &enter_icon);
                     }
                 }
                 else {
-                    sgl_draw_rect(surf, &btn, &btn, &numberkbd->btn_desc);
+                    sgl_draw_rect(surf, &btn, &btn, &btn_desc);
                     text_x = btn.x1 + ((box_w -  sgl_font_get_string_width("0", numberkbd->font)) / 2);
-                    sgl_draw_character(surf, &obj->area, text_x, text_y, kbd_digits[btn_row][btn_col] - 31, numberkbd->text_color, numberkbd->btn_desc.alpha, numberkbd->font);
+                    sgl_draw_character(surf, &obj->area, text_x, text_y, kbd_digits[btn_row][btn_col] - 31, numberkbd->text_color, btn_desc.alpha, numberkbd->font);
                 }
                 btn_col ++;
             }
 
-            numberkbd->btn_desc.color = btn_color;
             btn_row ++;
         }
     }
@@ -137,7 +137,6 @@ static void sgl_polygon_fill_scanline(sgl_surf_t *surf,
                                       sgl_obj_t *obj)
 {
     int16_t intersections[SGL_POLYGON_VERTEX_MAX];
-    bool solid_alpha = (polygon->alpha == SGL_ALPHA_MAX);
 
     for (int16_t y = clip->y1; y <= clip->y2; y++) {
         uint16_t hit_count = 0;
@@ -175,22 +174,14 @@ static void sgl_polygon_fill_scanline(sgl_surf_t *surf,
         for (uint16_t i = 0; i + 1 < hit_count; i += 2) {
             int16_t x_start = sgl_max((int16_t)(intersections[i] + 1), clip->x1);
             int16_t x_end = sgl_min((int16_t)(intersections[i + 1] - 1), clip->x2);
-            uint32_t len;
+            int16_t len;
 
             if (x_start > x_end) {
                 continue;
             }
 
-            len = (uint32_t)(x_end - x_start + 1);
-
-            if (solid_alpha) {
-                sgl_color_set(buf + (x_start - clip->x1), polygon->fill_color, len);
-            } else {
-                sgl_color_t *blend = buf + (x_start - clip->x1);
-                for (uint32_t x = 0; x < len; x++) {
-                    blend[x] = sgl_color_mixer(polygon->fill_color, blend[x], polygon->alpha);
-                }
-            }
+            len = x_end - x_start + 1;
+            sgl_draw_ops_area(buf + (x_start - clip->x1), len, len, 1, polygon->fill_color, polygon->alpha);
         }
     }
 }
@@ -215,22 +206,23 @@ static void sgl_polygon_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
         return; // At least 3 vertices are required to form a polygon
     }
 
-    if (!sgl_area_clip(&obj->parent->area, &obj->coords, &obj->area)) {
-        sgl_area_init(&obj->area);
+    // The object is not modified while drawing, the clipped area is kept in a local
+    sgl_area_t area;
+    if (!sgl_area_clip(&obj->parent->area, &obj->coords, &area)) {
         return;
     }
     
     // Draw fill
     if (polygon->fill_color.full != 0) {
         sgl_area_t clip;
-        if (sgl_surf_clip(surf, &obj->area, &clip)) {
+        if (sgl_surf_clip(surf, &area, &clip)) {
             sgl_polygon_fill_scanline(surf, &clip, polygon, obj);
         }
     }
     
     // Draw border
     if (polygon->border_width > 0 && polygon->border_color.full != 0) {
-        sgl_area_t border_area = obj->area;
+        sgl_area_t border_area = area;
         for (uint16_t i = 0; i < polygon->vertex_count; i++) {
             sgl_polygon_draw_border_line(surf,
                                          &border_area,
@@ -263,7 +255,7 @@ static void sgl_polygon_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
         int16_t text_x = center_x - text_width / 2;
         int16_t text_y = center_y - text_height / 2;
         
-        sgl_draw_string(surf, &obj->area, text_x, text_y, polygon->text, polygon->text_color, polygon->alpha, polygon->font);
+        sgl_draw_string(surf, &area, text_x, text_y, polygon->text, polygon->text_color, polygon->alpha, polygon->font);
     }
 }
 // Create polygon object
@@ -46,10 +46,6 @@ static void sgl_progress_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
         .y2 = obj->coords.y2 - obj->border - 1,
     };
 
-    if (progress->shift > (progress->interval + progress->knob_width)) {
-        progress->shift = 0;
-    }
-
     if(evt->type == SGL_EVENT_DRAW_MAIN) {
         knob.x2 = obj->coords.x1 - obj->radius / 2 - 2 + (obj->coords.x2 - obj->coords.x1) * progress->value / 100;
         knob.x2 -= obj->border - 1;
@@ -258,6 +254,10 @@ void sgl_progress_set_value(sgl_obj_t *obj, uint8_t value)
 {
     sgl_progress_t *progress = sgl_container_of(obj, sgl_progress_t, obj);
     progress->value = sgl_min(value, 100);
+    /* the shift wraps here, the draw callback only reads it */
+    if (progress->shift > (progress->interval + progress->knob_width)) {
+        progress->shift = 0;
+    }
     progress->shift ++;
     sgl_obj_set_dirty(obj);
 }
@@ -33,6 +33,17 @@
 #include "sgl_rectangle.h"
 
 
+/**
+ * @brief update rectangle opaque flag, it is opaque if the body is solid color
+ * @param  rect: rectangle
+ * @retval none
+ */
+static inline void sgl_rectangle_update_opaque(sgl_rectangle_t *rect)
+{
+    sgl_obj_set_opaque(&rect->obj, rect->alpha == SGL_ALPHA_MAX && rect->pixmap == NULL);
+}
+
+
 /**
  * @brief rectangle construct callback
  * @param  surf: surface
@@ -93,12 +104,14 @@ sgl_obj_t* sgl_rect_create(sgl_obj_t* parent)
     sgl_obj_set_border_width(obj, SGL_THEME_BORDER_WIDTH);
 
     obj->construct_fn = sgl_rectangle_construct_cb;
+    sgl_obj_set_display_list(obj, true);
 
     rect->alpha = SGL_THEME_ALPHA;
     rect->border_alpha = SGL_THEME_ALPHA;
     rect->color = SGL_THEME_COLOR;
     rect->border_color = SGL_THEME_BORDER_COLOR;
     rect->pixmap = NULL;
+    sgl_rectangle_update_opaque(rect);
 
     return obj;
 }
@@ -127,6 +140,7 @@ void sgl_rect_set_alpha(sgl_obj_t *obj, uint8_t alpha)
     sgl_rectangle_t *rect = sgl_container_of(obj, sgl_rectangle_t, obj);
     rect->alpha = alpha;
     rect->border_alpha = alpha;
+    sgl_rectangle_update_opaque(rect);
     sgl_obj_set_dirty(obj);
 }
 
@@ -140,6 +154,7 @@ void sgl_rect_set_main_alpha(sgl_obj_t *obj, uint8_t alpha)
 {
     sgl_rectangle_t *rect = sgl_container_of(obj, sgl_rectangle_t, obj);
     rect->alpha = alpha;
+    sgl_rectangle_update_opaque(rect);
     sgl_obj_set_dirty(obj);
 }
 
@@ -203,5 +218,6 @@ void sgl_rect_set_pixmap(sgl_obj_t *obj, const sgl_pixmap_t *pixmap)
 {
     sgl_rectangle_t *rect = sgl_container_of(obj, sgl_rectangle_t, obj);
     rect->pixmap = pixmap;
+    sgl_rectangle_update_opaque(rect);
     sgl_obj_set_dirty(obj);
 }
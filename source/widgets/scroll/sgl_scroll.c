@@ -138,6 +138,8 @@ sgl_obj_t* sgl_scroll_create(sgl_obj_t* parent)
     obj->construct_fn = sgl_scroll_construct_cb;
     sgl_obj_set_border_width(obj, SGL_THEME_BORDER_WIDTH);
     obj->movable = 1;
+    /* the coords follow the bound object and are written while drawing, so it is drawn on the main thread */
+    sgl_obj_set_serial_draw(obj);
     obj->clickable = 1;
 
     scroll->bind = NULL;
@@ -42,6 +42,16 @@ static int16_t textbox_scroll_get_pos(sgl_obj_t* obj, int16_t scroll_h)
 }
 
 
+static int32_t textbox_get_text_height(sgl_textbox_t *textbox, int16_t width)
+{
+    if (sgl_text_layout_is_valid(&textbox->layout, textbox->text, textbox->font)) {
+        return sgl_text_layout_get_height(&textbox->layout, width, textbox->line_margin);
+    }
+
+    return sgl_font_get_string_height(width, textbox->text, textbox->font, textbox->line_margin);
+}
+
+
 static void sgl_textbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *evt)
 {
     sgl_textbox_t *textbox = sgl_container_of(obj, sgl_textbox_t, obj);
@@ -59,10 +69,16 @@ static void sgl_textbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
         area.y2 = obj->coords.y2 - textbox->bg.radius;
 
         sgl_draw_rect(surf, &obj->area, &obj->coords, &textbox->bg);
-        sgl_draw_string_mult_line(surf, &area, area.x1, 
-                                 area.y1 + textbox->y_offset, 
-                                 textbox->text, textbox->text_color, textbox->bg.alpha, textbox->font, textbox->line_margin
-                                 );
+        if (sgl_text_layout_is_valid(&textbox->layout, textbox->text, textbox->font)) {
+            sgl_draw_text_layout_mult_line(surf, &area, area.x1, area.y1 + textbox->y_offset,
+                                           &textbox->layout, textbox->text_color, textbox->bg.alpha, textbox->line_margin);
+        }
+        else {
+            sgl_draw_string_mult_line(surf, &area, area.x1, 
+                                     area.y1 + textbox->y_offset, 
+                                     textbox->text, textbox->text_color, textbox->bg.alpha, textbox->font, textbox->line_margin
+                                     );
+        }
 
         if(textbox->scroll_enable) {
             area.x1 = obj->coords.x2 - SGL_TEXTBOX_SCROLL_WIDTH - textbox->bg.radius;
@@ -77,7 +93,7 @@ static void sgl_textbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
         }
     }
     else if(evt->type == SGL_EVENT_MOVE_UP) {
-        textbox->text_height = sgl_font_get_string_height(width, textbox->text, textbox->font, textbox->line_margin);
+        textbox->text_height = textbox_get_text_height(textbox, width);
         textbox->scroll_enable = 1;
         if((textbox->text_height + textbox->y_offset) > height ) {
            textbox->y_offset -= evt->distance;
@@ -85,7 +101,7 @@ static void sgl_textbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
         sgl_obj_set_dirty(obj);
     }
     else if(evt->type == SGL_EVENT_MOVE_DOWN) {
-        textbox->text_height = sgl_font_get_string_height(width, textbox->text, textbox->font, textbox->line_margin);
+        textbox->text_height = textbox_get_text_height(textbox, width);
         textbox->scroll_enable = 1;
         if(textbox->y_offset < 0) {
             textbox->y_offset += evt->distance;
@@ -106,6 +122,12 @@ static void sgl_textbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
     else if (evt->type == SGL_EVENT_UNFOCUSED) {
         textbox->bg.border --;
     }
+    else if (evt->type == SGL_EVENT_DRAW_INIT) {
+        sgl_text_layout_update(&textbox->layout, textbox->text, textbox->font);
+    }
+    else if (evt->type == SGL_EVENT_DESTROYED) {
+        sgl_text_layout_free(&textbox->layout);
+    }
 }
 
 
@@ -128,6 +150,7 @@ sgl_obj_t* sgl_textbox_create(sgl_obj_t* parent)
     sgl_obj_t *obj = &textbox->obj;
     sgl_obj_init(&textbox->obj, parent);
     obj->construct_fn = sgl_textbox_construct_cb;
+    obj->needinit = 1;
     sgl_obj_set_border_width(obj, SGL_THEME_BORDER_WIDTH);
     obj->focus = 1;
 
@@ -164,6 +187,21 @@ void sgl_textbox_set_text(sgl_obj_t *obj, const char *text)
 {
     sgl_textbox_t *textbox = sgl_container_of(obj, sgl_textbox_t, obj);
     textbox->text = text;
+    sgl_text_layout_invalidate(&textbox->layout);
+    sgl_obj_needinit(obj);
+    sgl_obj_set_dirty(obj);
+}
+
+/**
+ * @brief update textbox text after the content of its text buffer is changed
+ * @param obj textbox object
+ * @return none
+ */
+void sgl_textbox_update_text(sgl_obj_t *obj)
+{
+    sgl_textbox_t *textbox = sgl_container_of(obj, sgl_textbox_t, obj);
+    sgl_text_layout_invalidate(&textbox->layout);
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
 
@@ -190,6 +228,8 @@ void sgl_textbox_set_text_font(sgl_obj_t *obj, const sgl_font_t *font)
 {
     sgl_textbox_t *textbox = sgl_container_of(obj, sgl_textbox_t, obj);
     textbox->font = font;
+    sgl_text_layout_invalidate(&textbox->layout);
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
 
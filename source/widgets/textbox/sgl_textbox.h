@@ -37,6 +37,7 @@
 /**
  * @brief sgl textbox struct
  * @desc: text description
+ * @layout: cached layout of text, it is updated when text or font is changed
  */
 typedef struct sgl_textbox {
     sgl_obj_t       obj;
@@ -44,6 +45,7 @@ typedef struct sgl_textbox {
     sgl_draw_rect_t  scroll;
     const char       *text;
     const sgl_font_t *font;
+    sgl_text_layout_t layout;
     sgl_color_t      text_color;
     int32_t          y_offset;
     uint32_t         text_height: 31;
@@ -63,9 +65,18 @@ sgl_obj_t* sgl_textbox_create(sgl_obj_t* parent);
  * @brief set text of the textbox
  * @param obj textbox object
  * @param text text to be set
+ * @note the text is not copied, its layout is cached until the text or font is set again,
+ *       so call sgl_textbox_update_text() when the content of the buffer is changed in place
  */
 void sgl_textbox_set_text(sgl_obj_t *obj, const char *text);
 
+/**
+ * @brief update textbox text after the content of its text buffer is changed
+ * @param obj textbox object
+ * @note sgl_obj_set_dirty() alone redraws the old cached layout
+ */
+void sgl_textbox_update_text(sgl_obj_t *obj);
+
 /**
  * @brief set text color of the textbox
  * @param obj textbox object
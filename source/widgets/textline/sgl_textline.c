@@ -35,11 +35,20 @@
 static void sgl_textline_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *evt)
 {
     sgl_textline_t *textline = sgl_container_of(obj, sgl_textline_t, obj);
+    const int16_t text_width = obj->coords.x2 - obj->coords.x1 + 1 - obj->radius * 2;
     sgl_area_t text_area;
+    bool layout_valid;
     SGL_ASSERT(textline->font != NULL);
 
     if(evt->type == SGL_EVENT_DRAW_MAIN) {
-        obj->coords.y2 = obj->coords.y1 + (sgl_font_get_string_height(obj->coords.x2 - obj->coords.x1 + 1 - obj->radius * 2, textline->text, textline->font, textline->line_margin) + obj->radius * 2) - 1;
+        /* the layout is invalidated by the text and font setters, draw the text then */
+        layout_valid = sgl_text_layout_is_valid(&textline->layout, textline->text, textline->font);
+        if (layout_valid) {
+            obj->coords.y2 = obj->coords.y1 + (sgl_text_layout_get_height(&textline->layout, text_width, textline->line_margin) + obj->radius * 2) - 1;
+        }
+        else {
+            obj->coords.y2 = obj->coords.y1 + (sgl_font_get_string_height(text_width, textline->text, textline->font, textline->line_margin) + obj->radius * 2) - 1;
+        }
         sgl_area_clip(&obj->parent->area, &obj->coords, &obj->area);
 
         text_area.x1 = obj->coords.x1 + obj->radius;
@@ -52,7 +61,18 @@ static void sgl_textline_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
             sgl_draw_fill_rect(surf, &obj->area, &obj->coords, obj->radius, textline->bg_color, textline->alpha);
         }
 
-        sgl_draw_string_mult_line(surf, &text_area, obj->coords.x1 + obj->radius, obj->coords.y1 + obj->radius, textline->text, textline->color, textline->alpha, textline->font, textline->line_margin);
+        if (layout_valid) {
+            sgl_draw_text_layout_mult_line(surf, &text_area, obj->coords.x1 + obj->radius, obj->coords.y1 + obj->radius, &textline->layout, textline->color, textline->alpha, textline->line_margin);
+        }
+        else {
+            sgl_draw_string_mult_line(surf, &text_area, obj->coords.x1 + obj->radius, obj->coords.y1 + obj->radius, textline->text, textline->color, textline->alpha, textline->font, textline->line_margin);
+        }
+    }
+    else if (evt->type == SGL_EVENT_DRAW_INIT) {
+        sgl_text_layout_update(&textline->layout, textline->text, textline->font);
+    }
+    else if (evt->type == SGL_EVENT_DESTROYED) {
+        sgl_text_layout_free(&textline->layout);
     }
 }
 
@@ -76,6 +96,9 @@ sgl_obj_t* sgl_textline_create(sgl_obj_t* parent)
     sgl_obj_t *obj = &textline->obj;
     sgl_obj_init(&textline->obj, parent);
     obj->construct_fn = sgl_textline_construct_cb;
+    obj->needinit = 1;
+    /* the height follows the text and is written while drawing, so it is drawn on the main thread */
+    sgl_obj_set_serial_draw(obj);
 
     textline->alpha = SGL_THEME_ALPHA;
     textline->bg_flag = true;
@@ -98,6 +121,21 @@ void sgl_textline_set_text(sgl_obj_t *obj, const char *text)
 {
     sgl_textline_t *textline = sgl_container_of(obj, sgl_textline_t, obj);
     textline->text = text;
+    sgl_text_layout_invalidate(&textline->layout);
+    sgl_obj_needinit(obj);
+    sgl_obj_set_dirty(obj);
+}
+
+/**
+ * @brief update textline text after the content of its text buffer is changed
+ * @param obj textline object
+ * @return none
+ */
+void sgl_textline_update_text(sgl_obj_t *obj)
+{
+    sgl_textline_t *textline = sgl_container_of(obj, sgl_textline_t, obj);
+    sgl_text_layout_invalidate(&textline->layout);
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
 
@@ -111,6 +149,8 @@ void sgl_textline_set_text_font(sgl_obj_t *obj, const sgl_font_t *font)
 {
     sgl_textline_t *textline = sgl_container_of(obj, sgl_textline_t, obj);
     textline->font = font;
+    sgl_text_layout_invalidate(&textline->layout);
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
 
@@ -37,11 +37,13 @@
 /**
  * @brief sgl textline struct
  * @desc: text description
+ * @layout: cached layout of text, it is updated when text or font is changed
  */
 typedef struct sgl_textline {
     sgl_obj_t        obj;
     const char       *text;
     const sgl_font_t *font;
+    sgl_text_layout_t layout;
     sgl_color_t      color;
     sgl_color_t      bg_color;
     uint8_t          alpha;
@@ -62,9 +64,19 @@ sgl_obj_t* sgl_textline_create(sgl_obj_t* parent);
  * @param obj textline object
  * @param text text
  * @return none
+ * @note the text is not copied, its layout is cached until the text or font is set again,
+ *       so call sgl_textline_update_text() when the content of the buffer is changed in place
  */
 void sgl_textline_set_text(sgl_obj_t *obj, const char *text);
 
+/**
+ * @brief update textline text after the content of its text buffer is changed
+ * @param obj textline object
+ * @return none
+ * @note sgl_obj_set_dirty() alone redraws the old cached layout
+ */
+void sgl_textline_update_text(sgl_obj_t *obj);
+
 /**
  * @brief set textline font
  * @param obj textline object
@@ -96,22 +96,161 @@ static void sgl_unzip_img_incremental(sgl_unzip_img_dec_t *dec)
 }
 
 
+/**
+ * @brief Build the row seek index of compressed image
+ * @param desc Drawing description, the index of it is replaced
+ * @note the whole image is decoded once without drawing, it is called by SGL_EVENT_DRAW_INIT
+ */
+static void sgl_unzip_img_index_build(sgl_draw_unzip_img_t *desc)
+{
+    sgl_unzip_img_ckpt_t *index = (sgl_unzip_img_ckpt_t*)desc->index;
+
+    desc->index = NULL;
+    desc->index_num = 0;
+    if (index != NULL) {
+        sgl_free(index);
+    }
+
+#if (CONFIG_SGL_IMG_ROW_INDEX_STEP)
+    const sgl_unzip_img_pixmap_t *unzip_img = desc->unzip_img;
+    sgl_unzip_img_dec_t dec;
+    uint32_t num = 0;
+    uint16_t run;
+
+    if (unzip_img != NULL && unzip_img->width > 0) {
+        num = (unzip_img->height + CONFIG_SGL_IMG_ROW_INDEX_STEP - 1) / CONFIG_SGL_IMG_ROW_INDEX_STEP;
+    }
+    if (num == 0) {
+        return;
+    }
+
+    index = (sgl_unzip_img_ckpt_t*)sgl_malloc(num * sizeof(sgl_unzip_img_ckpt_t));
+    if (index == NULL) {
+        SGL_LOG_WARN("sgl_unzip_img_index_build: out of memory, decode from the top");
+        return;
+    }
+
+    sgl_unzip_img_dec_init(&dec, unzip_img);
+    index[0].n = dec.n;
+    index[0].rep_cnt = dec.rep_cnt;
+    index[0].out = dec.out;
+    index[0].unzip = dec.unzip;
+
+    while (dec.y < unzip_img->height) {
+        sgl_unzip_img_incremental(&dec);
+        /* the repeated pixels are skipped by row pieces */
+        while (dec.rep_cnt > 0) {
+            run = sgl_min(dec.rep_cnt, unzip_img->width - dec.x);
+            dec.rep_cnt -= run;
+            dec.x += run;
+            if (dec.x >= unzip_img->width) {
+                dec.x = 0;
+                if (++dec.y >= unzip_img->height) {
+                    break;
+                }
+                if (dec.y % CONFIG_SGL_IMG_ROW_INDEX_STEP == 0) {
+                    index[dec.y / CONFIG_SGL_IMG_ROW_INDEX_STEP].n = dec.n;
+                    index[dec.y / CONFIG_SGL_IMG_ROW_INDEX_STEP].rep_cnt = dec.rep_cnt;
+                    index[dec.y / CONFIG_SGL_IMG_ROW_INDEX_STEP].out = dec.out;
+                    index[dec.y / CONFIG_SGL_IMG_ROW_INDEX_STEP].unzip = dec.unzip;
+                }
+            }
+        }
+    }
+
+    desc->index = index;
+    desc->index_num = (uint16_t)num;
+#endif
+}
+
+
+#if (CONFIG_SGL_IMG_CACHE_SIZE > 0)
+/**
+ * @brief Use the decoded image from image cache, the image is decoded if it is not cached
+ * @param desc Drawing description, the cache of it is replaced
+ * @return true if the image is cached
+ * @note it is called by SGL_EVENT_DRAW_INIT
+ */
+static bool sgl_unzip_img_cache_load(sgl_draw_unzip_img_t *desc)
+{
+    const sgl_unzip_img_pixmap_t *unzip_img = desc->unzip_img;
+    sgl_img_cache_entry_t *entry = desc->cache;
+    sgl_unzip_img_dec_t dec;
+    uint32_t pixels, i = 0;
+
+    if (entry != NULL && entry->src == unzip_img) {
+        return true;
+    }
+
+    if (entry != NULL) {
+        sgl_img_cache_release(entry);
+        desc->cache = NULL;
+    }
+
+    if (unzip_img == NULL) {
+        return false;
+    }
+
+    entry = sgl_img_cache_find(unzip_img, 0);
+    if (entry == NULL) {
+        entry = sgl_img_cache_alloc(unzip_img, 0, unzip_img->width, unzip_img->height, false);
+        if (entry == NULL) {
+            return false;
+        }
+
+        pixels = (uint32_t)unzip_img->width * unzip_img->height;
+        sgl_unzip_img_dec_init(&dec, unzip_img);
+        while (i < pixels) {
+            sgl_unzip_img_incremental(&dec);
+            for (; dec.rep_cnt > 0 && i < pixels; dec.rep_cnt--) {
+                entry->color[i++] = dec.out;
+            }
+        }
+    }
+
+    desc->cache = entry;
+    return true;
+}
+
+
+/**
+ * @brief Draw decoded image from image cache
+ * @param surf Drawing surface
+ * @param img_rect Area of image
+ * @param intersection Visible area of image
+ * @param desc Drawing description
+ */
+static void sgl_draw_unzip_img_cached(sgl_surf_t *surf, sgl_area_t *img_rect, sgl_area_t *intersection, const sgl_draw_unzip_img_t *desc)
+{
+    const sgl_img_cache_entry_t *entry = desc->cache;
+    sgl_color_t *buf = sgl_surf_get_buf(surf, intersection->x1 - surf->x1, intersection->y1 - surf->y1);
+    const sgl_color_t *src = &entry->color[(intersection->y1 - img_rect->y1) * entry->width + (intersection->x1 - img_rect->x1)];
+    const int16_t len = intersection->x2 - intersection->x1 + 1;
+
+    for (int y = intersection->y1; y <= intersection->y2; y++) {
+        sgl_draw_ops.copy(buf, src, len, desc->alpha);
+        buf += surf->w;
+        src += entry->width;
+    }
+}
+#endif // !CONFIG_SGL_IMG_CACHE_SIZE
+
+
 /**
  * @brief Draw compressed image with transparency
  * @param surf Drawing surface
  * @param xs Starting X coordinate
  * @param ys Starting Y coordinate
- * @param unzip_img Compressed image data
- * @param color Color (for color replacement)
- * @param alpha Transparency
+ * @param desc Drawing description
+ * @note the decoder starts from the nearest checkpoint at or before the first visible row
  */
-static void sgl_draw_unzip_img_with_alpha(sgl_surf_t *surf, int16_t xs, int16_t ys, 
-                                       const sgl_unzip_img_pixmap_t *unzip_img, sgl_color_t color, uint8_t alpha)
+static void sgl_draw_unzip_img_with_alpha(sgl_surf_t *surf, int16_t xs, int16_t ys, const sgl_draw_unzip_img_t *desc)
 {
     SGL_ASSERT(surf != NULL);
-    SGL_ASSERT(unzip_img != NULL);
-    
-    SGL_UNUSED(color);
+    SGL_ASSERT(desc != NULL);
+
+    const sgl_unzip_img_pixmap_t *unzip_img = desc->unzip_img;
+    uint8_t alpha = desc->alpha;
 
     sgl_area_t img_rect;
     img_rect.x1 = xs;
@@ -123,14 +262,32 @@ static void sgl_draw_unzip_img_with_alpha(sgl_surf_t *surf, int16_t xs, int16_t
     if (!sgl_surf_clip(surf, &img_rect, &intersection)) {
         return;
     }
+
+#if (CONFIG_SGL_IMG_CACHE_SIZE > 0)
+    if (desc->cache != NULL && desc->cache->src == unzip_img) {
+        sgl_draw_unzip_img_cached(surf, &img_rect, &intersection, desc);
+        return;
+    }
+#endif
     
     sgl_unzip_img_dec_t dec;
     sgl_unzip_img_dec_init(&dec, unzip_img);
+
+#if (CONFIG_SGL_IMG_ROW_INDEX_STEP)
+    if (desc->index != NULL) {
+        int32_t k = sgl_min((intersection.y1 - ys) / CONFIG_SGL_IMG_ROW_INDEX_STEP, desc->index_num - 1);
+        dec.n = desc->index[k].n;
+        dec.rep_cnt = desc->index[k].rep_cnt;
+        dec.out = desc->index[k].out;
+        dec.unzip = desc->index[k].unzip;
+        dec.y = (int16_t)(k * CONFIG_SGL_IMG_ROW_INDEX_STEP);
+    }
+#endif
+
+    /* last row to decode, relative to the image */
+    int16_t ye = intersection.y2 - ys;
     
-    // int16_t xe = xs + unzip_img->width - 1;
-    int16_t ye = ys + unzip_img->height - 1;
-    
-    while (dec.y <= ye && dec.y <= intersection.y2) {
+    while (dec.y <= ye) {
         sgl_unzip_img_incremental(&dec);
         while (dec.rep_cnt > 0) {
             dec.rep_cnt--;
@@ -182,7 +339,7 @@ void sgl_draw_unzip_img(sgl_surf_t *surf, sgl_rect_t *area, sgl_rect_t *coords,
     if (SGL_ALPHA_MIN == desc->alpha) {
         return;  
     } else {
-        sgl_draw_unzip_img_with_alpha(surf, xs, ys, desc->unzip_img, desc->color, desc->alpha);
+        sgl_draw_unzip_img_with_alpha(surf, xs, ys, desc);
     }
 }
 
@@ -202,6 +359,30 @@ static void sgl_unzip_img_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_eve
             sgl_draw_unzip_img(surf, &obj->area, &obj->coords, &unzip_img->desc);
         }
     }
+    else if (evt->type == SGL_EVENT_DRAW_INIT) {
+#if (CONFIG_SGL_IMG_CACHE_SIZE > 0)
+        /* the cached image is drawn without decoding, so the row seek index is not needed */
+        if (sgl_unzip_img_cache_load(&unzip_img->desc)) {
+            if (unzip_img->desc.index != NULL) {
+                sgl_free((void*)unzip_img->desc.index);
+                unzip_img->desc.index = NULL;
+                unzip_img->desc.index_num = 0;
+            }
+            return;
+        }
+#endif
+        sgl_unzip_img_index_build(&unzip_img->desc);
+    }
+    else if (evt->type == SGL_EVENT_DESTROYED) {
+        if (unzip_img->desc.index != NULL) {
+            sgl_free((void*)unzip_img->desc.index);
+        }
+#if (CONFIG_SGL_IMG_CACHE_SIZE > 0)
+        if (unzip_img->desc.cache != NULL) {
+            sgl_img_cache_release(unzip_img->desc.cache);
+        }
+#endif
+    }
     else if (evt->type == SGL_EVENT_PRESSED || evt->type == SGL_EVENT_RELEASED) {
         if (obj->event_fn) {
             obj->event_fn(evt);
@@ -284,7 +465,14 @@ void sgl_unzip_img_set_align(sgl_obj_t *obj, sgl_align_type_t align)
 void sgl_unzip_img_set_img(sgl_obj_t *obj, const sgl_unzip_img_pixmap_t *unzip_img)
 {
     sgl_unzip_img_t *img = sgl_container_of(obj, sgl_unzip_img_t, obj);
+#if (CONFIG_SGL_IMG_CACHE_SIZE > 0)
+    /* the same image is set again after its data is rewritten in place, so its decoded image is stale */
+    if (img->desc.unzip_img == unzip_img && unzip_img != NULL) {
+        sgl_img_cache_drop(unzip_img);
+    }
+#endif
     img->desc.unzip_img = unzip_img;
+    sgl_obj_needinit(obj);
     if (img->desc.unzip_img != NULL) {
         sgl_obj_set_size(obj, img->desc.unzip_img->width, img->desc.unzip_img->height);
     }
@@ -41,6 +41,16 @@ typedef struct {
     const uint8_t *map;      // Compressed image data
 } sgl_unzip_img_pixmap_t;
 
+/**
+ * @brief Decoder state at the start of a row
+ */
+typedef struct {
+    uint32_t n;              // Decode position
+    uint16_t rep_cnt;        // Repeat count left
+    sgl_color_t out;         // Output color value
+    sgl_color_t unzip;       // Unzip buffer
+} sgl_unzip_img_ckpt_t;
+
 /**
  * @brief Compressed image drawing description
  */
@@ -49,6 +59,9 @@ typedef struct {
     sgl_color_t color;                    // Image color
     uint8_t alpha;                        // Transparency
     sgl_align_type_t align;               // Alignment type
+    const sgl_unzip_img_ckpt_t *index;    // Row seek index, a checkpoint every CONFIG_SGL_IMG_ROW_INDEX_STEP rows, can be NULL
+    uint16_t index_num;                   // Number of checkpoints
+    sgl_img_cache_entry_t *cache;         // Decoded image in image cache, it is drawn instead of decoding, can be NULL
 } sgl_draw_unzip_img_t;
 
 /**
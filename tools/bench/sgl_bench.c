@@ -0,0 +1,818 @@
+/* tools/bench/sgl_bench.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * usage: sgl_bench [frames] [dump_dir] [scene]
+ *      frames:   number of full frames rendered per scene, default 20
+ *      dump_dir: if set, the last frame of each scene is dumped as <dump_dir>/<scene>.ppm, "-" is not set
+ *      scene:    if set, only the scene of this name is rendered
+ *
+ * every frame marks the active page dirty, or calls the update function of scene, and renders it
+ * through the headless device, the result is reported as nanoseconds, flushed pixels, blended pixels,
+ * construct_fn calls, dirty areas, pixels added by dirty area merging and pixels sent to draw operations per frame.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <sgl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if !(CONFIG_SGL_HEADLESS) || !(CONFIG_SGL_PERF_COUNTER)
+#error "sgl_bench requires CONFIG_SGL_HEADLESS and CONFIG_SGL_PERF_COUNTER, configure with -DSGL_BENCH=ON"
+#endif
+
+#define BENCH_XRES                (800)
+#define BENCH_YRES                (480)
+#define BENCH_BUFFER_LINES        (40)
+#define BENCH_FRAMES_DEFAULT      (20)
+
+#define BENCH_BUTTON_NUM          (200)
+#define BENCH_PANEL_NUM           (32)
+#define BENCH_PANEL_CHILDREN      (10)
+#define BENCH_STACK_LAYERS        (4)
+#define BENCH_SCOPE_CHANNELS      (4)
+#define BENCH_SCOPE_POINTS        (512)
+#define BENCH_LINECHART_POINTS    (2000)
+#define BENCH_IMG_WIDTH           (320)
+#define BENCH_IMG_HEIGHT          (240)
+#define BENCH_ANIM_FRAMES         (8)
+#define BENCH_SCATTER_COLS        (16)
+#define BENCH_SCATTER_ROWS        (8)
+#define BENCH_SCATTER_DIRTY       (24)
+#define BENCH_DRAG_SIZE           (200)
+#define BENCH_OVERLAY_LAYERS      (2)
+#define BENCH_GAUGE_NUM           (2)
+#define BENCH_GAUGE_RADIUS        (160)
+#define BENCH_LINE_NUM            (24)
+#define BENCH_LINE_WIDTH          (24)
+#define BENCH_XFORM_WIDTH         (160)
+#define BENCH_XFORM_HEIGHT        (120)
+
+
+/* update is called before every measured frame, if it is NULL the whole page is marked dirty */
+typedef struct bench_scene {
+    const char *name;
+    void      (*setup)(sgl_obj_t *page);
+    void      (*update)(uint32_t frame);
+} bench_scene_t;
+
+
+static sgl_color_t bench_framebuffer[BENCH_XRES * BENCH_YRES];
+static sgl_color_t bench_buffer[BENCH_XRES * BENCH_BUFFER_LINES];
+
+static int16_t bench_scope_data[BENCH_SCOPE_CHANNELS][BENCH_SCOPE_POINTS];
+static int32_t bench_linechart_data[BENCH_LINECHART_POINTS];
+
+/* worst case RLE stream is 3 bytes per pixel for RGB565 */
+static uint8_t bench_rle_data[BENCH_IMG_WIDTH * BENCH_IMG_HEIGHT * 3];
+static sgl_pixmap_t bench_rle_pixmap;
+static sgl_pixmap_t bench_anim_pixmap[BENCH_ANIM_FRAMES];
+
+/* translucent ARGB8888 image and its native conversion, both are drawn over the page pixmap */
+static uint8_t bench_argb_data[BENCH_IMG_WIDTH * BENCH_IMG_HEIGHT * 4];
+static uint32_t bench_native_data[(BENCH_IMG_WIDTH * BENCH_IMG_HEIGHT * SGL_PIXMAP_NATIVE_ALPHA_BYTES + 3) / 4];
+static sgl_pixmap_t bench_argb_pixmap, bench_native_pixmap;
+
+/* native page background, the full screen one is 1:1 and the half one is zoomed 2x */
+static sgl_color_t bench_bg_data[BENCH_XRES * BENCH_YRES];
+static sgl_pixmap_t bench_bg_pixmap, bench_bg_half_pixmap;
+
+/* checker source of the transform scenes, the sharp edges show the sampling quality */
+static sgl_color_t bench_xform_data[BENCH_XFORM_WIDTH * BENCH_XFORM_HEIGHT];
+
+static sgl_obj_t *bench_scatter[BENCH_SCATTER_COLS * BENCH_SCATTER_ROWS];
+static sgl_obj_t *bench_drag;
+
+static const char *bench_long_text[] = {
+    "The quick brown fox jumps over the lazy dog 0123456789",
+    "SGL renders every dirty area band by band into the draw buffer",
+    "Pack my box with five dozen liquor jugs, then flush the panel",
+    "Sphinx of black quartz, judge my vow! ~!@#$%^&*()_+{}|:<>?",
+};
+
+
+static uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+#if defined(_WIN32)
+    timespec_get(&ts, TIME_UTC);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+
+/* pixels sent to draw operations, the bench registers counting operations that call the software ones */
+static uint64_t bench_ops_pixels;
+
+static void bench_ops_count(int32_t pixels)
+{
+#if (CONFIG_SGL_DRAW_THREADS)
+    __atomic_fetch_add(&bench_ops_pixels, (uint64_t)pixels, __ATOMIC_RELAXED);
+#else
+    bench_ops_pixels += (uint64_t)pixels;
+#endif
+}
+
+
+static void bench_ops_fill(sgl_color_t *dst, int16_t stride, int16_t w, int16_t h, sgl_color_t color)
+{
+    bench_ops_count((int32_t)w * h);
+    sgl_draw_soft_fill(dst, stride, w, h, color);
+}
+
+
+static void bench_ops_blend(sgl_color_t *dst, int16_t stride, int16_t w, int16_t h, sgl_color_t color, uint8_t alpha)
+{
+    bench_ops_count((int32_t)w * h);
+    sgl_draw_soft_blend(dst, stride, w, h, color, alpha);
+}
+
+
+static void bench_ops_copy(sgl_color_t *dst, const sgl_color_t *src, int16_t len, uint8_t alpha)
+{
+    bench_ops_count(len);
+    sgl_draw_soft_copy(dst, src, len, alpha);
+}
+
+
+static void bench_ops_mask(sgl_color_t *dst, const uint8_t *mask, uint32_t index, int16_t len, uint8_t bpp, sgl_color_t color, uint8_t alpha)
+{
+    bench_ops_count(len);
+    sgl_draw_soft_mask(dst, mask, index, len, bpp, color, alpha);
+}
+
+
+/* a pseudo random but deterministic value sequence */
+static uint32_t bench_rand(void)
+{
+    static uint32_t seed = 0x12345678;
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+
+static void scene_page_fill(sgl_obj_t *page)
+{
+    sgl_page_set_color(page, sgl_rgb(30, 60, 90));
+}
+
+
+static void scene_buttons(sgl_obj_t *page)
+{
+    const int16_t cols = 10, w = BENCH_XRES / cols, h = BENCH_YRES / (BENCH_BUTTON_NUM / cols);
+
+    for (int i = 0; i < BENCH_BUTTON_NUM; i++) {
+        sgl_obj_t *btn = sgl_button_create(page);
+        sgl_obj_set_pos(btn, (i % cols) * w + 2, (i / cols) * h + 1);
+        sgl_obj_set_size(btn, w - 4, h - 2);
+        sgl_button_set_radius(btn, 8);
+        sgl_button_set_text(btn, "OK");
+    }
+}
+
+
+/* full screen translucent layers over the buttons, like dimming of a popup */
+static void scene_overlay(sgl_obj_t *page)
+{
+    scene_buttons(page);
+
+    for (int i = 0; i < BENCH_OVERLAY_LAYERS; i++) {
+        sgl_obj_t *layer = sgl_rect_create(page);
+        sgl_obj_set_pos(layer, 0, 0);
+        sgl_obj_set_size(layer, BENCH_XRES, BENCH_YRES);
+        sgl_rect_set_border_width(layer, 0);
+        sgl_rect_set_color(layer, sgl_rgb(0, 0, (32 * i)));
+        sgl_rect_set_alpha(layer, 96);
+    }
+}
+
+
+static void scene_panels(sgl_obj_t *page)
+{
+    const int16_t cols = 8, w = BENCH_XRES / cols, h = BENCH_YRES / (BENCH_PANEL_NUM / cols);
+    const int16_t child_h = (h - 4) / BENCH_PANEL_CHILDREN;
+
+    for (int i = 0; i < BENCH_PANEL_NUM; i++) {
+        sgl_obj_t *panel = sgl_rect_create(page);
+        sgl_obj_set_pos(panel, (i % cols) * w + 1, (i / cols) * h + 1);
+        sgl_obj_set_size(panel, w - 2, h - 2);
+        sgl_rect_set_color(panel, sgl_rgb(40, 40, 48));
+
+        for (int j = 0; j < BENCH_PANEL_CHILDREN; j++) {
+            sgl_obj_t *item = sgl_rect_create(panel);
+            sgl_obj_set_pos(item, 4, 2 + j * child_h);
+            sgl_obj_set_size(item, w - 10, child_h - 2);
+            sgl_rect_set_color(item, sgl_rgb((60 + j * 16), 90, 140));
+        }
+    }
+}
+
+
+static void scene_stacked(sgl_obj_t *page)
+{
+    const int16_t cols = 8, w = BENCH_XRES / cols, h = BENCH_YRES / 6;
+
+    /* full screen opaque layers like stacked pages, only the top one is visible */
+    for (int i = 0; i < BENCH_STACK_LAYERS; i++) {
+        sgl_obj_t *layer = sgl_box_create(page);
+        sgl_obj_set_pos(layer, 0, 0);
+        sgl_obj_set_size(layer, BENCH_XRES, BENCH_YRES);
+        sgl_box_set_border_width(layer, 0);
+        sgl_box_set_bg_color(layer, sgl_rgb((20 + i * 30), 40, 60));
+
+        for (int j = 0; j < cols * 6; j++) {
+            sgl_obj_t *btn = sgl_button_create(layer);
+            sgl_obj_set_pos(btn, (j % cols) * w + 4, (j / cols) * h + 4);
+            sgl_obj_set_size(btn, w - 8, h - 8);
+            sgl_button_set_radius(btn, 10);
+        }
+    }
+}
+
+
+static void scene_scatter(sgl_obj_t *page)
+{
+    const int16_t w = BENCH_XRES / BENCH_SCATTER_COLS, h = BENCH_YRES / BENCH_SCATTER_ROWS;
+
+    for (int i = 0; i < BENCH_SCATTER_COLS * BENCH_SCATTER_ROWS; i++) {
+        bench_scatter[i] = sgl_button_create(page);
+        sgl_obj_set_pos(bench_scatter[i], (i % BENCH_SCATTER_COLS) * w + 3, (i / BENCH_SCATTER_COLS) * h + 3);
+        sgl_obj_set_size(bench_scatter[i], w - 6, h - 6);
+        sgl_button_set_radius(bench_scatter[i], 6);
+    }
+}
+
+
+/* some scattered buttons change color in every frame, like the indicators of a dashboard */
+static void update_scatter(uint32_t frame)
+{
+    for (int i = 0; i < BENCH_SCATTER_DIRTY; i++) {
+        sgl_obj_t *btn = bench_scatter[bench_rand() % SGL_ARRAY_SIZE(bench_scatter)];
+        sgl_button_set_color(btn, sgl_rgb(((frame * 40 + i * 8) & 0xFF), 120, 160));
+    }
+}
+
+
+static void scene_drag(sgl_obj_t *page)
+{
+    scene_scatter(page);
+
+    /* an opaque panel with some children is dragged over the buttons */
+    bench_drag = sgl_rect_create(page);
+    sgl_obj_set_pos(bench_drag, 100, 100);
+    sgl_obj_set_size(bench_drag, BENCH_DRAG_SIZE, BENCH_DRAG_SIZE);
+    sgl_rect_set_radius(bench_drag, 12);
+    sgl_rect_set_border_width(bench_drag, 2);
+    sgl_rect_set_color(bench_drag, sgl_rgb(50, 60, 80));
+
+    for (int i = 0; i < 4; i++) {
+        sgl_obj_t *btn = sgl_button_create(bench_drag);
+        sgl_obj_set_pos(btn, 16, 16 + i * 44);
+        sgl_obj_set_size(btn, BENCH_DRAG_SIZE - 32, 36);
+        sgl_button_set_text(btn, "Drag");
+    }
+
+    /* a label above the panel, the panel can not be copied while it is under the label */
+    sgl_obj_t *label = sgl_label_create(page);
+    sgl_obj_set_pos(label, 500, 200);
+    sgl_obj_set_size(label, 120, 40);
+    sgl_label_set_text(label, "Above");
+}
+
+
+/* the panel is dragged by 3 pixels right and 1 pixel down in every frame, like a finger on touch panel */
+static void update_drag(uint32_t frame)
+{
+    sgl_pos_t pos = sgl_obj_get_pos(bench_drag);
+    SGL_UNUSED(frame);
+
+    if (pos.x + BENCH_DRAG_SIZE + 3 > BENCH_XRES) {
+        sgl_obj_set_pos(bench_drag, 0, pos.y);
+    }
+    else {
+        sgl_obj_set_pos(bench_drag, pos.x + 3, pos.y + 1);
+    }
+}
+
+
+static void scene_labels(sgl_obj_t *page)
+{
+    const int16_t line_h = song23.font_height + 4;
+
+    for (int i = 0; i < BENCH_YRES / line_h; i++) {
+        sgl_obj_t *label = sgl_label_create(page);
+        sgl_obj_set_pos(label, 4, i * line_h);
+        sgl_obj_set_size(label, BENCH_XRES - 8, line_h);
+        sgl_label_set_font(label, &song23);
+        sgl_label_set_text(label, (char*)bench_long_text[i % SGL_ARRAY_SIZE(bench_long_text)]);
+    }
+}
+
+
+static void scene_scope(sgl_obj_t *page)
+{
+    sgl_obj_t *scope = sgl_scope_create(page);
+    sgl_obj_set_pos(scope, 0, 0);
+    sgl_obj_set_size(scope, BENCH_XRES, BENCH_YRES);
+    sgl_scope_set_channel_count(scope, BENCH_SCOPE_CHANNELS);
+
+    for (int ch = 0; ch < BENCH_SCOPE_CHANNELS; ch++) {
+        sgl_scope_set_channel_data_buffer(scope, ch, bench_scope_data[ch], BENCH_SCOPE_POINTS);
+        for (int i = 0; i < BENCH_SCOPE_POINTS; i++) {
+            sgl_scope_append_data(scope, ch, (int16_t)(1000 * (ch + 1) + (bench_rand() % 2000)));
+        }
+    }
+}
+
+
+static void scene_linechart(sgl_obj_t *page)
+{
+    sgl_obj_t *chart = sgl_linechart_create(page);
+    sgl_obj_set_pos(chart, 0, 0);
+    sgl_obj_set_size(chart, BENCH_XRES, BENCH_YRES);
+
+    for (int i = 0; i < BENCH_LINECHART_POINTS; i++) {
+        bench_linechart_data[i] = (int32_t)(bench_rand() % 1000);
+    }
+
+    sgl_linechart_set_series_count(chart, 1);
+    sgl_linechart_set_series_y_array(chart, 0, bench_linechart_data, BENCH_LINECHART_POINTS);
+}
+
+
+static void scene_label_rotated(sgl_obj_t *page)
+{
+    sgl_obj_t *label = sgl_label_create(page);
+    sgl_obj_set_pos(label, 200, 100);
+    sgl_obj_set_size(label, 400, 200);
+    sgl_label_set_font(label, &song23);
+    /* the rotated text is clipped by the label, so it is short enough to be seen as a whole */
+    sgl_label_set_text(label, "The quick brown fox 0123456789");
+    sgl_label_set_text_color(label, SGL_COLOR_WHITE);
+    sgl_label_set_text_rotation(label, 30);
+}
+
+
+/* encode a RGB565 gradient into SGL_PIXMAP_FMT_RLE_RGB565 stream: [count][lo][hi] */
+static void bench_rle_encode(void)
+{
+    uint32_t len = 0, run = 0;
+    uint16_t last = 0, pix = 0;
+
+    for (int y = 0; y < BENCH_IMG_HEIGHT; y++) {
+        for (int x = 0; x < BENCH_IMG_WIDTH; x++) {
+            /* horizontal bars of 8 pixels give runs of a realistic size */
+            pix = (uint16_t)(((x >> 3) & 0x1F) << 11 | ((y >> 2) & 0x3F) << 5 | ((x + y) >> 4 & 0x1F));
+            if (run != 0 && (pix != last || run == 255)) {
+                bench_rle_data[len++] = (uint8_t)run;
+                bench_rle_data[len++] = (uint8_t)(last & 0xFF);
+                bench_rle_data[len++] = (uint8_t)(last >> 8);
+                run = 0;
+            }
+            last = pix;
+            run ++;
+        }
+    }
+
+    bench_rle_data[len++] = (uint8_t)run;
+    bench_rle_data[len++] = (uint8_t)(last & 0xFF);
+    bench_rle_data[len++] = (uint8_t)(last >> 8);
+
+    bench_rle_pixmap.width = BENCH_IMG_WIDTH;
+    bench_rle_pixmap.height = BENCH_IMG_HEIGHT;
+    bench_rle_pixmap.format = SGL_PIXMAP_FMT_RLE_RGB565;
+    bench_rle_pixmap.bitmap.array = bench_rle_data;
+}
+
+
+/* fill the native backgrounds with a gradient */
+static void bench_bg_init(void)
+{
+    for (int y = 0; y < BENCH_YRES; y++) {
+        for (int x = 0; x < BENCH_XRES; x++) {
+            bench_bg_data[y * BENCH_XRES + x] = sgl_rgb((x * 255 / BENCH_XRES), (y * 255 / BENCH_YRES), ((x ^ y) & 0xFF));
+        }
+    }
+
+    bench_bg_pixmap.width = BENCH_XRES;
+    bench_bg_pixmap.height = BENCH_YRES;
+    bench_bg_pixmap.bitmap.array = (const uint8_t *)bench_bg_data;
+
+    bench_bg_half_pixmap.width = BENCH_XRES / 2;
+    bench_bg_half_pixmap.height = BENCH_YRES / 2;
+    bench_bg_half_pixmap.bitmap.array = (const uint8_t *)bench_bg_data;
+}
+
+
+static void bench_xform_init(void)
+{
+    for (int y = 0; y < BENCH_XFORM_HEIGHT; y++) {
+        for (int x = 0; x < BENCH_XFORM_WIDTH; x++) {
+            bench_xform_data[y * BENCH_XFORM_WIDTH + x] = ((x / 16 + y / 16) & 1) ? sgl_rgb(x * 255 / BENCH_XFORM_WIDTH, 0, 255)
+                                                                                   : sgl_rgb(255, y * 255 / BENCH_XFORM_HEIGHT, 0);
+        }
+    }
+}
+
+
+/* the alpha is a diagonal ramp with opaque and transparent bands, then it is converted to native */
+static void bench_argb_init(void)
+{
+    uint8_t *p = bench_argb_data;
+
+    for (int y = 0; y < BENCH_IMG_HEIGHT; y++) {
+        for (int x = 0; x < BENCH_IMG_WIDTH; x++, p += 4) {
+            p[0] = (uint8_t)(x * 255 / BENCH_IMG_WIDTH);
+            p[1] = (uint8_t)(y * 255 / BENCH_IMG_HEIGHT);
+            p[2] = (uint8_t)((x ^ y) << 2);
+            p[3] = (x < 32) ? 0 : (x >= BENCH_IMG_WIDTH - 32) ? 255 : (uint8_t)(x + y);
+        }
+    }
+
+    bench_argb_pixmap.width = BENCH_IMG_WIDTH;
+    bench_argb_pixmap.height = BENCH_IMG_HEIGHT;
+    bench_argb_pixmap.format = SGL_PIXMAP_FMT_ARGB8888;
+    bench_argb_pixmap.bitmap.array = bench_argb_data;
+
+    if (sgl_pixmap_native_size(&bench_argb_pixmap) > sizeof(bench_native_data) ||
+        sgl_pixmap_to_native(&bench_native_pixmap, bench_native_data, &bench_argb_pixmap)) {
+        fprintf(stderr, "convert native pixmap failed\n");
+    }
+}
+
+
+static void scene_page_pixmap(sgl_obj_t *page)
+{
+    sgl_page_set_pixmap(page, &bench_bg_pixmap);
+}
+
+
+static void scene_page_pixmap_2x(sgl_obj_t *page)
+{
+    sgl_page_set_pixmap(page, &bench_bg_half_pixmap);
+}
+
+
+static void scene_ext_img_rle(sgl_obj_t *page)
+{
+    sgl_obj_t *img = sgl_ext_img_create(page);
+    sgl_obj_set_pos(img, (BENCH_XRES - BENCH_IMG_WIDTH) / 2, (BENCH_YRES - BENCH_IMG_HEIGHT) / 2);
+    sgl_obj_set_size(img, BENCH_IMG_WIDTH, BENCH_IMG_HEIGHT);
+    sgl_ext_img_set_pixmap(img, &bench_rle_pixmap);
+}
+
+
+/* the native pixmap keeps the alpha of its source, the dumps of both scenes are identical */
+static void scene_ext_img_argb(sgl_obj_t *page)
+{
+    sgl_obj_t *img = sgl_ext_img_create(page);
+    sgl_page_set_pixmap(page, &bench_bg_pixmap);
+    sgl_obj_set_pos(img, (BENCH_XRES - BENCH_IMG_WIDTH) / 2, (BENCH_YRES - BENCH_IMG_HEIGHT) / 2);
+    sgl_obj_set_size(img, BENCH_IMG_WIDTH, BENCH_IMG_HEIGHT);
+    sgl_ext_img_set_pixmap(img, &bench_argb_pixmap);
+}
+
+
+static void scene_ext_img_native_a(sgl_obj_t *page)
+{
+    sgl_obj_t *img = sgl_ext_img_create(page);
+    sgl_page_set_pixmap(page, &bench_bg_pixmap);
+    sgl_obj_set_pos(img, (BENCH_XRES - BENCH_IMG_WIDTH) / 2, (BENCH_YRES - BENCH_IMG_HEIGHT) / 2);
+    sgl_obj_set_size(img, BENCH_IMG_WIDTH, BENCH_IMG_HEIGHT);
+    sgl_ext_img_set_pixmap(img, &bench_native_pixmap);
+}
+
+
+/* the checker is rotated and scaled around the screen center by sgl_draw_xform() */
+static void xform_painter(sgl_surf_t *surf, sgl_area_t *area, sgl_obj_t *obj)
+{
+    sgl_surf_t src = {
+        .buffer = bench_xform_data,
+        .w = BENCH_XFORM_WIDTH,
+        .h = BENCH_XFORM_HEIGHT,
+    };
+
+    sgl_draw_xform(surf, &src, area, (BENCH_XRES - BENCH_XFORM_WIDTH) / 2, (BENCH_YRES - BENCH_XFORM_HEIGHT) / 2,
+                   (sgl_draw_xform_t *)((sgl_canvas_t *)obj)->priv);
+}
+
+
+static void scene_xform(sgl_obj_t *page, sgl_draw_xform_t *desc)
+{
+    sgl_obj_t *canvas = sgl_canvas_create(page);
+    sgl_obj_set_pos(canvas, 0, 0);
+    sgl_obj_set_size(canvas, BENCH_XRES, BENCH_YRES);
+    sgl_canvas_set_private(canvas, desc);
+    sgl_canvas_set_painter_cb(canvas, xform_painter);
+}
+
+
+static void scene_xform_scale(sgl_obj_t *page)
+{
+    static sgl_draw_xform_t desc = {
+        .rotation = 30,
+        .scale_x = SGL_XFORM_SCALE_ONE * 5 / 2,
+        .scale_y = SGL_XFORM_SCALE_ONE * 3 / 4,
+        .quality = SGL_XFORM_NEAREST,
+    };
+
+    scene_xform(page, &desc);
+}
+
+
+static void scene_xform_bilinear(sgl_obj_t *page)
+{
+    static sgl_draw_xform_t desc = {
+        .rotation = 30,
+        .scale_x = SGL_XFORM_SCALE_ONE * 5 / 2,
+        .scale_y = SGL_XFORM_SCALE_ONE * 3 / 4,
+        .quality = SGL_XFORM_BILINEAR,
+    };
+
+    scene_xform(page, &desc);
+}
+
+
+/* external flash stand-in, the pixmap address is the address of the data in memory */
+static void bench_flash_read(const size_t addr, uint8_t *buf, uint32_t len_bytes)
+{
+    memcpy(buf, (const void *)addr, len_bytes);
+}
+
+
+static void scene_ext_img_rle_read(sgl_obj_t *page)
+{
+    sgl_obj_t *img = sgl_ext_img_create(page);
+    sgl_obj_set_pos(img, (BENCH_XRES - BENCH_IMG_WIDTH) / 2, (BENCH_YRES - BENCH_IMG_HEIGHT) / 2);
+    sgl_obj_set_size(img, BENCH_IMG_WIDTH, BENCH_IMG_HEIGHT);
+    sgl_ext_img_set_pixmap(img, &bench_rle_pixmap);
+    sgl_ext_img_set_read_ops(img, bench_flash_read);
+}
+
+
+/* a sequence that switches to its next frame by itself, the frames share the RLE data */
+static void scene_ext_img_anim(sgl_obj_t *page)
+{
+    sgl_obj_t *img = sgl_ext_img_create(page);
+
+    for (int i = 0; i < BENCH_ANIM_FRAMES; i++) {
+        bench_anim_pixmap[i].width = bench_rle_pixmap.width;
+        bench_anim_pixmap[i].height = bench_rle_pixmap.height;
+        bench_anim_pixmap[i].format = bench_rle_pixmap.format;
+        bench_anim_pixmap[i].bitmap.array = bench_rle_pixmap.bitmap.array;
+    }
+
+    sgl_obj_set_pos(img, (BENCH_XRES - BENCH_IMG_WIDTH) / 2, (BENCH_YRES - BENCH_IMG_HEIGHT) / 2);
+    sgl_obj_set_size(img, BENCH_IMG_WIDTH, BENCH_IMG_HEIGHT);
+    sgl_ext_img_set_pixmap(img, bench_anim_pixmap);
+    sgl_ext_img_set_read_ops(img, bench_flash_read);
+    sgl_ext_img_set_pixmap_num(img, BENCH_ANIM_FRAMES, true);
+}
+
+
+/* the sequence marks itself dirty for the next frame */
+static void update_ext_img_anim(uint32_t frame)
+{
+    SGL_UNUSED(frame);
+}
+
+
+static void scene_keyboard(sgl_obj_t *page)
+{
+    sgl_obj_t *kbd = sgl_keyboard_create(page);
+    sgl_obj_set_pos(kbd, 0, BENCH_YRES / 2);
+    sgl_obj_set_size(kbd, BENCH_XRES, BENCH_YRES / 2);
+}
+
+
+/* large round gauges, a ring, an arc, a bordered circle and a ball in every gauge */
+static void scene_gauges(sgl_obj_t *page)
+{
+    const int16_t r = BENCH_GAUGE_RADIUS, w = BENCH_XRES / BENCH_GAUGE_NUM;
+
+    for (int i = 0; i < BENCH_GAUGE_NUM; i++) {
+        const int16_t x = i * w + w / 2 - r, y = BENCH_YRES / 2 - r;
+
+        sgl_obj_t *ring = sgl_ring_create(page);
+        sgl_obj_set_pos(ring, x, y);
+        sgl_obj_set_size(ring, 2 * r, 2 * r);
+        sgl_ring_set_radius(ring, r - 12, r);
+
+        sgl_obj_t *arc = sgl_arc_create(page);
+        sgl_obj_set_pos(arc, x, y);
+        sgl_obj_set_size(arc, 2 * r, 2 * r);
+        sgl_arc_set_radius(arc, r - 40, r - 18);
+        sgl_arc_set_start_angle(arc, 30);
+        sgl_arc_set_end_angle(arc, 250 + 40 * i);
+
+        sgl_obj_t *circle = sgl_circle_create(page);
+        sgl_obj_set_pos(circle, x + r - 90, y + r - 90);
+        sgl_obj_set_size(circle, 180, 180);
+        sgl_circle_set_radius(circle, 90);
+        sgl_circle_set_border_width(circle, 4);
+
+        sgl_obj_t *ball = sgl_2dball_create(page);
+        sgl_obj_set_pos(ball, x + r - 40, y + r - 40);
+        sgl_obj_set_size(ball, 80, 80);
+        sgl_2dball_set_radius(ball, 40);
+    }
+}
+
+#if (CONFIG_SGL_FONT_CONSOLAS24_COMPRESS)
+/* labels of compressed font, every glyph is drawn in several bands */
+static void scene_labels_compress(sgl_obj_t *page)
+{
+    const int16_t line_h = consolas24_compress.font_height + 4;
+
+    for (int i = 0; i < BENCH_YRES / line_h; i++) {
+        sgl_obj_t *label = sgl_label_create(page);
+        sgl_obj_set_pos(label, 4, i * line_h);
+        sgl_obj_set_size(label, BENCH_XRES - 8, line_h);
+        sgl_label_set_font(label, &consolas24_compress);
+        sgl_label_set_text(label, (char*)bench_long_text[i % SGL_ARRAY_SIZE(bench_long_text)]);
+    }
+}
+#endif
+
+
+/* long thick slanted lines over the whole screen, like the needles and trends of a dashboard */
+static void scene_lines(sgl_obj_t *page)
+{
+    for (int i = 0; i < BENCH_LINE_NUM; i++) {
+        sgl_obj_t *line = sgl_line_create(page);
+        const int16_t x = (int16_t)(i * BENCH_XRES / BENCH_LINE_NUM);
+
+        if (i & 1) {
+            sgl_line_set_pos(line, x, 8, BENCH_XRES - 1 - x, BENCH_YRES - 8);
+        }
+        else {
+            sgl_line_set_pos(line, 8, x * BENCH_YRES / BENCH_XRES, BENCH_XRES - 8, BENCH_YRES - 1 - x * BENCH_YRES / BENCH_XRES);
+        }
+        sgl_line_set_width(line, BENCH_LINE_WIDTH);
+        sgl_line_set_color(line, sgl_rgb(((i * 40) & 0xFF), 200, 120));
+    }
+}
+
+
+static const bench_scene_t bench_scenes[] = {
+    { "page_fill",     scene_page_fill,    NULL           },
+    { "page_pixmap",   scene_page_pixmap,  NULL           },
+    { "page_pixmap_2x", scene_page_pixmap_2x, NULL },
+    { "buttons_200",   scene_buttons,      NULL           },
+    { "overlay_2",     scene_overlay,      NULL           },
+    { "panels_320",    scene_panels,       NULL           },
+    { "stacked_4",     scene_stacked,      NULL           },
+    { "scatter_24",    scene_scatter,      update_scatter },
+    { "drag_panel",    scene_drag,         update_drag    },
+    { "labels_song23", scene_labels,       NULL           },
+    { "scope_4ch",     scene_scope,        NULL           },
+    { "linechart_2k",  scene_linechart,    NULL           },
+    { "label_rotated", scene_label_rotated, NULL },
+    { "ext_img_rle",   scene_ext_img_rle,  NULL           },
+    { "ext_img_rle_read", scene_ext_img_rle_read, NULL },
+    { "ext_img_anim",  scene_ext_img_anim, update_ext_img_anim },
+    { "ext_img_argb",  scene_ext_img_argb, NULL           },
+    { "ext_img_native_a", scene_ext_img_native_a, NULL    },
+    { "keyboard",      scene_keyboard,     NULL           },
+    { "gauges_2",      scene_gauges,       NULL           },
+    { "lines_24",      scene_lines,        NULL           },
+    { "xform_scale",   scene_xform_scale,  NULL           },
+    { "xform_bilinear", scene_xform_bilinear, NULL        },
+#if (CONFIG_SGL_FONT_CONSOLAS24_COMPRESS)
+    { "labels_compress", scene_labels_compress, NULL },
+#endif
+};
+
+
+static void bench_run_scene(const bench_scene_t *scene, uint32_t frames, const char *dump_dir)
+{
+    sgl_obj_t *page = sgl_screen_act();
+    sgl_headless_stats_t stats;
+    uint64_t start, elapsed, pixels = 0;
+    char path[256];
+
+    /* remove previous scene */
+    sgl_obj_delete(NULL);
+    sgl_page_set_color(page, SGL_THEME_DESKTOP);
+    sgl_page_set_pixmap(page, NULL);
+    scene->setup(page);
+
+    /* first frame initializes objects and is not measured */
+    sgl_headless_frame(NULL);
+    sgl_perf_reset();
+    bench_ops_pixels = 0;
+
+    start = bench_now_ns();
+    for (uint32_t i = 0; i < frames; i++) {
+        if (scene->update != NULL) {
+            scene->update(i);
+        }
+        else {
+            sgl_obj_set_dirty(page);
+        }
+        pixels += sgl_headless_frame(&stats);
+    }
+    elapsed = bench_now_ns() - start;
+
+    printf("%-16s %12llu %12llu %12llu %10llu %6llu %12llu %12llu\n", scene->name,
+           (unsigned long long)(elapsed / frames),
+           (unsigned long long)(pixels / frames),
+           (unsigned long long)(sgl_perf_get()->blend / frames),
+           (unsigned long long)(sgl_perf_get()->construct / frames),
+           (unsigned long long)(sgl_perf_get()->dirty_area / frames),
+           (unsigned long long)(sgl_perf_get()->redundant / frames),
+           (unsigned long long)(bench_ops_pixels / frames));
+
+    if (dump_dir != NULL) {
+        snprintf(path, sizeof(path), "%s/%s.ppm", dump_dir, scene->name);
+        if (sgl_headless_dump_ppm(path)) {
+            fprintf(stderr, "dump %s failed\n", path);
+        }
+    }
+}
+
+
+int main(int argc, char *argv[])
+{
+    uint32_t frames = BENCH_FRAMES_DEFAULT;
+    const char *dump_dir = NULL;
+    const sgl_draw_ops_t bench_ops = {
+        .fill  = bench_ops_fill,
+        .blend = bench_ops_blend,
+        .copy  = bench_ops_copy,
+        .mask  = bench_ops_mask,
+    };
+    const char *only = NULL;
+
+    if (argc > 1) {
+        frames = (uint32_t)strtoul(argv[1], NULL, 0);
+        frames = frames ? frames : 1;
+    }
+
+    if (argc > 2 && strcmp(argv[2], "-") != 0) {
+        dump_dir = argv[2];
+    }
+
+    if (argc > 3) {
+        only = argv[3];
+    }
+
+    if (sgl_headless_register(bench_framebuffer, bench_buffer, NULL, SGL_ARRAY_SIZE(bench_buffer), BENCH_XRES, BENCH_YRES)) {
+        fprintf(stderr, "register headless device failed\n");
+        return -1;
+    }
+
+    sgl_draw_ops_register(&bench_ops);
+
+    if (sgl_init()) {
+        fprintf(stderr, "sgl init failed\n");
+        return -1;
+    }
+
+    sgl_set_system_font(&song23);
+    bench_rle_encode();
+    bench_bg_init();
+    bench_argb_init();
+    bench_xform_init();
+
+    printf("sgl_bench: %dx%d, %d bpp, %d lines buffer, %u frames per scene\n",
+           BENCH_XRES, BENCH_YRES, CONFIG_SGL_FBDEV_PIXEL_DEPTH, BENCH_BUFFER_LINES, frames);
+    printf("%-16s %12s %12s %12s %10s %6s %12s %12s\n", "scene", "ns/frame", "flush px", "blend px", "construct", "areas", "redundant px", "ops px");
+
+    for (size_t i = 0; i < SGL_ARRAY_SIZE(bench_scenes); i++) {
+        if (only == NULL || strcmp(only, bench_scenes[i].name) == 0) {
+            bench_run_scene(&bench_scenes[i], frames, dump_dir);
+        }
+    }
+
+    sgl_deinit();
+    return 0;
+}
@@ -0,0 +1,375 @@
+/* tools/tile_encoder/sgl_tile_encoder.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * usage: sgl_tile_encoder <input> <output> [tile] [format]
+ *      input:  binary PPM (P6) or PAM (P7, TUPLTYPE RGB or RGB_ALPHA) image of 8 bits channels
+ *      output: <name>.c writes C source that defines "const sgl_pixmap_t <name>",
+ *              the other names get the raw bitmap that is read by sgl_ext_img_set_read_ops()
+ *      tile:   WxH of tile, default 32x16, the tiles are decoded alone, so the smaller tiles
+ *              skip less pixels on a small clip, and the larger tiles compress better
+ *      format: rgb888 or argb8888, default argb8888 if any pixel is not opaque
+ *
+ * it converts an image to SGL_PIXMAP_FMT_TILE_RGB888 or SGL_PIXMAP_FMT_TILE_ARGB8888, the layout is
+ * described in sgl_draw.h. it runs on the host and does not depend on sgl, so it is built by any C99 compiler.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define TILE_W_DEFAULT            (32)
+#define TILE_H_DEFAULT            (16)
+#define PIXMAP_SIZE_MAX           (8191)
+#define TILE_HEAD_SIZE            (4)
+#define TILE_RUN_MAX              (62)
+#define TILE_HASH(r, g, b, a)     (((r) * 3 + (g) * 5 + (b) * 7 + (a) * 11) % 64)
+
+
+/* decoded image, the pixels are RGBA bytes */
+typedef struct tile_image {
+    uint32_t  width;
+    uint32_t  height;
+    uint8_t   *pixels;
+} tile_image_t;
+
+
+/* growing output buffer */
+typedef struct tile_buffer {
+    uint8_t   *data;
+    size_t    len;
+    size_t    cap;
+} tile_buffer_t;
+
+
+static void buffer_put(tile_buffer_t *buf, const uint8_t *data, size_t len)
+{
+    if (buf->len + len > buf->cap) {
+        buf->cap = (buf->len + len) * 2;
+        buf->data = realloc(buf->data, buf->cap);
+        if (buf->data == NULL) {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+    }
+    memcpy(buf->data + buf->len, data, len);
+    buf->len += len;
+}
+
+
+static void buffer_put_u32(tile_buffer_t *buf, size_t pos, uint32_t value)
+{
+    buf->data[pos] = (uint8_t)value;
+    buf->data[pos + 1] = (uint8_t)(value >> 8);
+    buf->data[pos + 2] = (uint8_t)(value >> 16);
+    buf->data[pos + 3] = (uint8_t)(value >> 24);
+}
+
+
+/* read the next token of netpbm header, the comments are skipped */
+static int read_token(FILE *fp, char *token, size_t size)
+{
+    size_t len = 0;
+    int c = fgetc(fp);
+
+    while (c != EOF && (isspace(c) || c == '#')) {
+        if (c == '#') {
+            while (c != EOF && c != '\n') {
+                c = fgetc(fp);
+            }
+        }
+        c = fgetc(fp);
+    }
+
+    while (c != EOF && !isspace(c) && len + 1 < size) {
+        token[len++] = (char)c;
+        c = fgetc(fp);
+    }
+    token[len] = '\0';
+    return len ? 0 : -1;
+}
+
+
+static int read_image(const char *path, tile_image_t *img)
+{
+    FILE *fp = fopen(path, "rb");
+    char token[32], tupltype[32] = "";
+    uint32_t depth = 3, maxval = 0;
+    size_t pixels;
+    uint8_t *raw;
+
+    if (fp == NULL) {
+        fprintf(stderr, "open %s failed\n", path);
+        return -1;
+    }
+
+    img->width = img->height = 0;
+    if (read_token(fp, token, sizeof(token)) == 0 && strcmp(token, "P6") == 0) {
+        if (read_token(fp, token, sizeof(token)) == 0) img->width = (uint32_t)strtoul(token, NULL, 10);
+        if (read_token(fp, token, sizeof(token)) == 0) img->height = (uint32_t)strtoul(token, NULL, 10);
+        if (read_token(fp, token, sizeof(token)) == 0) maxval = (uint32_t)strtoul(token, NULL, 10);
+    }
+    else if (strcmp(token, "P7") == 0) {
+        while (read_token(fp, token, sizeof(token)) == 0 && strcmp(token, "ENDHDR") != 0) {
+            if (strcmp(token, "WIDTH") == 0 && read_token(fp, token, sizeof(token)) == 0) img->width = (uint32_t)strtoul(token, NULL, 10);
+            else if (strcmp(token, "HEIGHT") == 0 && read_token(fp, token, sizeof(token)) == 0) img->height = (uint32_t)strtoul(token, NULL, 10);
+            else if (strcmp(token, "DEPTH") == 0 && read_token(fp, token, sizeof(token)) == 0) depth = (uint32_t)strtoul(token, NULL, 10);
+            else if (strcmp(token, "MAXVAL") == 0 && read_token(fp, token, sizeof(token)) == 0) maxval = (uint32_t)strtoul(token, NULL, 10);
+            else if (strcmp(token, "TUPLTYPE") == 0) read_token(fp, tupltype, sizeof(tupltype));
+        }
+        if ((depth == 3 && strcmp(tupltype, "RGB") != 0 && tupltype[0] != '\0') ||
+            (depth == 4 && strcmp(tupltype, "RGB_ALPHA") != 0 && tupltype[0] != '\0')) {
+            depth = 0;
+        }
+    }
+
+    if (img->width == 0 || img->height == 0 || img->width > PIXMAP_SIZE_MAX || img->height > PIXMAP_SIZE_MAX ||
+        maxval != 255 || (depth != 3 && depth != 4)) {
+        fprintf(stderr, "%s is not a 8 bits RGB or RGB_ALPHA image of width and height 1 - %d\n", path, PIXMAP_SIZE_MAX);
+        fclose(fp);
+        return -1;
+    }
+
+    pixels = (size_t)img->width * img->height;
+    raw = malloc(pixels * depth);
+    img->pixels = malloc(pixels * 4);
+    if (raw == NULL || img->pixels == NULL || fread(raw, depth, pixels, fp) != pixels) {
+        fprintf(stderr, "read %s failed\n", path);
+        fclose(fp);
+        return -1;
+    }
+    fclose(fp);
+
+    for (size_t i = 0; i < pixels; i++) {
+        img->pixels[i * 4] = raw[i * depth];
+        img->pixels[i * 4 + 1] = raw[i * depth + 1];
+        img->pixels[i * 4 + 2] = raw[i * depth + 2];
+        img->pixels[i * 4 + 3] = depth == 4 ? raw[i * depth + 3] : 255;
+    }
+    free(raw);
+    return 0;
+}
+
+
+/* compress a tile by the QOI operations, the state starts again in every tile */
+static void encode_tile(tile_buffer_t *buf, const tile_image_t *img, uint32_t x0, uint32_t y0, uint32_t w, uint32_t h, int alpha)
+{
+    uint8_t index[64][4] = { 0 }, prev[4] = { 0, 0, 0, 255 }, px[4], op[5];
+    uint32_t run = 0, hash;
+
+    for (uint32_t y = y0; y < y0 + h; y++) {
+        for (uint32_t x = x0; x < x0 + w; x++) {
+            memcpy(px, &img->pixels[((size_t)y * img->width + x) * 4], 4);
+            if (!alpha) {
+                px[3] = 255;
+            }
+
+            if (memcmp(px, prev, 4) == 0) {
+                run ++;
+                if (run == TILE_RUN_MAX) {
+                    op[0] = (uint8_t)(0xc0 | (run - 1));
+                    buffer_put(buf, op, 1);
+                    run = 0;
+                }
+                continue;
+            }
+
+            if (run > 0) {
+                op[0] = (uint8_t)(0xc0 | (run - 1));
+                buffer_put(buf, op, 1);
+                run = 0;
+            }
+
+            hash = TILE_HASH(px[0], px[1], px[2], px[3]);
+            if (memcmp(index[hash], px, 4) == 0) {
+                op[0] = (uint8_t)hash;
+                buffer_put(buf, op, 1);
+            }
+            else if (px[3] == prev[3]) {
+                int8_t vr = (int8_t)(px[0] - prev[0]);
+                int8_t vg = (int8_t)(px[1] - prev[1]);
+                int8_t vb = (int8_t)(px[2] - prev[2]);
+                int8_t vg_r = (int8_t)(vr - vg);
+                int8_t vg_b = (int8_t)(vb - vg);
+
+                if (vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2) {
+                    op[0] = (uint8_t)(0x40 | (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2));
+                    buffer_put(buf, op, 1);
+                }
+                else if (vg_r > -9 && vg_r < 8 && vg > -33 && vg < 32 && vg_b > -9 && vg_b < 8) {
+                    op[0] = (uint8_t)(0x80 | (vg + 32));
+                    op[1] = (uint8_t)((vg_r + 8) << 4 | (vg_b + 8));
+                    buffer_put(buf, op, 2);
+                }
+                else {
+                    op[0] = 0xfe;
+                    memcpy(&op[1], px, 3);
+                    buffer_put(buf, op, 4);
+                }
+            }
+            else {
+                op[0] = 0xff;
+                memcpy(&op[1], px, 4);
+                buffer_put(buf, op, 5);
+            }
+
+            memcpy(index[hash], px, 4);
+            memcpy(prev, px, 4);
+        }
+    }
+
+    if (run > 0) {
+        op[0] = (uint8_t)(0xc0 | (run - 1));
+        buffer_put(buf, op, 1);
+    }
+}
+
+
+static int write_output(const char *path, const tile_buffer_t *buf, const tile_image_t *img, const char *format)
+{
+    const size_t path_len = strlen(path);
+    const char *base = strrchr(path, '/');
+    char name[128];
+    size_t len = 0;
+    FILE *fp = fopen(path, path_len > 2 && strcmp(path + path_len - 2, ".c") == 0 ? "w" : "wb");
+
+    if (fp == NULL) {
+        fprintf(stderr, "open %s failed\n", path);
+        return -1;
+    }
+
+    if (path_len <= 2 || strcmp(path + path_len - 2, ".c") != 0) {
+        if (fwrite(buf->data, 1, buf->len, fp) != buf->len) {
+            fprintf(stderr, "write %s failed\n", path);
+            fclose(fp);
+            return -1;
+        }
+        fclose(fp);
+        return 0;
+    }
+
+    /* the name of pixmap is the file name without extension */
+    for (base = base ? base + 1 : path; base[len] != '\0' && base[len] != '.' && len + 1 < sizeof(name); len++) {
+        name[len] = isalnum((unsigned char)base[len]) ? base[len] : '_';
+    }
+    name[len] = '\0';
+
+    fprintf(fp, "/* generated by sgl_tile_encoder, %ux%u %s */\n\n", img->width, img->height, format);
+    fprintf(fp, "#include <sgl.h>\n\n");
+    fprintf(fp, "static const uint8_t %s_bitmap[%zu] = {", name, buf->len);
+    for (size_t i = 0; i < buf->len; i++) {
+        fprintf(fp, "%s0x%02x,", i % 16 ? " " : "\n    ", buf->data[i]);
+    }
+    fprintf(fp, "\n};\n\n");
+    fprintf(fp, "const sgl_pixmap_t %s = {\n", name);
+    fprintf(fp, "    .width = %u,\n    .height = %u,\n", img->width, img->height);
+    fprintf(fp, "    .format = SGL_PIXMAP_FMT_TILE_%s,\n", strcmp(format, "rgb888") == 0 ? "RGB888" : "ARGB8888");
+    fprintf(fp, "    .bitmap.array = %s_bitmap,\n};\n", name);
+
+    if (fclose(fp) != 0) {
+        fprintf(stderr, "write %s failed\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+
+int main(int argc, char *argv[])
+{
+    tile_image_t img;
+    tile_buffer_t buf = { 0 };
+    uint32_t tile_w = TILE_W_DEFAULT, tile_h = TILE_H_DEFAULT, tiles, tile = 0;
+    const char *format = NULL;
+    uint8_t head[TILE_HEAD_SIZE];
+    size_t pixels;
+    int alpha = 0;
+
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <input.ppm|input.pam> <output.c|output.bin> [tile WxH] [rgb888|argb8888]\n", argv[0]);
+        return 1;
+    }
+
+    if (argc > 3 && (sscanf(argv[3], "%ux%u", &tile_w, &tile_h) != 2 || tile_w == 0 || tile_h == 0 ||
+                     tile_w > PIXMAP_SIZE_MAX || tile_h > PIXMAP_SIZE_MAX)) {
+        fprintf(stderr, "tile %s is not WxH\n", argv[3]);
+        return 1;
+    }
+
+    if (argc > 4) {
+        format = argv[4];
+        if (strcmp(format, "rgb888") != 0 && strcmp(format, "argb8888") != 0) {
+            fprintf(stderr, "format %s is not rgb888 or argb8888\n", format);
+            return 1;
+        }
+    }
+
+    if (read_image(argv[1], &img)) {
+        return 1;
+    }
+
+    pixels = (size_t)img.width * img.height;
+    if (format == NULL) {
+        format = "rgb888";
+        for (size_t i = 0; i < pixels; i++) {
+            if (img.pixels[i * 4 + 3] != 255) {
+                format = "argb8888";
+                break;
+            }
+        }
+    }
+    alpha = strcmp(format, "argb8888") == 0;
+
+    /* head and the offset table are filled after the tiles are compressed */
+    tiles = ((img.width + tile_w - 1) / tile_w) * ((img.height + tile_h - 1) / tile_h);
+    head[0] = (uint8_t)tile_w;
+    head[1] = (uint8_t)(tile_w >> 8);
+    head[2] = (uint8_t)tile_h;
+    head[3] = (uint8_t)(tile_h >> 8);
+    buffer_put(&buf, head, sizeof(head));
+    for (uint32_t i = 0; i <= tiles; i++) {
+        buffer_put(&buf, head, 4);
+    }
+
+    for (uint32_t y = 0; y < img.height; y += tile_h) {
+        for (uint32_t x = 0; x < img.width; x += tile_w, tile++) {
+            buffer_put_u32(&buf, TILE_HEAD_SIZE + tile * 4, (uint32_t)buf.len);
+            encode_tile(&buf, &img, x, y, x + tile_w > img.width ? img.width - x : tile_w,
+                        y + tile_h > img.height ? img.height - y : tile_h, alpha);
+        }
+    }
+    buffer_put_u32(&buf, TILE_HEAD_SIZE + tiles * 4, (uint32_t)buf.len);
+
+    if (write_output(argv[2], &buf, &img, format)) {
+        return 1;
+    }
+
+    printf("%s: %ux%u %s, %ux%u tiles: %u, %zu bytes, %.1f%% of raw\n", argv[2], img.width, img.height, format,
+           tile_w, tile_h, tiles, buf.len, buf.len * 100.0 / (pixels * (alpha ? 4 : 3)));
+
+    free(img.pixels);
+    free(buf.data);
+    return 0;
+}